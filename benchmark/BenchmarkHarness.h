@@ -0,0 +1,289 @@
+/**
+ * @file BenchmarkHarness.h
+ * @brief Minimal self-registering benchmark harness
+ * 
+ * This file contains a small benchmark registry used by the
+ * ExclusionParserBenchmarks target. Benchmarks are registered with the
+ * EXCLUSION_BENCHMARK macro and executed by benchmark_main.cpp. It also
+ * provides corpus access, scaled synthetic inputs built from corpus files,
+ * and peak resident set size measurement.
+ * 
+ * @author ExclusionCoverageParser
+ * @version 1.0.0
+ * @date 2025
+ */
+
+#ifndef EXCLUSION_BENCHMARK_HARNESS_H
+#define EXCLUSION_BENCHMARK_HARNESS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#ifndef EXCLUSION_CORPUS_DIR
+#define EXCLUSION_CORPUS_DIR "exclusion"
+#endif
+
+namespace ExclusionBenchmark {
+
+/**
+ * @brief Measurement context handed to each benchmark body
+ * 
+ * The body calls run() with the operation to time and reports how many
+ * bytes, lines and items one iteration processes so throughput can be
+ * computed. Items are exclusions unless the label says otherwise.
+ */
+class State {
+private:
+    size_t iterations_;        ///< Timed iterations per benchmark
+    size_t bytesPerIteration_; ///< Bytes processed by one iteration
+    size_t linesPerIteration_; ///< Input lines processed by one iteration
+    size_t itemsPerIteration_; ///< Items (e.g. exclusions) produced by one iteration
+    double bestSeconds_;       ///< Fastest iteration
+    double totalSeconds_;      ///< Sum of all iterations
+    std::string label_;        ///< Free-form label printed with the result
+
+public:
+    /**
+     * @brief Constructor
+     * @param iterations Timed iterations to run
+     */
+    explicit State(size_t iterations)
+        : iterations_(iterations), bytesPerIteration_(0), linesPerIteration_(0), itemsPerIteration_(0),
+          bestSeconds_(0.0), totalSeconds_(0.0) {}
+
+    /**
+     * @brief Time an operation (one untimed warm-up, then iterations_ timed runs)
+     * @param operation Operation to time
+     */
+    void run(const std::function<void()>& operation) {
+        operation();
+        bestSeconds_ = 0.0;
+        totalSeconds_ = 0.0;
+        for (size_t i = 0; i < iterations_; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            operation();
+            auto end = std::chrono::steady_clock::now();
+            double seconds = std::chrono::duration<double>(end - start).count();
+            totalSeconds_ += seconds;
+            if (i == 0 || seconds < bestSeconds_) {
+                bestSeconds_ = seconds;
+            }
+        }
+    }
+
+    void setBytesProcessed(size_t bytes) { bytesPerIteration_ = bytes; }
+    void setLinesProcessed(size_t lines) { linesPerIteration_ = lines; }
+    void setItemsProcessed(size_t items) { itemsPerIteration_ = items; }
+    void setLabel(const std::string& label) { label_ = label; }
+
+    size_t getIterations() const { return iterations_; }
+    size_t getBytesProcessed() const { return bytesPerIteration_; }
+    size_t getLinesProcessed() const { return linesPerIteration_; }
+    size_t getItemsProcessed() const { return itemsPerIteration_; }
+    double getBestSeconds() const { return bestSeconds_; }
+    double getMeanSeconds() const { return iterations_ ? totalSeconds_ / static_cast<double>(iterations_) : 0.0; }
+    const std::string& getLabel() const { return label_; }
+};
+
+/**
+ * @brief Registered benchmark entry
+ */
+struct Benchmark {
+    std::string name;                      ///< Benchmark name (used for filtering)
+    std::function<void(State&)> body;      ///< Benchmark body
+};
+
+/**
+ * @brief Access the global benchmark registry
+ * @return Registered benchmarks in registration order
+ */
+inline std::vector<Benchmark>& registry() {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+/**
+ * @brief Helper whose constructor registers a benchmark at static-init time
+ */
+struct Registrar {
+    Registrar(const char* name, void (*body)(State&)) {
+        registry().push_back({name, body});
+    }
+};
+
+/**
+ * @brief Read a file from the exclusion corpus directory
+ * @param fileName File name relative to EXCLUSION_CORPUS_DIR
+ * @return File contents (empty if the file cannot be read)
+ */
+inline std::string readCorpusFile(const std::string& fileName) {
+    std::ifstream file(std::string(EXCLUSION_CORPUS_DIR) + "/" + fileName, std::ios::binary);
+    if (!file.is_open()) {
+        return {};
+    }
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+/**
+ * @brief Count the lines of a text (a final line without '\n' counts)
+ * @param text Text to count
+ * @return Number of lines
+ */
+inline size_t countLines(const std::string& text) {
+    size_t lines = static_cast<size_t>(std::count(text.begin(), text.end(), '\n'));
+    if (!text.empty() && text.back() != '\n') {
+        lines++;
+    }
+    return lines;
+}
+
+/**
+ * @brief Build a larger input by repeating a corpus file under renamed scopes
+ * 
+ * The header is kept once; every INSTANCE/MODULE line of copy N gets the
+ * suffix "_sN", so each copy adds new scopes instead of appending to the
+ * first copy's scopes.
+ * 
+ * @param fileName File name relative to EXCLUSION_CORPUS_DIR
+ * @param copies Number of copies of the file body
+ * @return Scaled file contents (empty if the file cannot be read)
+ */
+inline std::string scaledCorpusText(const std::string& fileName, size_t copies) {
+    std::string content = readCorpusFile(fileName);
+    if (content.empty() || copies <= 1) {
+        return content;
+    }
+    
+    // The header ends where the first scope (and its CHECKSUM line) begins
+    size_t bodyStart = content.find("\nCHECKSUM:");
+    bodyStart = bodyStart == std::string::npos ? 0 : bodyStart + 1;
+    std::string header = content.substr(0, bodyStart);
+    std::string body = content.substr(bodyStart);
+    if (!body.empty() && body.back() != '\n') {
+        body += '\n';
+    }
+    
+    std::string scaled = header;
+    scaled.reserve(header.size() + copies * (body.size() + 64));
+    for (size_t copy = 0; copy < copies; ++copy) {
+        std::string suffix = "_s" + std::to_string(copy);
+        size_t position = 0;
+        while (position < body.size()) {
+            size_t end = body.find('\n', position);
+            std::string_view line(body.data() + position, end - position);
+            scaled += line;
+            if (line.starts_with("INSTANCE:") || line.starts_with("MODULE:")) {
+                scaled += suffix;
+            }
+            scaled += '\n';
+            position = end + 1;
+        }
+    }
+    return scaled;
+}
+
+/**
+ * @brief Reset the peak resident set size so the next reading covers one benchmark
+ * @return True if the peak was reset (Linux only); otherwise the peak is process-wide
+ */
+inline bool resetPeakRss() {
+#if defined(__linux__)
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+    clearRefs.flush();
+    return clearRefs.good();
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Get the peak resident set size
+ * @return Peak RSS in kilobytes since the last resetPeakRss() (0 if unavailable)
+ */
+inline size_t peakRssKilobytes() {
+#if defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmHWM:", 0) == 0) {
+            return static_cast<size_t>(std::strtoull(line.c_str() + 6, nullptr, 10));
+        }
+    }
+#endif
+#if !defined(_WIN32)
+    struct rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+        return static_cast<size_t>(usage.ru_maxrss) / 1024;
+#else
+        return static_cast<size_t>(usage.ru_maxrss);
+#endif
+    }
+#endif
+    return 0;
+}
+
+/**
+ * @brief Build the full path of a corpus file
+ * @param fileName File name relative to EXCLUSION_CORPUS_DIR
+ * @return Full path
+ */
+inline std::string corpusPath(const std::string& fileName) {
+    return std::string(EXCLUSION_CORPUS_DIR) + "/" + fileName;
+}
+
+/**
+ * @brief List all .el files in the exclusion corpus directory
+ * @return Sorted file paths
+ */
+inline std::vector<std::string> corpusFiles() {
+    std::vector<std::string> files;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(EXCLUSION_CORPUS_DIR, error)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".el") {
+            files.push_back(entry.path().string());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+} // namespace ExclusionBenchmark
+
+#define EXCLUSION_BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define EXCLUSION_BENCHMARK_CONCAT(a, b) EXCLUSION_BENCHMARK_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Define and register a benchmark
+ * 
+ * Usage:
+ * @code
+ * EXCLUSION_BENCHMARK(ParseString_dpcsc) {
+ *     state.setBytesProcessed(content.size());
+ *     state.run([&] { parser.parseString(content); });
+ * }
+ * @endcode
+ */
+#define EXCLUSION_BENCHMARK(name)                                                        \
+    static void EXCLUSION_BENCHMARK_CONCAT(benchmark_, name)(::ExclusionBenchmark::State& state); \
+    static ::ExclusionBenchmark::Registrar EXCLUSION_BENCHMARK_CONCAT(registrar_, name)( \
+        #name, &EXCLUSION_BENCHMARK_CONCAT(benchmark_, name));                           \
+    static void EXCLUSION_BENCHMARK_CONCAT(benchmark_, name)(::ExclusionBenchmark::State& state)
+
+#endif // EXCLUSION_BENCHMARK_HARNESS_H
@@ -0,0 +1,137 @@
+/**
+ * @file bench_line_dispatch.cpp
+ * @brief Per-line-kind dispatch and parse microbenchmarks
+ * 
+ * For each .el line kind this measures:
+ * - Dispatch_<kind>_classifier: Tokenizer::classifyLine (single switch)
+ * - Dispatch_<kind>_cascade: the keyword probes the old parseHeader ->
+ *   parseTransition cascade ran before reaching the right handler
+ * - ParseLines_<kind>: end-to-end parseString of a buffer of such lines
+ * 
+ * Each iteration processes kLinesPerKind lines, reported as lines/s.
+ * 
+ * @author ExclusionCoverageParser
+ * @version 1.0.0
+ * @date 2025
+ */
+
+#include "BenchmarkHarness.h"
+#include "ExclusionParser.h"
+#include "ExclusionTokenizer.h"
+
+using namespace ExclusionBenchmark;
+namespace Tokenizer = ExclusionParser::Tokenizer;
+
+namespace {
+
+constexpr size_t kLinesPerKind = 100000;
+
+struct LineSample {
+    const char* kind;       ///< Name used in the benchmark name
+    const char* line;       ///< Representative line taken from the corpus
+};
+
+const LineSample kSamples[] = {
+    {"Toggle", "Toggle 1to0 Alt_scan_capture_clock_phyd18clk \"net Alt_scan_capture_clock_phyd18clk\""},
+    {"Block", "Block 2 \"3433969155\" \"genblk1.out_vld[(genblk1.i + 1)] <= genblk1.out_vld[genblk1.i];\""},
+    {"Condition", "Condition 69 \"1826709312\" \"((irf_DBG_BL_PWM_INPUT_REFCLK_SELECT != 2'b0) && (dbg_sclk_refclk_pulse == 1'b1)) 1 -1\" (1 \"01\")"},
+    {"Fsm", "Fsm bl_state \"3015518728\""},
+    {"Transition", "Transition s_BLPWM_WAIT_FOR_1ST_REFCLK->s_BLPWM_DISABLED \"2->0\""},
+    {"Annotation", "ANNOTATION: \" DFT related \""},
+    {"Checksum", "CHECKSUM: \"2711927046 1414315428\""},
+    {"Instance", "INSTANCE: tb.gpu0.chip0.core.udcnc.udpcsc"},
+    {"Comment", "// Generated By User: winnimui"},
+};
+
+/**
+ * @brief Replica of the keyword probing done by the former if/else cascade
+ * 
+ * The old parser ran isComment, four full-line find() scans in parseHeader,
+ * and then prefix tests in parseChecksum, parseScope, parseAnnotation and
+ * each exclusion handler in turn until one matched.
+ */
+int cascadeDispatch(std::string_view line) {
+    if (Tokenizer::startsWith(line, "//") ||
+        Tokenizer::startsWith(line, "==================================================")) return 1;
+    if (line.find("Generated By User:") != std::string_view::npos) return 2;
+    if (line.find("Format Version:") != std::string_view::npos) return 2;
+    if (line.find("Date:") != std::string_view::npos) return 2;
+    if (line.find("ExclMode:") != std::string_view::npos) return 2;
+    if (Tokenizer::startsWith(line, "CHECKSUM:")) return 3;
+    if (Tokenizer::startsWith(line, "INSTANCE:")) return 4;
+    if (Tokenizer::startsWith(line, "MODULE:")) return 5;
+    if (Tokenizer::startsWith(line, "ANNOTATION:") ||
+        Tokenizer::startsWith(line, "ANNOTATION_BEGIN:")) return 6;
+    if (Tokenizer::startsWith(line, "ANNOTATION_END")) return 7;
+    if (Tokenizer::startsWith(line, "Block ")) return 8;
+    if (Tokenizer::startsWith(line, "Toggle ")) return 9;
+    if (Tokenizer::startsWith(line, "Fsm ")) return 10;
+    if (Tokenizer::startsWith(line, "Condition ")) return 11;
+    if (Tokenizer::startsWith(line, "Transition ")) return 12;
+    return 0;
+}
+
+/**
+ * @brief Build a parseable buffer of kLinesPerKind copies of one line
+ */
+std::string buildBuffer(const char* line) {
+    std::string buffer = "CHECKSUM: \"1\"\nINSTANCE: tb.bench\n";
+    std::string_view sample(line);
+    buffer.reserve(buffer.size() + kLinesPerKind * (sample.size() + 1));
+    for (size_t i = 0; i < kLinesPerKind; ++i) {
+        buffer += sample;
+        buffer += '\n';
+    }
+    return buffer;
+}
+
+volatile size_t sink;
+
+bool registerLineKindBenchmarks() {
+    for (const auto& sample : kSamples) {
+        std::string kind = sample.kind;
+        const char* line = sample.line;
+        
+        registry().push_back({"Dispatch_" + kind + "_classifier", [line](State& state) {
+            std::string_view view(line);
+            state.setLinesProcessed(kLinesPerKind);
+            state.setBytesProcessed(kLinesPerKind * view.size());
+            state.run([&] {
+                size_t total = 0;
+                for (size_t i = 0; i < kLinesPerKind; ++i) {
+                    total += static_cast<size_t>(Tokenizer::classifyLine(sink ? view.substr(1) : view));
+                }
+                sink = total;
+            });
+        }});
+        
+        registry().push_back({"Dispatch_" + kind + "_cascade", [line](State& state) {
+            std::string_view view(line);
+            state.setLinesProcessed(kLinesPerKind);
+            state.setBytesProcessed(kLinesPerKind * view.size());
+            state.run([&] {
+                size_t total = 0;
+                for (size_t i = 0; i < kLinesPerKind; ++i) {
+                    total += static_cast<size_t>(cascadeDispatch(sink ? view.substr(1) : view));
+                }
+                sink = total;
+            });
+        }});
+        
+        registry().push_back({"ParseLines_" + kind, [line](State& state) {
+            std::string buffer = buildBuffer(line);
+            state.setLinesProcessed(kLinesPerKind);
+            state.setBytesProcessed(buffer.size());
+            state.run([&] {
+                ExclusionParser::ExclusionParser parser;
+                auto result = parser.parseString(buffer, "line_kinds");
+                sink = result.linesProcessed;
+            });
+        }});
+    }
+    return true;
+}
+
+const bool registered = registerLineKindBenchmarks();
+
+} // anonymous namespace
@@ -0,0 +1,319 @@
+/**
+ * @file bench_lookup.cpp
+ * @brief ExclusionLookup point lookup benchmarks
+ *
+ * Builds one synthetic data set of 10k instance scopes tb.gpuG.coreC.blkB,
+ * each with 32 toggle bits excluded in both directions (960k keys),
+ * and 1M query keys of which half hit. Keys are hashed before timing, as a
+ * coverage tool would hash each item once.
+ * - Lookup_contains_1M: one contains() per key, one thread
+ * - Lookup_containsBatch_1M: containsBatch() over 4096-key chunks, one thread
+ * - Lookup_containsBatch_1M_threads: every hardware thread runs the batch
+ *   loop over all keys at once; the label reports lookups/s per core
+ *
+ * The LookupMiss99_* benchmarks use 10k scopes with 50 block exclusions each
+ * and 1M block queries of which 1% hit, the usual shape of coverage
+ * post-processing:
+ * - LookupMiss99_map_1M: ExclusionData::scopes and blockExclusions find()
+ *   with string keys (includes hashing the strings, which is its real cost)
+ * - LookupMiss99_table_1M: ExclusionLookup::contains without a filter
+ * - LookupMiss99_filter_1M / _filterBatch_1M: with a 1% Bloom filter
+ * - LookupMiss99_filter_1M_threads: every hardware thread runs contains()
+ *   over all keys through the filter, with the filter counters off
+ * - LookupMiss99_filterCounted_1M_threads: the same with the counters on,
+ *   showing what their shared atomic adds cost
+ *
+ * Filter counters are off while timing; the false positive rate in the
+ * labels comes from one counted containsBatch() pass afterwards.
+ *
+ * Items are lookups.
+ *
+ * @author AMD Advanced Micro Devices Inc. - Verification Infrastructure Team
+ * @version 2.0.0
+ * @date September 13, 2025
+ * @copyright (c) 2025 Advanced Micro Devices Inc. All rights reserved.
+ */
+
+#include "BenchmarkHarness.h"
+#include "ExclusionLookup.h"
+
+#include <cstdio>
+
+#include <memory>
+#include <thread>
+
+using namespace ExclusionBenchmark;
+
+namespace {
+
+constexpr size_t kScopes = 10000;
+constexpr int kBits = 32;
+constexpr size_t kQueries = 1000000;
+constexpr size_t kChunk = 4096;
+
+/**
+ * @brief Data set, lookup and query keys shared by the benchmarks
+ */
+struct LookupFixture {
+    ExclusionParser::ExclusionLookup lookup;
+    std::vector<ExclusionParser::LookupKey> keys;
+};
+
+const LookupFixture& fixture() {
+    static const std::unique_ptr<LookupFixture> instance = [] {
+        ExclusionParser::ExclusionData data;
+        std::vector<ExclusionParser::ScopeKey> scopeKeys;
+        for (size_t i = 0; i < kScopes; ++i) {
+            std::string scopeName = "tb.gpu" + std::to_string(i / 1000) + ".core" + std::to_string(i / 100 % 10) +
+                                    ".blk" + std::to_string(i % 100);
+            auto& scope = data.getOrCreateScope(scopeName, "1", false);
+            for (int bit = 0; bit < kBits; ++bit) {
+                scope.toggleTable.add(ExclusionParser::ToggleExclusion(
+                    ExclusionParser::ToggleDirection::BOTH, "data_bus", bit, "net data_bus[31:0]"));
+            }
+            scopeKeys.push_back(ExclusionParser::ExclusionLookup::scopeKey(scopeName));
+        }
+
+        auto result = std::make_unique<LookupFixture>();
+        result->lookup = ExclusionParser::ExclusionLookup(data);
+
+        // Even queries hit (bits 0-31), odd ones miss (bits 32-63), in scattered scope order
+        result->keys.reserve(kQueries);
+        for (size_t i = 0; i < kQueries; ++i) {
+            size_t scope = (i * 7919) % kScopes;
+            int bit = static_cast<int>(i / 2 % kBits) + (i % 2 ? kBits : 0);
+            result->keys.push_back(ExclusionParser::ExclusionLookup::toggleKey(
+                scopeKeys[scope], "data_bus", bit, ExclusionParser::ToggleDirection::ZERO_TO_ONE));
+        }
+        return result;
+    }();
+    return *instance;
+}
+
+/**
+ * @brief Run containsBatch over all query keys in fixed-size chunks
+ * @return Number of hits
+ */
+size_t batchLookups(const LookupFixture& input) {
+    bool results[kChunk];
+    size_t hits = 0;
+    for (size_t begin = 0; begin < input.keys.size(); begin += kChunk) {
+        size_t count = std::min(kChunk, input.keys.size() - begin);
+        hits += input.lookup.containsBatch(std::span(input.keys).subspan(begin, count),
+                                           std::span<bool>(results, count));
+    }
+    return hits;
+}
+
+constexpr size_t kMissScopes = 10000;
+constexpr size_t kMissBlocks = 50;
+
+/**
+ * @brief Block exclusions plus 1% hit queries as strings and as keys
+ */
+struct MissFixture {
+    ExclusionParser::ExclusionData data;
+    ExclusionParser::ExclusionLookup lookup;
+    std::vector<std::pair<std::string, std::string>> queries;
+    std::vector<ExclusionParser::LookupKey> keys;
+};
+
+const MissFixture& missFixture() {
+    static const std::unique_ptr<MissFixture> instance = [] {
+        auto result = std::make_unique<MissFixture>();
+        std::vector<std::string> scopeNames;
+        for (size_t i = 0; i < kMissScopes; ++i) {
+            scopeNames.push_back("tb.gpu" + std::to_string(i / 1000) + ".core" + std::to_string(i / 100 % 10) +
+                                 ".blk" + std::to_string(i % 100));
+            auto& scope = result->data.getOrCreateScope(scopeNames.back(), "1", false);
+            for (size_t block = 0; block < kMissBlocks; ++block) {
+                scope.addBlockExclusion(ExclusionParser::BlockExclusion(std::to_string(block), "1", "x = 0;"));
+            }
+        }
+        result->lookup = ExclusionParser::ExclusionLookup(result->data);
+
+        // Every 100th query names an excluded block; the rest name blocks 50+
+        result->queries.reserve(kQueries);
+        result->keys.reserve(kQueries);
+        for (size_t i = 0; i < kQueries; ++i) {
+            const std::string& scopeName = scopeNames[(i * 7919) % kMissScopes];
+            size_t block = i % 100 == 0 ? i / 100 % kMissBlocks : kMissBlocks + i % 1000;
+            result->queries.emplace_back(scopeName, std::to_string(block));
+            result->keys.push_back(ExclusionParser::ExclusionLookup::blockKey(
+                ExclusionParser::ExclusionLookup::scopeKey(scopeName), result->queries.back().second));
+        }
+        return result;
+    }();
+    return *instance;
+}
+
+std::string filterLabel(ExclusionParser::ExclusionLookup& lookup, const MissFixture& input, size_t hits) {
+    lookup.setFilterCounting(true);
+    lookup.resetFilterStatistics();
+    std::unique_ptr<bool[]> results(new bool[input.keys.size()]);
+    lookup.containsBatch(input.keys, std::span<bool>(results.get(), input.keys.size()));
+    lookup.setFilterCounting(false);
+
+    ExclusionParser::FilterStatistics stats = lookup.getFilterStatistics();
+    double passed = static_cast<double>(stats.filterMisses + stats.filterHits);
+    char rate[32];
+    std::snprintf(rate, sizeof(rate), "%.2f%%", passed > 0 ? 100.0 * static_cast<double>(stats.falsePositives) / passed : 0.0);
+    return std::to_string(hits) + " hits, filter " + std::to_string(stats.memoryBytes / 1024) + " KiB, " +
+           rate + " false positives";
+}
+
+std::string hitLabel(const LookupFixture& input, size_t hits) {
+    return std::to_string(hits) + " hits, " + std::to_string(input.lookup.size()) + " keys, " +
+           std::to_string(input.lookup.getMemoryUsage() / (1024 * 1024)) + " MiB";
+}
+
+/**
+ * @brief Run contains() over all miss keys on every hardware thread at once
+ * @return Label with the thread count and per-core rate
+ */
+std::string threadedFilterLookups(State& state, bool counting) {
+    const MissFixture& input = missFixture();
+    ExclusionParser::ExclusionLookup lookup = input.lookup;
+    lookup.buildFilter(0.01);
+    lookup.setFilterCounting(counting);
+
+    size_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+    state.setItemsProcessed(input.keys.size() * threadCount);
+    std::vector<size_t> hits(threadCount);
+    state.run([&] {
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&input, &lookup, &hits, t] {
+                size_t count = 0;
+                for (const auto& key : input.keys) {
+                    count += lookup.contains(key);
+                }
+                hits[t] = count;
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    });
+
+    double perCore = static_cast<double>(input.keys.size()) / state.getBestSeconds();
+    return std::to_string(hits[0]) + " hits, " + std::to_string(threadCount) + " threads, " +
+           std::to_string(static_cast<size_t>(perCore / 1e6)) + "M lookups/s per core";
+}
+
+
+} // namespace
+
+EXCLUSION_BENCHMARK(Lookup_contains_1M) {
+    const LookupFixture& input = fixture();
+    size_t hits = 0;
+    state.setItemsProcessed(input.keys.size());
+    state.run([&] {
+        hits = 0;
+        for (const auto& key : input.keys) {
+            hits += input.lookup.contains(key);
+        }
+    });
+    state.setLabel(hitLabel(input, hits));
+}
+
+EXCLUSION_BENCHMARK(Lookup_containsBatch_1M) {
+    const LookupFixture& input = fixture();
+    size_t hits = 0;
+    state.setItemsProcessed(input.keys.size());
+    state.run([&] {
+        hits = batchLookups(input);
+    });
+    state.setLabel(hitLabel(input, hits));
+}
+
+EXCLUSION_BENCHMARK(Lookup_containsBatch_1M_threads) {
+    const LookupFixture& input = fixture();
+    size_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+    state.setItemsProcessed(input.keys.size() * threadCount);
+    state.run([&] {
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&input] {
+                batchLookups(input);
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    });
+
+    double perCore = static_cast<double>(input.keys.size()) / state.getBestSeconds();
+    state.setLabel(std::to_string(threadCount) + " threads, " +
+                   std::to_string(static_cast<size_t>(perCore / 1e6)) + "M lookups/s per core");
+}
+
+EXCLUSION_BENCHMARK(LookupMiss99_map_1M) {
+    const MissFixture& input = missFixture();
+    size_t hits = 0;
+    state.setItemsProcessed(input.queries.size());
+    state.run([&] {
+        hits = 0;
+        for (const auto& [scopeName, blockId] : input.queries) {
+            auto scope = input.data.scopes.find(scopeName);
+            hits += scope != input.data.scopes.end() && scope->second.blockExclusions.count(blockId) != 0;
+        }
+    });
+    state.setLabel(std::to_string(hits) + " hits");
+}
+
+EXCLUSION_BENCHMARK(LookupMiss99_table_1M) {
+    const MissFixture& input = missFixture();
+    size_t hits = 0;
+    state.setItemsProcessed(input.keys.size());
+    state.run([&] {
+        hits = 0;
+        for (const auto& key : input.keys) {
+            hits += input.lookup.contains(key);
+        }
+    });
+    state.setLabel(std::to_string(hits) + " hits, table " +
+                   std::to_string(input.lookup.getMemoryUsage() / 1024) + " KiB");
+}
+
+EXCLUSION_BENCHMARK(LookupMiss99_filter_1M) {
+    const MissFixture& input = missFixture();
+    ExclusionParser::ExclusionLookup lookup = input.lookup;
+    lookup.buildFilter(0.01);
+
+    size_t hits = 0;
+    state.setItemsProcessed(input.keys.size());
+    state.run([&] {
+        hits = 0;
+        for (const auto& key : input.keys) {
+            hits += lookup.contains(key);
+        }
+    });
+    state.setLabel(filterLabel(lookup, input, hits));
+}
+
+EXCLUSION_BENCHMARK(LookupMiss99_filterBatch_1M) {
+    const MissFixture& input = missFixture();
+    ExclusionParser::ExclusionLookup lookup = input.lookup;
+    lookup.buildFilter(0.01);
+
+    size_t hits = 0;
+    bool results[kChunk];
+    state.setItemsProcessed(input.keys.size());
+    state.run([&] {
+        hits = 0;
+        for (size_t begin = 0; begin < input.keys.size(); begin += kChunk) {
+            size_t count = std::min(kChunk, input.keys.size() - begin);
+            hits += lookup.containsBatch(std::span(input.keys).subspan(begin, count), std::span<bool>(results, count));
+        }
+    });
+    state.setLabel(filterLabel(lookup, input, hits));
+}
+
+EXCLUSION_BENCHMARK(LookupMiss99_filter_1M_threads) {
+    state.setLabel(threadedFilterLookups(state, false));
+}
+
+EXCLUSION_BENCHMARK(LookupMiss99_filterCounted_1M_threads) {
+    state.setLabel(threadedFilterLookups(state, true));
+}
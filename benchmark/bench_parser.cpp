@@ -0,0 +1,199 @@
+/**
+ * @file bench_parser.cpp
+ * @brief Parser throughput benchmarks
+ * 
+ * Measures ExclusionParser::parseString and parseFile (memory-mapped and
+ * buffered) throughput in bytes per second on the largest real corpus file
+ * (exclusion/dpcsc.el), the same with columnar toggles, visitor-only parsing of the same file (no
+ * ExclusionData built), parseFiles over the whole corpus serially and
+ * on a thread pool, and split-file parsing of the two largest files across
+ * 1..N threads.
+ * 
+ * @author ExclusionCoverageParser
+ * @version 1.0.0
+ * @date 2025
+ */
+
+#include "BenchmarkHarness.h"
+#include "ExclusionParser.h"
+#include "ExclusionThreadPool.h"
+
+#include <stdexcept>
+
+using namespace ExclusionBenchmark;
+
+EXCLUSION_BENCHMARK(ParseString_dpcsc) {
+    std::string content = readCorpusFile("dpcsc.el");
+    if (content.empty()) {
+        throw std::runtime_error("cannot read dpcsc.el from " EXCLUSION_CORPUS_DIR);
+    }
+    
+    size_t exclusions = 0;
+    state.setBytesProcessed(content.size());
+    state.setLinesProcessed(countLines(content));
+    state.run([&] {
+        // A fresh parser per iteration; parseString accumulates into the parser's data
+        ExclusionParser::ExclusionParser parser;
+        auto result = parser.parseString(content, "dpcsc.el");
+        exclusions = result.exclusionsParsed;
+    });
+    state.setItemsProcessed(exclusions);
+    state.setLabel(std::to_string(exclusions) + " exclusions");
+}
+
+EXCLUSION_BENCHMARK(ParseString_dpcsc_columnar) {
+    std::string content = readCorpusFile("dpcsc.el");
+    if (content.empty()) {
+        throw std::runtime_error("cannot read dpcsc.el from " EXCLUSION_CORPUS_DIR);
+    }
+    
+    ExclusionParser::ParserConfig config;
+    config.columnarToggles = true;
+    size_t exclusions = 0;
+    state.setBytesProcessed(content.size());
+    state.setLinesProcessed(countLines(content));
+    state.run([&] {
+        ExclusionParser::ExclusionParser parser;
+        parser.setConfig(config);
+        exclusions = parser.parseString(content, "dpcsc.el").exclusionsParsed;
+    });
+    state.setItemsProcessed(exclusions);
+    state.setLabel(std::to_string(exclusions) + " exclusions, toggle table");
+}
+
+EXCLUSION_BENCHMARK(VisitString_dpcsc) {
+    std::string content = readCorpusFile("dpcsc.el");
+    if (content.empty()) {
+        throw std::runtime_error("cannot read dpcsc.el from " EXCLUSION_CORPUS_DIR);
+    }
+    
+    // Counts toggles only, so the cost is tokenizing without building any data
+    struct ToggleCounter : ExclusionParser::ExclusionVisitor {
+        size_t toggles = 0;
+        void onToggle(const ExclusionParser::ToggleView&) override { toggles++; }
+    };
+    
+    size_t toggles = 0;
+    ExclusionParser::ExclusionParser parser;
+    state.setBytesProcessed(content.size());
+    state.setLinesProcessed(countLines(content));
+    state.run([&] {
+        ToggleCounter counter;
+        parser.parseString(content, counter, "dpcsc.el");
+        toggles = counter.toggles;
+    });
+    state.setItemsProcessed(toggles);
+    state.setLabel(std::to_string(toggles) + " toggles");
+}
+
+/**
+ * @brief Time parseFile on dpcsc.el with the given input mode
+ */
+static void benchmarkParseFile(State& state, bool useMemoryMap) {
+    std::string path = corpusPath("dpcsc.el");
+    size_t fileSize = ExclusionParser::FileUtils::getFileSize(path);
+    if (fileSize == 0) {
+        throw std::runtime_error("cannot read " + path);
+    }
+    
+    ExclusionParser::ParserConfig config;
+    config.useMemoryMap = useMemoryMap;
+    size_t exclusions = 0;
+    state.setBytesProcessed(fileSize);
+    state.setLinesProcessed(countLines(readCorpusFile("dpcsc.el")));
+    state.run([&] {
+        ExclusionParser::ExclusionParser parser;
+        parser.setConfig(config);
+        auto result = parser.parseFile(path);
+        exclusions = result.exclusionsParsed;
+    });
+    state.setItemsProcessed(exclusions);
+    state.setLabel(std::to_string(exclusions) + " exclusions");
+}
+
+EXCLUSION_BENCHMARK(ParseFile_dpcsc_mmap) {
+    benchmarkParseFile(state, true);
+}
+
+EXCLUSION_BENCHMARK(ParseFile_dpcsc_buffered) {
+    benchmarkParseFile(state, false);
+}
+
+/**
+ * @brief Time parseFiles over the whole corpus with the given thread count
+ */
+static void benchmarkParseFiles(State& state, size_t threadCount) {
+    std::vector<std::string> files = corpusFiles();
+    if (files.empty()) {
+        throw std::runtime_error("no .el files in " EXCLUSION_CORPUS_DIR);
+    }
+    
+    size_t totalBytes = 0;
+    size_t totalLines = 0;
+    for (const auto& file : files) {
+        totalBytes += ExclusionParser::FileUtils::getFileSize(file);
+        totalLines += countLines(readCorpusFile(std::filesystem::path(file).filename().string()));
+    }
+    
+    ExclusionParser::ParserConfig config;
+    config.threadCount = threadCount;
+    size_t exclusions = 0;
+    state.setBytesProcessed(totalBytes);
+    state.setLinesProcessed(totalLines);
+    state.run([&] {
+        ExclusionParser::ExclusionParser parser;
+        parser.setConfig(config);
+        auto result = parser.parseFiles(files);
+        exclusions = result.exclusionsParsed;
+    });
+    state.setItemsProcessed(exclusions);
+    state.setLabel(std::to_string(files.size()) + " files, " +
+                   std::to_string(ExclusionParser::ThreadPool::resolveThreadCount(threadCount)) + " threads");
+}
+
+EXCLUSION_BENCHMARK(ParseFiles_corpus_serial) {
+    benchmarkParseFiles(state, 1);
+}
+
+EXCLUSION_BENCHMARK(ParseFiles_corpus_parallel) {
+    benchmarkParseFiles(state, 0);
+}
+
+/**
+ * @brief Register split-file scaling benchmarks for 1..N threads on the largest files
+ * 
+ * N is the larger of 8 and the hardware concurrency; thread counts double.
+ */
+static bool registerSplitScalingBenchmarks() {
+    size_t maxThreads = std::max<size_t>(8, ExclusionParser::ThreadPool::resolveThreadCount(0));
+    for (const char* fileName : {"dpcsc.el", "dwc_hdmi21_dp_tx_phy_phy_x4_ns.el"}) {
+        for (size_t threads = 1; threads <= maxThreads; threads *= 2) {
+            std::string name = std::string("ParseFileSplit_") + fileName + "_" + std::to_string(threads) + "t";
+            registry().push_back({name, [fileName, threads](State& state) {
+                std::string path = corpusPath(fileName);
+                size_t fileSize = ExclusionParser::FileUtils::getFileSize(path);
+                if (fileSize == 0) {
+                    throw std::runtime_error("cannot read " + path);
+                }
+                
+                ExclusionParser::ParserConfig config;
+                config.splitLargeFiles = true;
+                config.splitChunkSize = 32 * 1024;
+                config.threadCount = threads;
+                size_t exclusions = 0;
+                state.setBytesProcessed(fileSize);
+                state.setLinesProcessed(countLines(readCorpusFile(fileName)));
+                state.run([&] {
+                    ExclusionParser::ExclusionParser parser;
+                    parser.setConfig(config);
+                    exclusions = parser.parseFile(path).exclusionsParsed;
+                });
+                state.setItemsProcessed(exclusions);
+                state.setLabel(std::to_string(threads) + " threads");
+            }});
+        }
+    }
+    return true;
+}
+
+static const bool splitScalingRegistered = registerSplitScalingBenchmarks();
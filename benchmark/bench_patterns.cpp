@@ -0,0 +1,100 @@
+/**
+ * @file bench_patterns.cpp
+ * @brief Wildcard scope matching benchmarks
+ *
+ * Uses 100k synthetic scope names tb.gpuG.chipC.core.blkB (10 x 10 x 1000)
+ * and 10k patterns of the form tb.gpuG.chipC.core.blkB?*:
+ * - PatternFilter_100_x_100k: CompiledPattern::filter of 100 patterns over
+ *   the full scope list (items are pattern/name tests)
+ * - FindScopesMatching_10k_x_100k: ExclusionDataManager::findScopesMatching
+ *   for all 10k patterns, which only tests the subtree below each
+ *   pattern's literal segments (items are patterns)
+ *
+ * @author ExclusionCoverageParser
+ * @version 1.0.0
+ * @date 2025
+ */
+
+#include "BenchmarkHarness.h"
+#include "ExclusionData.h"
+
+using namespace ExclusionBenchmark;
+
+namespace {
+
+constexpr size_t kGpus = 10;
+constexpr size_t kChips = 10;
+constexpr size_t kBlocks = 1000;
+constexpr size_t kPatterns = 10000;
+
+/**
+ * @brief Build the 100k synthetic scope names
+ */
+std::vector<std::string> scopeNames() {
+    std::vector<std::string> names;
+    names.reserve(kGpus * kChips * kBlocks);
+    for (size_t gpu = 0; gpu < kGpus; ++gpu) {
+        for (size_t chip = 0; chip < kChips; ++chip) {
+            for (size_t block = 0; block < kBlocks; ++block) {
+                names.push_back("tb.gpu" + std::to_string(gpu) + ".chip" + std::to_string(chip) +
+                                ".core.blk" + std::to_string(block));
+            }
+        }
+    }
+    return names;
+}
+
+/**
+ * @brief Build count patterns spread over all gpu/chip subtrees
+ */
+std::vector<std::string> patterns(size_t count) {
+    std::vector<std::string> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        size_t subtree = i % (kGpus * kChips);
+        result.push_back("tb.gpu" + std::to_string(subtree / kChips) + ".chip" +
+                         std::to_string(subtree % kChips) + ".core.blk" +
+                         std::to_string(i % kBlocks / 10) + "?*");
+    }
+    return result;
+}
+
+} // namespace
+
+EXCLUSION_BENCHMARK(PatternFilter_100_x_100k) {
+    std::vector<std::string> names = scopeNames();
+    std::vector<ExclusionParser::CompiledPattern> compiled;
+    for (const auto& pattern : patterns(100)) {
+        compiled.emplace_back(pattern);
+    }
+
+    size_t matches = 0;
+    state.setItemsProcessed(compiled.size() * names.size());
+    state.run([&] {
+        matches = 0;
+        for (const auto& pattern : compiled) {
+            matches += pattern.filter(names).size();
+        }
+    });
+    state.setLabel(std::to_string(matches) + " matches, items are tests");
+}
+
+EXCLUSION_BENCHMARK(FindScopesMatching_10k_x_100k) {
+    auto data = std::make_shared<ExclusionParser::ExclusionData>();
+    for (const auto& name : scopeNames()) {
+        data->getOrCreateScope(name);
+    }
+    ExclusionParser::ExclusionDataManager manager;
+    manager.setData(data);
+    std::vector<std::string> queries = patterns(kPatterns);
+
+    size_t matches = 0;
+    state.setItemsProcessed(queries.size());
+    state.run([&] {
+        matches = 0;
+        for (const auto& pattern : queries) {
+            matches += manager.findScopesMatching(pattern).size();
+        }
+    });
+    state.setLabel(std::to_string(matches) + " matches, items are patterns");
+}
@@ -0,0 +1,470 @@
+/**
+ * @file bench_stages.cpp
+ * @brief Per-stage benchmarks on the corpus and on scaled synthetic inputs
+ *
+ * Covers the stages after (and around) parsing:
+ * - ParseString/ParseFile/ParseFiles on dpcsc.el scaled 4x and 16x
+ *   (scaledCorpusText) to show how throughput holds up with input size
+ * - ParseFile_cached_16x: parseFile with ParserConfig::cacheDirectory set,
+ *   timing cache hits (content hash, entry load and replay)
+ * - Merge_corpus: ExclusionData::merge of every corpus file into one data set
+ * - Search_* and GetStatistics_corpus: ExclusionDataManager queries on the
+ *   merged corpus (Search_*_indexed with secondary indexes enabled)
+ * - WriteToString_* and WriteFile_corpus: ExclusionWriter output
+ *   (WriteToString_*_parallel with WriterConfig::threadCount = 0,
+ *   WriteToString_*_sorted with WriterConfig::sortExclusions)
+ * - Freeze_corpus: ExclusionData::freeze(); the label compares the
+ *   manager's memory estimate for the live data with the snapshot size
+ * - FindBlock_synthetic_{live,frozen}: scope and block lookup by name for
+ *   every block of 10k synthetic scopes with 50 blocks each, in
+ *   ExclusionData's maps and in the snapshot; the label gives the memory
+ * - LoadBinary_synthetic_16x: loadBinaryFile on the .elb cache of the 16x
+ *   dpcsc.el (compare ParseFile_synthetic_16x); the label gives the cache
+ *   size and the speedup over one parseFile of the text
+ *
+ * Items are exclusions. Write benchmarks report the output size as bytes
+ * and lines.
+ *
+ * @author ExclusionCoverageParser
+ * @version 1.0.0
+ * @date 2025
+ */
+
+#include "BenchmarkHarness.h"
+#include "ExclusionData.h"
+#include "ExclusionFrozenData.h"
+#include "ExclusionParser.h"
+#include "ExclusionWriter.h"
+
+#include <stdexcept>
+
+using namespace ExclusionBenchmark;
+
+namespace {
+
+/**
+ * @brief Parse every corpus file into its own ExclusionData
+ * @return One data set per corpus file, in file order
+ */
+std::vector<std::shared_ptr<ExclusionParser::ExclusionData>> loadCorpusFiles() {
+    std::vector<std::string> files = corpusFiles();
+    if (files.empty()) {
+        throw std::runtime_error("no .el files in " EXCLUSION_CORPUS_DIR);
+    }
+
+    std::vector<std::shared_ptr<ExclusionParser::ExclusionData>> datas;
+    for (const auto& file : files) {
+        ExclusionParser::ExclusionParser parser;
+        auto result = parser.parseFile(file);
+        if (!result.success) {
+            throw std::runtime_error("cannot parse " + file + ": " + result.errorMessage);
+        }
+        datas.push_back(parser.getData());
+    }
+    return datas;
+}
+
+/**
+ * @brief Parse the whole corpus into one ExclusionData
+ * @return Merged corpus
+ */
+std::shared_ptr<ExclusionParser::ExclusionData> loadCorpus() {
+    std::vector<std::string> files = corpusFiles();
+    if (files.empty()) {
+        throw std::runtime_error("no .el files in " EXCLUSION_CORPUS_DIR);
+    }
+
+    ExclusionParser::ExclusionParser parser;
+    auto result = parser.parseFiles(files);
+    if (!result.success) {
+        throw std::runtime_error("cannot parse corpus: " + result.errorMessage);
+    }
+    return parser.getData();
+}
+
+/**
+ * @brief Parse a scaled copy of dpcsc.el into one ExclusionData
+ * @param copies Scale factor
+ * @return Parsed data
+ */
+std::shared_ptr<ExclusionParser::ExclusionData> loadScaled(size_t copies) {
+    std::string content = scaledCorpusText("dpcsc.el", copies);
+    if (content.empty()) {
+        throw std::runtime_error("cannot read dpcsc.el from " EXCLUSION_CORPUS_DIR);
+    }
+
+    ExclusionParser::ExclusionParser parser;
+    parser.parseString(content, "dpcsc_scaled.el");
+    return parser.getData();
+}
+
+/**
+ * @brief Directory for files written by the benchmarks
+ * @return Existing temporary directory
+ */
+std::filesystem::path scratchDirectory() {
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "exclusion_benchmarks";
+    std::filesystem::create_directories(directory);
+    return directory;
+}
+
+/**
+ * @brief Time parseString on dpcsc.el scaled by the given factor
+ */
+void benchmarkParseScaled(State& state, size_t copies) {
+    std::string content = scaledCorpusText("dpcsc.el", copies);
+    if (content.empty()) {
+        throw std::runtime_error("cannot read dpcsc.el from " EXCLUSION_CORPUS_DIR);
+    }
+
+    size_t exclusions = 0;
+    state.setBytesProcessed(content.size());
+    state.setLinesProcessed(countLines(content));
+    state.run([&] {
+        ExclusionParser::ExclusionParser parser;
+        exclusions = parser.parseString(content, "dpcsc_scaled.el").exclusionsParsed;
+    });
+    state.setItemsProcessed(exclusions);
+    state.setLabel(std::to_string(copies) + "x dpcsc.el");
+}
+
+/**
+ * @brief Time parseFile (or parseFiles) on a scaled dpcsc.el written to disk
+ * 
+ * With cached set, the parse cache is enabled on an empty directory: the
+ * untimed warm-up run parses and stores the entry, the timed runs hit it.
+ */
+void benchmarkParseScaledFile(State& state, size_t copies, bool asFileList, bool cached = false) {
+    std::string content = scaledCorpusText("dpcsc.el", copies);
+    if (content.empty()) {
+        throw std::runtime_error("cannot read dpcsc.el from " EXCLUSION_CORPUS_DIR);
+    }
+
+    std::string path = (scratchDirectory() / ("dpcsc_" + std::to_string(copies) + "x.el")).string();
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << content;
+    }
+
+    ExclusionParser::ParserConfig config;
+    std::filesystem::path cacheDirectory = scratchDirectory() / "parse_cache";
+    std::filesystem::remove_all(cacheDirectory);
+    if (cached) {
+        config.cacheDirectory = cacheDirectory.string();
+    }
+
+    size_t exclusions = 0;
+    size_t hits = 0;
+    state.setBytesProcessed(content.size());
+    state.setLinesProcessed(countLines(content));
+    state.run([&] {
+        ExclusionParser::ExclusionParser parser;
+        parser.setConfig(config);
+        auto result = asFileList ? parser.parseFiles({path}) : parser.parseFile(path);
+        exclusions = result.exclusionsParsed;
+        hits = result.cacheHits;
+    });
+    state.setItemsProcessed(exclusions);
+    state.setLabel(std::to_string(copies) + "x dpcsc.el" + (cached ? hits ? ", cache hit" : ", cache miss" : ""));
+    std::filesystem::remove(path);
+    std::filesystem::remove_all(cacheDirectory);
+}
+
+/**
+ * @brief Time writeToString on the given data
+ */
+void benchmarkWriteToString(State& state, const ExclusionParser::ExclusionData& data, const std::string& label,
+                            size_t threadCount = 1, bool sorted = false) {
+    ExclusionParser::ExclusionWriter writer;
+    ExclusionParser::WriterConfig config;
+    config.threadCount = threadCount;
+    config.sortExclusions = sorted;
+    writer.setConfig(config);
+    std::string output = writer.writeToString(data);
+    state.setBytesProcessed(output.size());
+    state.setLinesProcessed(countLines(output));
+    state.setItemsProcessed(data.getTotalExclusionCount());
+    state.run([&] {
+        output = writer.writeToString(data);
+    });
+    state.setLabel(label);
+}
+
+ExclusionParser::SearchCriteria toggleSignalCriteria() {
+    ExclusionParser::SearchCriteria criteria;
+    criteria.type = ExclusionParser::ExclusionType::TOGGLE;
+    criteria.signalName = "clk";
+    return criteria;
+}
+
+ExclusionParser::SearchCriteria annotationCriteria() {
+    ExclusionParser::SearchCriteria criteria;
+    criteria.annotation = "unused";
+    return criteria;
+}
+
+/**
+ * @brief Time ExclusionDataManager::search on the merged corpus
+ * 
+ * With indexing, the indexes are built by the untimed warm-up run, so the
+ * timed runs show the interactive (repeated query) cost.
+ */
+void benchmarkSearch(State& state, const ExclusionParser::SearchCriteria& criteria, bool indexed) {
+    ExclusionParser::ExclusionDataManager manager;
+    manager.setData(loadCorpus());
+    manager.setIndexingEnabled(indexed);
+
+    size_t matches = 0;
+    state.setItemsProcessed(manager.getData()->getTotalExclusionCount());
+    state.run([&] {
+        matches = manager.search(criteria).size();
+    });
+    state.setLabel(std::to_string(matches) + " matches");
+}
+
+/**
+ * @brief 10k instance scopes with 50 block exclusions each
+ */
+std::shared_ptr<ExclusionParser::ExclusionData> syntheticBlocks() {
+    auto data = std::make_shared<ExclusionParser::ExclusionData>("synthetic.el");
+    for (size_t i = 0; i < 10000; ++i) {
+        auto& scope = data->getOrCreateScope("tb.gpu" + std::to_string(i / 1000) + ".chip" +
+                                             std::to_string(i / 100 % 10) + ".core.blk" + std::to_string(i % 100),
+                                             std::to_string(i), false);
+        for (size_t block = 0; block < 50; ++block) {
+            scope.addBlockExclusion(ExclusionParser::BlockExclusion(
+                std::to_string(block * 7), std::to_string(1104666086 + block),
+                "assign data_out_" + std::to_string(block) + " = data_in & mask;", "Unused logic"));
+        }
+    }
+    return data;
+}
+
+/**
+ * @brief (scope name, block ID) of every block in the data, in a scattered order
+ */
+std::vector<std::pair<std::string, std::string>> blockQueries(const ExclusionParser::ExclusionData& data) {
+    std::vector<std::pair<std::string, std::string>> queries;
+    for (const auto& [scopeName, scope] : data.scopes) {
+        for (const auto& [blockId, block] : scope.blockExclusions) {
+            queries.emplace_back(scopeName, blockId);
+        }
+    }
+    for (size_t i = 0; i < queries.size(); ++i) {
+        std::swap(queries[i], queries[(i * 7919) % queries.size()]);
+    }
+    return queries;
+}
+
+} // namespace
+
+EXCLUSION_BENCHMARK(ParseString_synthetic_4x) {
+    benchmarkParseScaled(state, 4);
+}
+
+EXCLUSION_BENCHMARK(ParseString_synthetic_16x) {
+    benchmarkParseScaled(state, 16);
+}
+
+EXCLUSION_BENCHMARK(ParseFile_synthetic_16x) {
+    benchmarkParseScaledFile(state, 16, false);
+}
+
+EXCLUSION_BENCHMARK(ParseFiles_synthetic_16x) {
+    benchmarkParseScaledFile(state, 16, true);
+}
+
+EXCLUSION_BENCHMARK(ParseFile_cached_16x) {
+    benchmarkParseScaledFile(state, 16, false, true);
+}
+
+EXCLUSION_BENCHMARK(Merge_corpus) {
+    auto datas = loadCorpusFiles();
+    size_t totalBytes = 0;
+    for (const auto& file : corpusFiles()) {
+        totalBytes += ExclusionParser::FileUtils::getFileSize(file);
+    }
+
+    size_t exclusions = 0;
+    state.setBytesProcessed(totalBytes);
+    state.run([&] {
+        ExclusionParser::ExclusionData merged;
+        for (const auto& data : datas) {
+            merged.merge(*data);
+        }
+        exclusions = merged.getTotalExclusionCount();
+    });
+    state.setItemsProcessed(exclusions);
+    state.setLabel(std::to_string(datas.size()) + " files");
+}
+
+EXCLUSION_BENCHMARK(Search_corpus_toggleSignal) {
+    benchmarkSearch(state, toggleSignalCriteria(), false);
+}
+
+EXCLUSION_BENCHMARK(Search_corpus_toggleSignal_indexed) {
+    benchmarkSearch(state, toggleSignalCriteria(), true);
+}
+
+EXCLUSION_BENCHMARK(Search_corpus_annotation) {
+    benchmarkSearch(state, annotationCriteria(), false);
+}
+
+EXCLUSION_BENCHMARK(Search_corpus_annotation_indexed) {
+    benchmarkSearch(state, annotationCriteria(), true);
+}
+
+EXCLUSION_BENCHMARK(GetStatistics_corpus) {
+    ExclusionParser::ExclusionDataManager manager;
+    manager.setData(loadCorpus());
+
+    size_t scopes = 0;
+    state.setItemsProcessed(manager.getData()->getTotalExclusionCount());
+    state.run([&] {
+        scopes = manager.getStatistics().totalScopes;
+    });
+    state.setLabel(std::to_string(scopes) + " scopes");
+}
+
+EXCLUSION_BENCHMARK(WriteToString_corpus) {
+    auto data = loadCorpus();
+    benchmarkWriteToString(state, *data, "corpus");
+}
+
+EXCLUSION_BENCHMARK(WriteToString_synthetic_16x) {
+    auto data = loadScaled(16);
+    benchmarkWriteToString(state, *data, "16x dpcsc.el");
+}
+
+EXCLUSION_BENCHMARK(WriteToString_synthetic_16x_sorted) {
+    auto data = loadScaled(16);
+    benchmarkWriteToString(state, *data, "16x dpcsc.el, sorted", 1, true);
+}
+
+EXCLUSION_BENCHMARK(WriteToString_corpus_parallel) {
+    auto data = loadCorpus();
+    benchmarkWriteToString(state, *data, "corpus", 0);
+}
+
+EXCLUSION_BENCHMARK(WriteToString_synthetic_16x_parallel) {
+    auto data = loadScaled(16);
+    benchmarkWriteToString(state, *data, "16x dpcsc.el", 0);
+}
+
+EXCLUSION_BENCHMARK(WriteFile_corpus) {
+    auto data = loadCorpus();
+    std::string path = (scratchDirectory() / "corpus_out.el").string();
+
+    ExclusionParser::ExclusionWriter writer;
+    std::string output = writer.writeToString(*data);
+    state.setBytesProcessed(output.size());
+    state.setLinesProcessed(countLines(output));
+    state.setItemsProcessed(data->getTotalExclusionCount());
+
+    bool success = true;
+    state.run([&] {
+        success = writer.writeFile(path, *data).success && success;
+    });
+    std::filesystem::remove(path);
+    if (!success) {
+        throw std::runtime_error("cannot write " + path);
+    }
+    state.setLabel("corpus");
+}
+
+EXCLUSION_BENCHMARK(Freeze_corpus) {
+    ExclusionParser::ExclusionDataManager manager;
+    manager.setData(loadCorpus());
+
+    size_t frozenBytes = 0;
+    state.setItemsProcessed(manager.getData()->getTotalExclusionCount());
+    state.run([&] {
+        frozenBytes = manager.getData()->freeze().getMemoryUsage();
+    });
+    state.setLabel("live ~" + std::to_string(manager.getMemoryUsage() / 1024) + " KiB, frozen " +
+                   std::to_string(frozenBytes / 1024) + " KiB");
+}
+
+EXCLUSION_BENCHMARK(FindBlock_synthetic_live) {
+    auto data = syntheticBlocks();
+    auto queries = blockQueries(*data);
+    ExclusionParser::ExclusionDataManager manager;
+    manager.setData(data);
+
+    size_t found = 0;
+    state.setItemsProcessed(queries.size());
+    state.run([&] {
+        found = 0;
+        for (const auto& [scopeName, blockId] : queries) {
+            auto scope = data->scopes.find(scopeName);
+            found += scope != data->scopes.end() && scope->second.blockExclusions.count(blockId) != 0;
+        }
+    });
+    state.setLabel(std::to_string(found) + " found, ~" + std::to_string(manager.getMemoryUsage() / 1024) +
+                   " KiB, items are lookups");
+}
+
+EXCLUSION_BENCHMARK(FindBlock_synthetic_frozen) {
+    auto data = syntheticBlocks();
+    auto queries = blockQueries(*data);
+    ExclusionParser::FrozenExclusionData frozen = data->freeze();
+    data.reset();
+
+    size_t found = 0;
+    state.setItemsProcessed(queries.size());
+    state.run([&] {
+        found = 0;
+        for (const auto& [scopeName, blockId] : queries) {
+            const auto* scope = frozen.findScope(scopeName);
+            found += scope != nullptr && frozen.findBlock(*scope, blockId) != nullptr;
+        }
+    });
+    state.setLabel(std::to_string(found) + " found, " + std::to_string(frozen.getMemoryUsage() / 1024) +
+                   " KiB, items are lookups");
+}
+
+EXCLUSION_BENCHMARK(LoadBinary_synthetic_16x) {
+    std::string content = scaledCorpusText("dpcsc.el", 16);
+    if (content.empty()) {
+        throw std::runtime_error("cannot read dpcsc.el from " EXCLUSION_CORPUS_DIR);
+    }
+    std::string textPath = (scratchDirectory() / "dpcsc_16x_cache.el").string();
+    std::string binaryPath = (scratchDirectory() / "dpcsc_16x.elb").string();
+    {
+        std::ofstream file(textPath, std::ios::binary);
+        file << content;
+    }
+
+    // One text parse, for the speedup in the label
+    ExclusionParser::ExclusionParser parser;
+    auto start = std::chrono::steady_clock::now();
+    bool success = parser.parseFile(textPath).success;
+    double parseSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    ExclusionParser::ExclusionWriter writer;
+    success = success && writer.writeBinaryFile(binaryPath, *parser.getData()).success;
+    std::filesystem::remove(textPath);
+    if (!success) {
+        throw std::runtime_error("cannot write " + binaryPath);
+    }
+
+    size_t binaryBytes = ExclusionParser::FileUtils::getFileSize(binaryPath);
+    size_t exclusions = 0;
+    double loadSeconds = 0.0;
+    state.setBytesProcessed(binaryBytes);
+    state.run([&] {
+        auto loadStart = std::chrono::steady_clock::now();
+        ExclusionParser::FrozenExclusionData frozen;
+        auto result = parser.loadBinaryFile(binaryPath, frozen);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - loadStart).count();
+        loadSeconds = loadSeconds == 0.0 ? seconds : std::min(loadSeconds, seconds);
+        success = result.success && success;
+        exclusions = result.exclusionsParsed;
+    });
+    std::filesystem::remove(binaryPath);
+    if (!success) {
+        throw std::runtime_error("cannot load " + binaryPath);
+    }
+    state.setItemsProcessed(exclusions);
+    state.setLabel("16x dpcsc.el, " + std::to_string(binaryBytes / 1024) + " KiB, ~" +
+                   std::to_string(static_cast<size_t>(parseSeconds / loadSeconds)) + "x vs text");
+}
@@ -0,0 +1,174 @@
+/**
+ * @file benchmark_main.cpp
+ * @brief Entry point for the ExclusionParserBenchmarks target
+ * 
+ * Runs every registered benchmark (or those whose name contains the filter
+ * given on the command line) and prints time, throughput and peak RSS.
+ * With --json the same results are also written as JSON, for tracking
+ * regressions between releases.
+ * 
+ * Usage: ExclusionParserBenchmarks [--iterations N] [--json FILE|-] [filter]
+ * 
+ * @author ExclusionCoverageParser
+ * @version 1.0.0
+ * @date 2025
+ */
+
+#include "BenchmarkHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+
+namespace {
+
+/**
+ * @brief Result of one benchmark, as reported in the table and the JSON output
+ */
+struct Result {
+    std::string name;           ///< Benchmark name
+    std::string label;          ///< Free-form label
+    std::string error;          ///< Failure message (empty on success)
+    double bestMs = 0.0;        ///< Fastest iteration in milliseconds
+    double meanMs = 0.0;        ///< Mean iteration in milliseconds
+    size_t bytes = 0;           ///< Bytes per iteration
+    size_t lines = 0;           ///< Lines per iteration
+    size_t items = 0;           ///< Items (exclusions) per iteration
+    double mbPerSecond = 0.0;   ///< Bytes per second / 1e6, from the best iteration
+    double linesPerSecond = 0.0; ///< Lines per second, from the best iteration
+    double itemsPerSecond = 0.0; ///< Items per second, from the best iteration
+    size_t peakRssKb = 0;       ///< Peak RSS while the benchmark ran
+};
+
+/**
+ * @brief Escape a string for a JSON string literal
+ */
+std::string jsonEscape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        switch (c) {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char code[8];
+                    std::snprintf(code, sizeof(code), "\\u%04x", c);
+                    escaped += code;
+                } else {
+                    escaped += c;
+                }
+        }
+    }
+    return escaped;
+}
+
+/**
+ * @brief Write all results as one JSON document
+ */
+void writeJson(std::FILE* out, const std::vector<Result>& results, size_t iterations, bool perBenchmarkRss) {
+    std::fprintf(out, "{\n");
+    std::fprintf(out, "  \"corpus\": \"%s\",\n", jsonEscape(EXCLUSION_CORPUS_DIR).c_str());
+    std::fprintf(out, "  \"iterations\": %zu,\n", iterations);
+    std::fprintf(out, "  \"peak_rss_per_benchmark\": %s,\n", perBenchmarkRss ? "true" : "false");
+    std::fprintf(out, "  \"process_peak_rss_kb\": %zu,\n", ExclusionBenchmark::peakRssKilobytes());
+    std::fprintf(out, "  \"benchmarks\": [");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::fprintf(out, "%s\n    {\"name\": \"%s\", ", i ? "," : "", jsonEscape(r.name).c_str());
+        if (!r.error.empty()) {
+            std::fprintf(out, "\"error\": \"%s\"}", jsonEscape(r.error).c_str());
+            continue;
+        }
+        std::fprintf(out, "\"label\": \"%s\", \"best_ms\": %.4f, \"mean_ms\": %.4f, "
+                          "\"bytes\": %zu, \"lines\": %zu, \"exclusions\": %zu, "
+                          "\"mb_per_second\": %.2f, \"lines_per_second\": %.0f, "
+                          "\"exclusions_per_second\": %.0f, \"peak_rss_kb\": %zu}",
+                     jsonEscape(r.label).c_str(), r.bestMs, r.meanMs, r.bytes, r.lines, r.items,
+                     r.mbPerSecond, r.linesPerSecond, r.itemsPerSecond, r.peakRssKb);
+    }
+    std::fprintf(out, "\n  ]\n}\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t iterations = 20;
+    std::string filter;
+    std::string jsonPath;
+    
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else {
+            filter = argv[i];
+        }
+    }
+    
+    // With JSON on stdout the table goes to stderr so stdout stays parseable
+    std::FILE* table = jsonPath == "-" ? stderr : stdout;
+    std::fprintf(table, "%-40s %12s %12s %10s %12s %12s %10s\n",
+                 "Benchmark", "best ms", "mean ms", "MB/s", "lines/s", "items/s", "peak KB");
+    
+    std::vector<Result> results;
+    bool perBenchmarkRss = true;
+    int failures = 0;
+    for (const auto& benchmark : ExclusionBenchmark::registry()) {
+        if (!filter.empty() && benchmark.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        
+        Result result;
+        result.name = benchmark.name;
+        perBenchmarkRss = ExclusionBenchmark::resetPeakRss() && perBenchmarkRss;
+        
+        ExclusionBenchmark::State state(iterations);
+        try {
+            benchmark.body(state);
+        } catch (const std::exception& e) {
+            std::fprintf(table, "%-40s FAILED: %s\n", benchmark.name.c_str(), e.what());
+            result.error = e.what();
+            results.push_back(std::move(result));
+            failures++;
+            continue;
+        }
+        
+        double best = state.getBestSeconds();
+        result.label = state.getLabel();
+        result.bestMs = best * 1.0e3;
+        result.meanMs = state.getMeanSeconds() * 1.0e3;
+        result.bytes = state.getBytesProcessed();
+        result.lines = state.getLinesProcessed();
+        result.items = state.getItemsProcessed();
+        if (best > 0.0) {
+            result.mbPerSecond = static_cast<double>(result.bytes) / best / 1.0e6;
+            result.linesPerSecond = static_cast<double>(result.lines) / best;
+            result.itemsPerSecond = static_cast<double>(result.items) / best;
+        }
+        result.peakRssKb = ExclusionBenchmark::peakRssKilobytes();
+        
+        std::fprintf(table, "%-40s %12.3f %12.3f %10.1f %12.0f %12.0f %10zu %s\n",
+                     result.name.c_str(), result.bestMs, result.meanMs, result.mbPerSecond,
+                     result.linesPerSecond, result.itemsPerSecond, result.peakRssKb,
+                     result.label.c_str());
+        results.push_back(std::move(result));
+    }
+    
+    if (!jsonPath.empty()) {
+        std::FILE* out = jsonPath == "-" ? stdout : std::fopen(jsonPath.c_str(), "w");
+        if (!out) {
+            std::fprintf(stderr, "cannot write %s\n", jsonPath.c_str());
+            return 1;
+        }
+        writeJson(out, results, iterations, perBenchmarkRss);
+        if (out != stdout) {
+            std::fclose(out);
+        }
+    }
+    
+    return failures == 0 ? 0 : 1;
+}
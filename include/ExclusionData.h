@@ -32,6 +32,8 @@
 #include "ExclusionTypes.h"
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <string_view>
 #include <unordered_set>
 
 namespace ExclusionParser {
@@ -44,8 +46,12 @@ namespace ExclusionParser {
 struct EXCLUSION_API SearchCriteria {
     std::optional<ExclusionType> type;      ///< Filter by exclusion type
     std::optional<std::string> scopeName;   ///< Filter by scope name (can be partial)
+    std::optional<std::string> scopePath;   ///< Filter to scopes at or below a hierarchical path
+    std::optional<std::string> scopePattern; ///< Filter by scope name glob (* and ?)
     std::optional<std::string> annotation;  ///< Filter by annotation content
     std::optional<std::string> signalName;  ///< Filter by signal name (for toggles)
+    std::optional<int> bitIndex;            ///< Filter by bit index (for toggles)
+    std::optional<std::string> fsmName;     ///< Filter by FSM name (for FSM exclusions)
     std::optional<bool> isModule;           ///< Filter by scope type (module vs instance)
     
     /**
@@ -102,10 +108,34 @@ struct EXCLUSION_API ExclusionStatistics {
  * auto stats = manager.getStatistics();
  * std::cout << "Total exclusions: " << stats.totalExclusions << std::endl;
  * @endcode
+ * 
+ * With setIndexingEnabled(true), search(), findByAnnotation(),
+ * getAllSignalNames() and getAllFsmNames() answer from secondary indexes
+ * (by exclusion type, scope kind, signal name, FSM name and annotation
+ * token) built on first use. A query rebuilds them when the data's
+ * generation (ExclusionData::getGeneration()) has changed, which covers
+ * parsing, the data's own methods and getOrCreateScope(). After editing the
+ * exclusions of a scope reached through the scopes map directly, call
+ * ExclusionData::markModified() (or invalidateIndexes()).
  */
 class EXCLUSION_API ExclusionDataManager {
 private:
+    struct SearchIndex;
+    
     std::shared_ptr<ExclusionData> data_;   ///< Managed exclusion data
+    bool indexingEnabled_;                  ///< Answer queries from secondary indexes
+    mutable std::mutex indexMutex_;         ///< Guards index_
+    mutable std::shared_ptr<const SearchIndex> index_;  ///< Secondary indexes, built on first use
+    
+    /**
+     * @brief Get the secondary indexes, building them if missing or stale
+     * 
+     * Returns a reference rather than a pointer, so a query keeps its indexes
+     * even if another thread drops them meanwhile.
+     * 
+     * @return Indexes for data_, or nullptr if indexing is disabled
+     */
+    std::shared_ptr<const SearchIndex> getIndex() const;
     
 public:
     /**
@@ -118,8 +148,42 @@ public:
      */
     ~ExclusionDataManager();
     
+    /**
+     * @brief Copy constructor; shares the data, the copy builds its own indexes
+     */
+    ExclusionDataManager(const ExclusionDataManager& other);
+    
+    /**
+     * @brief Copy assignment; shares the data, the copy builds its own indexes
+     */
+    ExclusionDataManager& operator=(const ExclusionDataManager& other);
+    
+    /**
+     * @brief Enable or disable the secondary search indexes
+     * @param enabled True to build indexes on the next query
+     */
+    void setIndexingEnabled(bool enabled);
+    
+    /**
+     * @brief Check whether queries use the secondary indexes
+     * @return True if indexing is enabled
+     */
+    bool isIndexingEnabled() const { return indexingEnabled_; }
+    
+    /**
+     * @brief Drop the secondary indexes after editing the data directly
+     * 
+     * The indexes are rebuilt by the next query. Only needed for edits the
+     * data's generation does not see; see ExclusionData::markModified().
+     */
+    void invalidateIndexes();
+    
     /**
      * @brief Set the exclusion data to manage
+     * 
+     * If scopes were added to the data's map directly, its scope index is
+     * rebuilt here so hierarchical queries can use it.
+     * 
      * @param data Shared pointer to exclusion data
      */
     void setData(std::shared_ptr<ExclusionData> data);
@@ -159,11 +223,40 @@ public:
     
     /**
      * @brief Find all scopes that match a pattern
+     * 
+     * Only scopes starting with the pattern's text before its first
+     * wildcard are tested, e.g. "tb.gpu0.*.dcio" only looks at scopes under
+     * "tb.gpu0".
+     * 
      * @param pattern Pattern to match (supports wildcards * and ?)
      * @return Vector of matching scope names
      */
     std::vector<std::string> findScopesMatching(const std::string& pattern) const;
     
+    /**
+     * @brief Find all scopes at or below a hierarchical path
+     * 
+     * For "tb.gpu0.chip0" this returns "tb.gpu0.chip0" (if it is a scope)
+     * and every scope named "tb.gpu0.chip0.<...>", in time proportional to
+     * the result.
+     * 
+     * @param path Dotted scope path; empty returns every scope
+     * @return Vector of matching scope names
+     */
+    std::vector<std::string> findScopesUnder(const std::string& path) const;
+    
+    /**
+     * @brief Find all scopes matching a path-segment glob
+     * 
+     * The pattern is matched one dotted segment at a time: '*' and '?' stay
+     * within a segment and a "**" segment spans any number of segments,
+     * e.g. "tb.gpu*.**.dcio". See ScopeTrie.
+     * 
+     * @param pattern Dotted segment glob
+     * @return Vector of matching scope names
+     */
+    std::vector<std::string> findScopesMatchingPath(const std::string& pattern) const;
+    
     /**
      * @brief Get comprehensive statistics about the exclusion data
      * @return Statistics structure
@@ -233,6 +326,10 @@ public:
     
     /**
      * @brief Get memory usage estimate in bytes
+     * 
+     * Interned text (annotations, net descriptions, toggle signal names) is
+     * counted once per distinct copy, not once per exclusion referring to it.
+     * 
      * @return Estimated memory usage
      */
     size_t getMemoryUsage() const;
@@ -285,15 +382,101 @@ void ExclusionDataManager::forEachExclusion(ExclusionType type,
     }
 }
 
+/**
+ * @brief Wildcard pattern compiled once for repeated matching
+ * 
+ * '*' matches any run of characters (including none), '?' matches one
+ * character and a backslash makes the next character literal (see
+ * PatternMatcher::escape). The pattern is split at its stars into literal
+ * pieces once; matching anchors the first and last piece and finds the
+ * others left to right, without backtracking and without allocating.
+ * 
+ * Usage Example:
+ * @code
+ * CompiledPattern pattern("tb.gpu0.*.dcio*");
+ * auto names = pattern.filter(scopeNames);
+ * @endcode
+ */
+class EXCLUSION_API CompiledPattern {
+public:
+    /**
+     * @brief Compile a wildcard pattern
+     * @param pattern Pattern with * and ? wildcards
+     * @param caseSensitive Whether matching should be case sensitive
+     */
+    explicit CompiledPattern(std::string_view pattern, bool caseSensitive = true);
+    
+    /**
+     * @brief Check if a string matches the pattern
+     * @param str String to test
+     * @return True if the whole string matches
+     */
+    bool matches(std::string_view str) const;
+    
+    /**
+     * @brief Match a list of names in one call
+     * @param names Names to test (e.g. scope names)
+     * @return Matching names, in input order
+     */
+    std::vector<std::string> filter(const std::vector<std::string>& names) const;
+    
+    /**
+     * @brief Get the text every match starts with
+     * @return Pattern text before the first wildcard, with escapes resolved;
+     *         empty for case-insensitive patterns, whose matches may differ in case
+     */
+    const std::string& getLiteralPrefix() const { return literalPrefix_; }
+    
+    /**
+     * @brief Check if the pattern has no wildcards
+     * @return True if only the literal text itself matches
+     */
+    bool isLiteral() const { return pieces_.size() == 1 && !pieces_.front().hasWildcard; }
+    
+    /**
+     * @brief Check if the pattern is case sensitive
+     * @return True if case sensitive
+     */
+    bool isCaseSensitive() const { return caseSensitive_; }
+    
+private:
+    /// Text between two stars; '?' positions are flagged in anyChar
+    struct Piece {
+        std::string text;               ///< Literal characters (lowercase when case-insensitive)
+        std::vector<bool> anyChar;      ///< Positions matching any character (empty if none)
+        bool hasWildcard = false;       ///< True if any position is '?'
+    };
+    
+    std::vector<Piece> pieces_;         ///< Pieces split at stars; at least one (possibly empty)
+    std::string literalPrefix_;         ///< Text before the first '*' or '?' (case-sensitive only)
+    size_t minLength_;                  ///< Sum of piece lengths
+    bool caseSensitive_;                ///< Case sensitive matching
+    
+    /**
+     * @brief Check if a piece matches str at a position (enough characters must remain)
+     */
+    bool matchesAt(const Piece& piece, std::string_view str, size_t position) const;
+    
+    /**
+     * @brief Find the leftmost match of a piece in str[from, to)
+     * @return Start position, or std::string_view::npos
+     */
+    size_t find(const Piece& piece, std::string_view str, size_t from, size_t to) const;
+};
+
 /**
  * @brief Utility class for pattern matching
  * 
  * Provides wildcard pattern matching functionality for scope names and other strings.
+ * For repeated matching against one pattern, use CompiledPattern.
  */
 class EXCLUSION_API PatternMatcher {
 public:
     /**
      * @brief Check if a string matches a wildcard pattern
+     * 
+     * Compiles the pattern for this one call; see CompiledPattern.
+     * 
      * @param pattern Pattern with * and ? wildcards
      * @param str String to test
      * @param caseSensitive Whether matching should be case sensitive
@@ -0,0 +1,369 @@
+/**
+ * @file ExclusionFrozenData.h
+ * @brief Immutable, flat snapshot of ExclusionData for read-only use
+ *
+ * Once loaded, a chip's exclusions are usually only read. FrozenExclusionData
+ * (from ExclusionData::freeze()) stores them without hash map nodes or
+ * per-string allocations:
+ * - all text in one blob, referenced by offset and length (TextRef), with
+ *   repeated strings (annotations, signal names, checksums) stored once;
+ * - scopes in one array sorted by name;
+ * - each exclusion type in one array, grouped by scope and sorted by key
+ *   within the scope, so a scope's exclusions are a contiguous span;
+ * - flat hash indexes (8 bytes per entry) for findScope(), findBlock() and
+ *   findCondition(), so a lookup probes one slot instead of chasing nodes.
+ *
+ * Toggles from both toggle stores are expanded to one record per direction,
+ * as ExclusionScope::forEachToggle() reports them, and sorted by signal, bit
+ * and direction. Their stored order is kept alongside, so accept() rebuilds
+ * data the writer renders exactly like the source.
+ *
+ * All of this lives in one relocatable image: a header, then sections that
+ * refer to each other only by index and offset. The image is also the .elb
+ * binary cache format (ExclusionWriter::writeBinaryFile(),
+ * ExclusionParser::loadBinaryFile()); loading maps the file and checks the
+ * header, without decoding any record.
+ *
+ * Usage Example:
+ * @code
+ * FrozenExclusionData frozen = parser.getData()->freeze();
+ * if (const auto* scope = frozen.findScope("tb.gpu0.chip0.core.udcnc")) {
+ *     for (const auto& block : frozen.blocks(*scope)) {
+ *         std::cout << frozen.text(block.blockId) << std::endl;
+ *     }
+ * }
+ * @endcode
+ *
+ * @author AMD Advanced Micro Devices Inc. - Verification Infrastructure Team
+ * @version 2.0.0
+ * @date September 13, 2025
+ * @copyright (c) 2025 Advanced Micro Devices Inc. All rights reserved.
+ */
+
+#ifndef EXCLUSION_FROZEN_DATA_H
+#define EXCLUSION_FROZEN_DATA_H
+
+#include "ExclusionData.h"
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ExclusionParser {
+
+class ExclusionVisitor;
+
+/**
+ * @brief Read-only exclusion data in contiguous sorted arrays
+ *
+ * Copies share the immutable image. Safe for any number of concurrent readers.
+ */
+class EXCLUSION_API FrozenExclusionData {
+public:
+    /**
+     * @brief Location of a string in the text blob
+     */
+    struct TextRef {
+        uint32_t offset = 0;    ///< Byte offset in the blob
+        uint32_t length = 0;    ///< Byte length
+
+        bool empty() const { return length == 0; }
+    };
+
+    /// .elb format version; images of other versions are rejected
+    static constexpr uint32_t FORMAT_VERSION = 3;
+
+    /// Block exclusion record
+    struct Block {
+        TextRef blockId;
+        TextRef checksum;
+        TextRef sourceCode;
+        TextRef annotation;
+    };
+
+    /// Toggle exclusion record (one direction of one bit)
+    struct Toggle {
+        TextRef signalName;
+        TextRef netDescription;
+        TextRef annotation;
+        int32_t bit;                ///< Bit index, or NO_BIT for scalar signals
+        ToggleDirection direction;
+
+        static constexpr int32_t NO_BIT = INT32_MIN;
+
+        std::optional<int> bitIndex() const {
+            return bit == NO_BIT ? std::nullopt : std::optional<int>(bit);
+        }
+    };
+
+    /// FSM state or transition exclusion record
+    struct Fsm {
+        TextRef fsmName;
+        TextRef checksum;
+        TextRef fromState;
+        TextRef toState;
+        TextRef transitionId;
+        TextRef annotation;
+        bool isTransition;
+    };
+
+    /// Condition exclusion record
+    struct Condition {
+        TextRef conditionId;
+        TextRef checksum;
+        TextRef expression;
+        TextRef parameters;
+        TextRef coverage;
+        TextRef annotation;
+    };
+
+    /// Scope record; each range indexes the array of that exclusion type
+    struct Scope {
+        TextRef name;
+        TextRef checksum;
+        bool isModule;
+        uint32_t blockBegin, blockEnd;
+        uint32_t toggleBegin, toggleEnd;
+        uint32_t fsmBegin, fsmEnd;
+        uint32_t conditionBegin, conditionEnd;
+
+        size_t getTotalExclusionCount() const {
+            return (blockEnd - blockBegin) + (toggleEnd - toggleBegin) + (fsmEnd - fsmBegin) +
+                   (conditionEnd - conditionBegin);
+        }
+    };
+
+    // File metadata, as in ExclusionData
+    std::string fileName;
+    std::string generatedBy;
+    std::string formatVersion;
+    std::string generationDate;
+    std::string exclusionMode;
+
+private:
+    std::shared_ptr<const void> storage_;   ///< Owns the image (heap buffer or mapped file)
+    std::string_view image_;                ///< Header and all sections
+
+    // Views into image_
+    std::string_view blob_;                 ///< All text, back to back
+    std::span<const Scope> scopes_;         ///< Sorted by name
+    std::span<const Block> blocks_;         ///< By scope, then block ID
+    std::span<const Toggle> toggles_;       ///< By scope, then signal, bit and direction
+    std::span<const uint32_t> toggleOrder_; ///< By scope, the toggles_ index (within the scope) in stored order
+    std::span<const Fsm> fsms_;             ///< By scope, then FSM name (file order within a name)
+    std::span<const Condition> conditions_; ///< By scope, then condition ID
+
+    /**
+     * @brief Open-addressing index from a key hash to a record index
+     *
+     * Each slot holds the upper 32 bits of the hash and the record index + 1
+     * (0 marks an empty slot), so most mismatches are rejected without
+     * touching the record.
+     */
+    struct HashIndex {
+        std::span<const uint64_t> slots;    ///< Power-of-two slot count
+        uint64_t mask = 0;
+
+        template <typename Match>
+        const uint64_t* find(uint64_t hash, Match&& match) const;
+    };
+
+    HashIndex scopeIndex_;          ///< Scope name
+    HashIndex blockIndex_;          ///< (scope, block ID)
+    HashIndex conditionIndex_;      ///< (scope, condition ID)
+
+    /**
+     * @brief Validate an image and point the views into it
+     * @return False (with errorMessage set) if the image is not usable
+     */
+    bool attach(std::shared_ptr<const void> storage, std::string_view image, bool verifyContent,
+                std::string& errorMessage);
+
+public:
+    /**
+     * @brief Constructor (empty snapshot)
+     */
+    FrozenExclusionData() = default;
+
+    /**
+     * @brief Build a snapshot of a data set (same as data.freeze())
+     * @param data Exclusion data (not referenced after construction)
+     * @throws std::length_error If the text, or the records of a type, need
+     *         offsets or indexes past UINT32_MAX
+     */
+    explicit FrozenExclusionData(const ExclusionData& data);
+
+    /**
+     * @brief Get the text a TextRef refers to
+     * @param ref Text reference from any record
+     * @return View into the blob, valid as long as this object
+     */
+    std::string_view text(TextRef ref) const {
+        return blob_.substr(ref.offset, ref.length);
+    }
+
+    /// @name Binary image
+    /// @{
+
+    /**
+     * @brief Get the serialized snapshot (the contents of an .elb file)
+     * @return View of the image, valid as long as this object or a copy exists
+     */
+    std::string_view getImage() const { return image_; }
+
+    /**
+     * @brief Use a serialized snapshot in place, without copying it
+     *
+     * Checks the magic, byte order, version, record layout and header
+     * checksum, that every section lies inside the image and that scope
+     * ranges lie inside their arrays. With verifyContent, the checksum over
+     * all sections is checked as well (one pass over the image).
+     *
+     * @param storage Owner of the image memory, kept alive by the result
+     * @param image Image bytes (8-byte aligned)
+     * @param result Receives the snapshot on success
+     * @param errorMessage Receives the reason on failure
+     * @param verifyContent Also check the section checksum
+     * @return True on success
+     */
+    static bool fromImage(std::shared_ptr<const void> storage, std::string_view image, FrozenExclusionData& result,
+                          std::string& errorMessage, bool verifyContent = true);
+
+    /**
+     * @brief Compute the checksum .elb images use
+     *
+     * A fast non-cryptographic 64-bit hash (several GB/s); ParseCache also
+     * keys source files by it.
+     *
+     * @param bytes Data to hash
+     * @return 64-bit checksum
+     */
+    static uint64_t checksum(std::string_view bytes);
+
+    /**
+     * @brief Compute the hash the lookup indexes of an image are built with
+     *
+     * The indexes are stored in the image, so the hash is part of the
+     * format: it is derived from checksum(), never from std::hash, and
+     * gives the same value with every compiler and standard library.
+     *
+     * @param key Scope name, block ID or condition ID
+     * @param scope Index + 1 of the owning scope (0 for scope names)
+     * @return 64-bit hash
+     */
+    static uint64_t hashKey(std::string_view key, uint64_t scope = 0);
+
+    /// @}
+
+    /// @name Scopes
+    /// @{
+
+    /**
+     * @brief Find a scope by name
+     * @param scopeName Scope name
+     * @return Scope record, or nullptr if absent
+     */
+    const Scope* findScope(std::string_view scopeName) const;
+
+    /**
+     * @brief Get all scopes, sorted by name
+     */
+    std::span<const Scope> scopes() const { return scopes_; }
+
+    /// @}
+
+    /// @name Exclusions of a scope
+    /// @{
+
+    std::span<const Block> blocks(const Scope& scope) const {
+        return std::span<const Block>(blocks_).subspan(scope.blockBegin, scope.blockEnd - scope.blockBegin);
+    }
+    std::span<const Toggle> toggles(const Scope& scope) const {
+        return std::span<const Toggle>(toggles_).subspan(scope.toggleBegin, scope.toggleEnd - scope.toggleBegin);
+    }
+    std::span<const Fsm> fsms(const Scope& scope) const {
+        return std::span<const Fsm>(fsms_).subspan(scope.fsmBegin, scope.fsmEnd - scope.fsmBegin);
+    }
+    std::span<const Condition> conditions(const Scope& scope) const {
+        return std::span<const Condition>(conditions_).subspan(scope.conditionBegin,
+                                                               scope.conditionEnd - scope.conditionBegin);
+    }
+
+    /**
+     * @brief Find a block exclusion by ID
+     * @return Record, or nullptr if absent
+     */
+    const Block* findBlock(const Scope& scope, std::string_view blockId) const;
+
+    /**
+     * @brief Find a condition exclusion by ID
+     * @return Record, or nullptr if absent
+     */
+    const Condition* findCondition(const Scope& scope, std::string_view conditionId) const;
+
+    /**
+     * @brief Get all toggle records of one signal (sorted by bit, then direction)
+     */
+    std::span<const Toggle> findToggles(const Scope& scope, std::string_view signalName) const;
+
+    /**
+     * @brief Get all FSM records with one FSM name ("transition" for transitions)
+     */
+    std::span<const Fsm> findFsms(const Scope& scope, std::string_view fsmName) const;
+
+    /// @}
+
+    /**
+     * @brief Report the snapshot to a visitor as parse events
+     *
+     * Header fields, then per scope (by name) a checksum and scope event
+     * followed by its blocks, toggles (in the source's stored order, not
+     * bit order), FSMs and conditions. Annotations travel in the record
+     * views only. Feeding an ExclusionDataBuilder
+     * rebuilds the frozen data.
+     *
+     * @param visitor Receiver of the events
+     */
+    void accept(ExclusionVisitor& visitor) const;
+
+    /// @name Statistics
+    /// @{
+
+    size_t getScopeCount() const { return scopes_.size(); }
+
+    size_t getTotalExclusionCount() const {
+        return blocks_.size() + toggles_.size() + fsms_.size() + conditions_.size();
+    }
+
+    /**
+     * @brief Get exclusion counts by type (as ExclusionData::getExclusionCountsByType())
+     */
+    std::unordered_map<ExclusionType, size_t> getExclusionCountsByType() const;
+
+    /**
+     * @brief Get the statistics ExclusionDataManager::getStatistics() reports for the same data
+     */
+    ExclusionStatistics getStatistics() const;
+
+    /**
+     * @brief Get the memory held by the snapshot
+     * @return Bytes of the image (mapped or on the heap)
+     */
+    size_t getMemoryUsage() const { return sizeof(FrozenExclusionData) + image_.size(); }
+
+    /**
+     * @brief Get the size of the text blob
+     * @return Bytes of distinct text
+     */
+    size_t getTextBytes() const { return blob_.size(); }
+
+    /// @}
+};
+
+} // namespace ExclusionParser
+
+#endif // EXCLUSION_FROZEN_DATA_H
@@ -0,0 +1,362 @@
+/**
+ * @file ExclusionLookup.h
+ * @brief Read-optimized "is this coverage item excluded?" point lookups
+ *
+ * Coverage post-processing asks whether an item is excluded for millions of
+ * items: a block, one direction of a toggle bit, an FSM state or transition,
+ * or a condition row, each in a given instance. ExclusionLookup answers such
+ * questions from a flat open-addressing table of 128-bit key hashes built
+ * once from ExclusionData.
+ *
+ * Keys are hashed by the caller (LookupKey), usually once per coverage item,
+ * and the scope part once per instance (ScopeKey), so a lookup is a probe of
+ * one or two cache lines and never builds or compares strings. The table is
+ * immutable after construction; any number of threads may query it at once.
+ *
+ * Most queried items are not excluded. An optional Bloom filter in front of
+ * the table (buildFilter()) answers most misses from a structure small
+ * enough to stay in cache, so they skip the table probe entirely.
+ *
+ * Usage Example:
+ * @code
+ * ExclusionLookup lookup(*parser.getData());
+ * ScopeKey scope = ExclusionLookup::scopeKey("tb.gpu0.chip0.core.udcnc");
+ * if (lookup.contains(ExclusionLookup::toggleKey(scope, "clk_en", 3, ToggleDirection::ZERO_TO_ONE))) {
+ *     // excluded
+ * }
+ * @endcode
+ *
+ * @author AMD Advanced Micro Devices Inc. - Verification Infrastructure Team
+ * @version 2.0.0
+ * @date September 13, 2025
+ * @copyright (c) 2025 Advanced Micro Devices Inc. All rights reserved.
+ */
+
+#ifndef EXCLUSION_LOOKUP_H
+#define EXCLUSION_LOOKUP_H
+
+#include "ExclusionTypes.h"
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace ExclusionParser {
+
+/**
+ * @brief 128-bit hash of a scope name, computed once per instance
+ */
+struct ScopeKey {
+    uint64_t primary = 0;   ///< First hash lane
+    uint64_t check = 0;     ///< Second hash lane
+
+    bool operator==(const ScopeKey& other) const = default;
+};
+
+/**
+ * @brief 128-bit hash identifying one coverage item in one scope
+ *
+ * Two independent 64-bit lanes make an accidental match between different
+ * items practically impossible (about n^2 / 2^129 for n keys).
+ */
+struct LookupKey {
+    uint64_t primary = 0;   ///< Selects the table slot
+    uint64_t check = 0;     ///< Second lane, compared on probe
+
+    bool operator==(const LookupKey& other) const = default;
+};
+
+/**
+ * @brief Blocked Bloom filter over lookup keys
+ *
+ * Each key sets and tests bits within one 64-byte block, so a test touches a
+ * single cache line. No false negatives; the false positive rate is close to
+ * the one requested at construction.
+ */
+class EXCLUSION_API BloomFilter {
+private:
+    /// One cache line of filter bits
+    struct alignas(64) Block {
+        uint64_t words[8] = {};
+    };
+
+    std::vector<Block> blocks_;     ///< Filter bits
+    uint64_t blockMask_;            ///< blocks_.size() - 1 (size is a power of two)
+    uint32_t hashCount_;            ///< Bits set per key
+
+    /**
+     * @brief Bit position of the i-th hash within a block (0-511)
+     */
+    static uint32_t bitPosition(const LookupKey& key, uint32_t i) {
+        // Double hashing; the block comes from check, the bits from primary
+        uint64_t step = (key.primary >> 32) | 1;
+        return static_cast<uint32_t>((key.primary + i * step) & 511);
+    }
+
+public:
+    /**
+     * @brief Constructor (empty filter, which rejects nothing)
+     */
+    BloomFilter() : blockMask_(0), hashCount_(0) {}
+
+    /**
+     * @brief Build a filter over a set of keys
+     * @param keys Keys that must test positive
+     * @param falsePositiveRate Target rate, clamped to [1e-6, 0.5]
+     */
+    BloomFilter(std::span<const LookupKey> keys, double falsePositiveRate);
+
+    /**
+     * @brief Test whether a key may be in the set
+     * @param key Lookup key
+     * @return False if the key is definitely absent
+     */
+    bool mayContain(const LookupKey& key) const {
+        if (hashCount_ == 0) return true;
+        const Block& block = blocks_[key.check & blockMask_];
+        for (uint32_t i = 0; i < hashCount_; ++i) {
+            uint32_t bit = bitPosition(key, i);
+            if ((block.words[bit >> 6] & (1ULL << (bit & 63))) == 0) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Hint the CPU to load the block a key tests
+     */
+    void prefetch(const LookupKey& key) const {
+#if defined(__GNUC__) || defined(__clang__)
+        if (hashCount_ != 0) __builtin_prefetch(&blocks_[key.check & blockMask_]);
+#else
+        (void)key;
+#endif
+    }
+
+    bool empty() const { return hashCount_ == 0; }
+    uint32_t getHashCount() const { return hashCount_; }
+    size_t getMemoryUsage() const { return blocks_.capacity() * sizeof(Block); }
+};
+
+/**
+ * @brief Filter counters and sizes of an ExclusionLookup
+ */
+struct FilterStatistics {
+    bool enabled = false;               ///< True if a filter is built
+    double falsePositiveRate = 0.0;     ///< Rate the filter was built for
+    uint32_t hashCount = 0;             ///< Bits tested per key
+    size_t memoryBytes = 0;             ///< Filter size
+    bool counting = false;              ///< True if queries update the counters below
+    uint64_t filterMisses = 0;          ///< Queries rejected by the filter (no table probe)
+    uint64_t filterHits = 0;            ///< Queries passed to the table
+    uint64_t falsePositives = 0;        ///< Passed queries the table then rejected
+};
+
+/**
+ * @brief Immutable hash set of every excluded coverage item of an ExclusionData
+ *
+ * Item semantics:
+ * - Block: scope and block ID.
+ * - Toggle: scope, signal name, bit index (std::nullopt for scalar signals)
+ *   and direction. A BOTH exclusion covers both directions, and a BOTH query
+ *   hits when both directions are excluded, by one or two exclusions.
+ * - FSM state: scope and FSM name (from "Fsm" lines).
+ * - FSM transition: scope, from-state and to-state (from "Transition" lines).
+ * - Condition: scope, condition ID and coverage row text such as 1 "01";
+ *   an empty row matches any row of the condition.
+ */
+class EXCLUSION_API ExclusionLookup {
+private:
+    /// Relaxed atomic counter that copies as a snapshot, on its own cache line
+    class alignas(64) Counter {
+    private:
+        std::atomic<uint64_t> value_{0};
+    public:
+        Counter() = default;
+        Counter(const Counter& other) : value_(other.load()) {}
+        Counter& operator=(const Counter& other) { value_.store(other.load(), std::memory_order_relaxed); return *this; }
+        void add(uint64_t amount) { value_.fetch_add(amount, std::memory_order_relaxed); }
+        void reset() { value_.store(0, std::memory_order_relaxed); }
+        uint64_t load() const { return value_.load(std::memory_order_relaxed); }
+    };
+
+    std::vector<LookupKey> slots_;  ///< Open-addressing table; an all-zero key marks an empty slot
+    uint64_t mask_;                 ///< slots_.size() - 1 (size is a power of two)
+    size_t size_;                   ///< Number of distinct keys stored
+    BloomFilter filter_;            ///< Optional negative-lookup front end
+    double filterRate_;             ///< Rate filter_ was built for
+    bool countFilter_;              ///< Whether queries update the filter counters
+    mutable Counter filterMisses_;  ///< Queries the filter rejected
+    mutable Counter filterHits_;    ///< Queries the filter passed
+    mutable Counter falsePositives_; ///< Passed queries that missed in the table
+
+    /**
+     * @brief Add a key unless it is already present
+     */
+    void insert(const LookupKey& key);
+
+    /**
+     * @brief Probe the table only
+     */
+    bool probe(const LookupKey& key) const {
+        uint64_t slot = key.primary & mask_;
+        while (true) {
+            const LookupKey& stored = slots_[slot];
+            if (stored == key) return true;
+            if (stored.primary == 0 && stored.check == 0) return false;
+            slot = (slot + 1) & mask_;
+        }
+    }
+
+public:
+    /**
+     * @brief Constructor (empty lookup)
+     */
+    ExclusionLookup();
+
+    /**
+     * @brief Build the lookup from all exclusions of a data set
+     * @param data Exclusion data (not referenced after construction)
+     */
+    explicit ExclusionLookup(const ExclusionData& data);
+
+    /// @name Key construction
+    /// @{
+
+    /**
+     * @brief Hash a scope name
+     * @param scopeName Instance path or module name
+     * @return Scope key to pass to the item key functions
+     */
+    static ScopeKey scopeKey(std::string_view scopeName);
+
+    /**
+     * @brief Key of a block
+     */
+    static LookupKey blockKey(ScopeKey scope, std::string_view blockId);
+    
+    /**
+     * @brief Key of one direction of a toggle bit (bitIndex std::nullopt for scalars)
+     */
+    static LookupKey toggleKey(ScopeKey scope, std::string_view signalName, std::optional<int> bitIndex,
+                               ToggleDirection direction);
+    
+    /**
+     * @brief Key of an FSM state exclusion ("Fsm" line)
+     */
+    static LookupKey fsmStateKey(ScopeKey scope, std::string_view fsmName);
+    
+    /**
+     * @brief Key of an FSM transition ("Transition" line)
+     */
+    static LookupKey fsmTransitionKey(ScopeKey scope, std::string_view fromState, std::string_view toState);
+    
+    /**
+     * @brief Key of a condition row (empty row: any row of the condition)
+     */
+    static LookupKey conditionKey(ScopeKey scope, std::string_view conditionId, std::string_view row = {});
+
+    /// @}
+
+    /**
+     * @brief Check whether one item is excluded
+     * @param key Item key
+     * @return True if excluded
+     */
+    bool contains(const LookupKey& key) const {
+        if (filter_.empty()) {
+            return probe(key);
+        }
+        if (!countFilter_) {
+            return filter_.mayContain(key) && probe(key);
+        }
+        if (!filter_.mayContain(key)) {
+            filterMisses_.add(1);
+            return false;
+        }
+        filterHits_.add(1);
+        bool hit = probe(key);
+        if (!hit) {
+            falsePositives_.add(1);
+        }
+        return hit;
+    }
+
+    /**
+     * @brief Check many items in one call
+     *
+     * Probes are issued in groups with prefetching, which hides most of the
+     * cache misses of a large table. With a filter, only keys it passes are
+     * probed, and the counters (if enabled) are updated once per call rather
+     * than per key.
+     *
+     * @param keys Item keys
+     * @param results Receives true/false per key (same size as keys)
+     * @return Number of excluded items
+     */
+    size_t containsBatch(std::span<const LookupKey> keys, std::span<bool> results) const;
+
+    /**
+     * @brief Get the number of distinct item keys
+     * @return Key count
+     */
+    size_t size() const { return size_; }
+
+    /**
+     * @brief Get the memory held by the table
+     * @return Bytes
+     */
+    size_t getMemoryUsage() const { return slots_.capacity() * sizeof(LookupKey) + filter_.getMemoryUsage(); }
+
+    /// @name Negative-lookup filter
+    /// @{
+
+    /**
+     * @brief Build (or rebuild) the Bloom filter consulted before the table
+     *
+     * Not thread-safe; call before sharing the lookup with other threads.
+     * About 10 bits per key at 1%, 15 bits at 0.1%.
+     *
+     * @param falsePositiveRate Share of absent keys that still reach the
+     *        table, clamped to [1e-6, 0.5]
+     */
+    void buildFilter(double falsePositiveRate = 0.01);
+
+    /**
+     * @brief Drop the filter; queries go straight to the table
+     */
+    void dropFilter();
+
+    /**
+     * @brief Check whether a filter is built
+     */
+    bool hasFilter() const { return !filter_.empty(); }
+
+    /**
+     * @brief Turn the filter counters on or off (off by default)
+     *
+     * Counting costs an atomic add per contains() call, which concurrent
+     * callers contend on; enable it only while measuring the filter.
+     * Not thread-safe; call before sharing the lookup with other threads.
+     *
+     * @param enabled True to count filter misses, hits and false positives
+     */
+    void setFilterCounting(bool enabled);
+
+    /**
+     * @brief Get the filter configuration, size and counters
+     */
+    FilterStatistics getFilterStatistics() const;
+
+    /**
+     * @brief Zero the filter counters
+     */
+    void resetFilterStatistics();
+
+    /// @}
+};
+
+} // namespace ExclusionParser
+
+#endif // EXCLUSION_LOOKUP_H
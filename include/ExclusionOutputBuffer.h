@@ -0,0 +1,123 @@
+/**
+ * @file ExclusionOutputBuffer.h
+ * @brief Growable byte buffer that ExclusionWriter formats .el text into
+ *
+ * This file contains the output layer of ExclusionWriter. Lines are
+ * appended piece by piece straight into one contiguous buffer, without
+ * building per-line std::string temporaries; escaping copies runs of plain
+ * text between quotes in bulk. A buffer with a sink stream hands its
+ * contents to the stream in large writes once they reach the flush
+ * threshold; without a sink it simply grows and its contents are taken
+ * at the end (ExclusionWriter::writeToString).
+ *
+ * @author AMD Advanced Micro Devices Inc. - Verification Infrastructure Team
+ * @version 2.0.0
+ * @date September 13, 2025
+ * @copyright (c) 2025 Advanced Micro Devices Inc. All rights reserved.
+ */
+
+#ifndef EXCLUSION_OUTPUT_BUFFER_H
+#define EXCLUSION_OUTPUT_BUFFER_H
+
+#include "ExclusionTypes.h"
+#include <algorithm>
+#include <charconv>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace ExclusionParser {
+
+/**
+ * @brief Append-only text buffer with optional bulk flushing to a stream
+ *
+ * Usage Example:
+ * @code
+ * OutputBuffer buffer(&stream);
+ * buffer.append("Block ");
+ * buffer.append(blockId);
+ * buffer.append(" \"");
+ * buffer.appendEscaped(sourceCode);
+ * buffer.append("\"\n");
+ * buffer.flushIfFull();
+ * ...
+ * buffer.flush();
+ * @endcode
+ */
+class EXCLUSION_API OutputBuffer {
+public:
+    static constexpr size_t DEFAULT_FLUSH_THRESHOLD = 1024 * 1024;  ///< 1MB writes
+
+    /**
+     * @brief Constructor
+     * @param sink Stream receiving flushed text, or nullptr to only accumulate
+     * @param flushThreshold Size at which flushIfFull() writes to the sink
+     */
+    explicit OutputBuffer(std::ostream* sink = nullptr, size_t flushThreshold = DEFAULT_FLUSH_THRESHOLD)
+        : sink_(sink), flushThreshold_(flushThreshold) {}
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    /**
+     * @brief Reserve space up front
+     *
+     * With a sink, at most one flush threshold (plus a line's worth) is ever
+     * held, so the reservation is capped there.
+     *
+     * @param bytes Expected output size
+     */
+    void reserve(size_t bytes) {
+        buffer_.reserve(sink_ ? std::min(bytes, flushThreshold_ + flushThreshold_ / 4) : bytes);
+    }
+
+    void append(std::string_view text) { buffer_.append(text); }
+    void append(char c) { buffer_.push_back(c); }
+
+    /**
+     * @brief Append a decimal integer without going through a stream or std::to_string
+     * @param value Value to format
+     */
+    template <typename Integer>
+    void appendNumber(Integer value) {
+        char digits[24];
+        auto [end, error] = std::to_chars(digits, digits + sizeof(digits), value);
+        (void)error;
+        buffer_.append(digits, static_cast<size_t>(end - digits));
+    }
+
+    /**
+     * @brief Append text with every double quote escaped as \"
+     * @param text Text to copy
+     */
+    void appendEscaped(std::string_view text);
+
+    /**
+     * @brief Write the contents to the sink if they reached the flush threshold
+     */
+    void flushIfFull() {
+        if (sink_ && buffer_.size() >= flushThreshold_) {
+            flush();
+        }
+    }
+
+    /**
+     * @brief Write all contents to the sink (no-op without one)
+     * @return False if the sink reported an error
+     */
+    bool flush();
+
+    size_t size() const { return buffer_.size(); }         ///< Bytes currently held
+    std::string_view view() const { return buffer_; }       ///< Bytes currently held
+    std::string take() { return std::move(buffer_); }       ///< Move the contents out
+    void clear() { buffer_.clear(); }                       ///< Drop the contents, keeping capacity
+
+private:
+    std::string buffer_;            ///< Pending text
+    std::ostream* sink_;            ///< Destination of flushed text (may be nullptr)
+    size_t flushThreshold_;         ///< flushIfFull() trigger size
+};
+
+} // namespace ExclusionParser
+
+#endif // EXCLUSION_OUTPUT_BUFFER_H
@@ -0,0 +1,129 @@
+/**
+ * @file ExclusionParseCache.h
+ * @brief On-disk cache of parsed exclusion files, keyed by content hash
+ *
+ * Farm jobs parse the same .el files in every run. With
+ * ParserConfig::cacheDirectory set, ExclusionParser keeps one entry per
+ * distinct file content (and parse options) in that directory. An entry holds
+ * the parse result's counters and warnings, followed by the .elb image of the
+ * parsed data (FrozenExclusionData). A later parse of the same content maps
+ * the entry and replays it into ExclusionData instead of tokenizing the text.
+ *
+ * Entries are found by content, not by path: a copied or touched file still
+ * hits, and an edited file misses even if its size and mtime are restored.
+ * The entry records the source size and hash, and is validated against both
+ * and its own checksums before use; anything that does not match is a miss.
+ * Entries are written to a temporary file and renamed into place, so
+ * concurrent jobs sharing a directory never see a partial entry. Each hit
+ * refreshes the entry's mtime, and evict() removes the least recently used
+ * entries beyond the configured total size.
+ *
+ * @author AMD Advanced Micro Devices Inc. - Verification Infrastructure Team
+ * @version 2.0.0
+ * @date September 13, 2025
+ * @copyright (c) 2025 Advanced Micro Devices Inc. All rights reserved.
+ */
+
+#ifndef EXCLUSION_PARSE_CACHE_H
+#define EXCLUSION_PARSE_CACHE_H
+
+#include "ExclusionParser.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace ExclusionParser {
+
+class FrozenExclusionData;
+
+/**
+ * @brief Directory of cached parse results
+ *
+ * Usage Example:
+ * @code
+ * ParseCache cache("/tmp/el_cache", 512 * 1024 * 1024);
+ * ParseCache::Key key = ParseCache::makeKey(contents, parser.getConfig());
+ * FrozenExclusionData frozen;
+ * ParseResult result;
+ * if (!cache.load(key, frozen, result)) {
+ *     // parse, then cache.store(key, data.freeze(), result, error) and cache.evict()
+ * }
+ * @endcode
+ */
+class EXCLUSION_API ParseCache {
+public:
+    /**
+     * @brief Identity of one parse: the source content and the options that shape its result
+     */
+    struct Key {
+        uint64_t contentHash = 0;   ///< FrozenExclusionData::checksum() of the file contents
+        uint64_t contentSize = 0;   ///< File size in bytes
+        uint64_t optionsHash = 0;   ///< Parser options that change the data or warnings
+    };
+
+    /**
+     * @brief Constructor
+     * @param directory Cache directory (created on first store)
+     * @param maxBytes Total entry size evict() trims the directory to
+     */
+    ParseCache(const std::string& directory, size_t maxBytes);
+
+    /**
+     * @brief Compute the key of a parse
+     * @param content Complete file contents
+     * @param config Parser configuration the file is parsed with
+     * @return Cache key
+     */
+    static Key makeKey(std::string_view content, const ParserConfig& config);
+
+    /**
+     * @brief Load the entry of a key
+     *
+     * The entry is mapped; frozen keeps the mapping alive. On a hit the
+     * entry's mtime is refreshed for eviction.
+     *
+     * @param key Cache key
+     * @param frozen Receives the cached data
+     * @param result Receives the cached counters and warnings (success set)
+     * @return True on a hit; false if there is no valid entry
+     */
+    bool load(const Key& key, FrozenExclusionData& frozen, ParseResult& result) const;
+
+    /**
+     * @brief Write the entry of a key, replacing any existing one atomically
+     * @param key Cache key
+     * @param frozen Parsed data of the file
+     * @param result Parse result of the file (counters and warnings are kept)
+     * @param errorMessage Receives the reason on failure
+     * @return True if the entry was written
+     */
+    bool store(const Key& key, const FrozenExclusionData& frozen, const ParseResult& result,
+               std::string& errorMessage) const;
+
+    /**
+     * @brief Remove least recently used entries until the total size is at most maxBytes
+     *
+     * Left to the caller so a batch of stores scans the directory once.
+     *
+     * @return Number of entries removed
+     */
+    size_t evict() const;
+
+    /**
+     * @brief Get the path of a key's entry
+     * @param key Cache key
+     * @return Entry path (which may not exist)
+     */
+    std::string getEntryPath(const Key& key) const;
+
+    const std::string& getDirectory() const { return directory_; }
+    size_t getMaxBytes() const { return maxBytes_; }
+
+private:
+    std::string directory_;     ///< Cache directory
+    size_t maxBytes_;           ///< Eviction threshold for the total entry size
+};
+
+} // namespace ExclusionParser
+
+#endif // EXCLUSION_PARSE_CACHE_H
@@ -37,9 +37,11 @@
 
 #include "ExclusionTypes.h"
 #include "ExclusionData.h"
+#include "ExclusionVisitor.h"
 #include <fstream>
 #include <sstream>
 #include <memory>
+#include <string_view>
 
 namespace ExclusionParser {
 
@@ -53,14 +55,34 @@ struct EXCLUSION_API ParserConfig {
     bool validateChecksums;     ///< If true, validate checksum format
     bool preserveComments;      ///< If true, preserve comment lines
     bool mergeOnLoad;          ///< If true, merge with existing data when loading
-    size_t maxFileSize;        ///< Maximum file size to parse (in bytes)
+    size_t maxFileSize;        ///< Maximum file size to read onto the heap (in bytes); memory-mapped files are not limited
+    bool useMemoryMap;         ///< If true, parseFile maps the file instead of reading it into memory
+    size_t threadCount;        ///< Worker threads for parseFiles/split files (1 = serial, 0 = hardware concurrency)
+    bool splitLargeFiles;      ///< If true, parse large files as independently parsed chunks
+    size_t splitChunkSize;     ///< Minimum chunk size in bytes when splitLargeFiles is set
+    bool columnarToggles;      ///< If true, toggles are stored in ExclusionScope::toggleTable (1to0/0to1 pairs folded)
+    std::string cacheDirectory; ///< If not empty, parseFile/parseFiles reuse cached parses kept here (see ParseCache)
+    size_t cacheMaxBytes;      ///< Total size of cache entries kept; least recently used entries beyond it are evicted
     
     /**
      * @brief Default constructor with sensible defaults
      */
     ParserConfig() 
         : strictMode(false), validateChecksums(true), preserveComments(true),
-          mergeOnLoad(false), maxFileSize(100 * 1024 * 1024) {} // 100MB default
+          mergeOnLoad(false), maxFileSize(100 * 1024 * 1024), // 100MB default
+          useMemoryMap(true), threadCount(1), splitLargeFiles(false),
+          splitChunkSize(128 * 1024), columnarToggles(false),
+          cacheMaxBytes(1024 * 1024 * 1024) {} // 1GB cache default
+};
+
+/**
+ * @brief How the parser obtained its input
+ */
+enum class InputMode {
+    STRING,             ///< In-memory string passed to parseString
+    STREAM,             ///< std::istream passed to parseStream
+    BUFFERED,           ///< File read into a heap buffer
+    MEMORY_MAPPED       ///< File parsed directly from mapped pages
 };
 
 /**
@@ -73,15 +95,22 @@ struct EXCLUSION_API ParseResult {
     std::string errorMessage;               ///< Error message if parsing failed
     size_t linesProcessed;                  ///< Number of lines processed
     size_t exclusionsParsed;                ///< Number of exclusions parsed
+    InputMode inputMode;                    ///< I/O path used to read the input
+    size_t cacheHits;                       ///< Files loaded from ParserConfig::cacheDirectory
+    size_t cacheMisses;                     ///< Files parsed with the cache enabled
     std::vector<std::string> warnings;     ///< Non-fatal warnings
     
+    /// Warnings per source file, in input order (parseFiles only)
+    std::vector<std::pair<std::string, std::vector<std::string>>> fileWarnings;
+    
     /// Counts by exclusion type
     std::unordered_map<ExclusionType, size_t> exclusionCounts;
     
     /**
      * @brief Constructor
      */
-    ParseResult() : success(false), linesProcessed(0), exclusionsParsed(0) {}
+    ParseResult() : success(false), linesProcessed(0), exclusionsParsed(0), inputMode(InputMode::STRING),
+                    cacheHits(0), cacheMisses(0) {}
     
     /**
      * @brief Check if parsing was successful
@@ -96,6 +125,10 @@ struct EXCLUSION_API ParseResult {
     std::string getSummary() const;
 };
 
+namespace FileUtils {
+    class MappedFile;
+}
+
 /**
  * @brief Main parser class for exclusion coverage files
  * 
@@ -136,110 +169,170 @@ private:
     std::string currentChecksum_;           ///< Current scope checksum
     bool currentIsModule_;                  ///< Whether current scope is module
     std::string pendingAnnotation_;         ///< Pending annotation for next exclusion
+    std::string runAnnotation_;             ///< Annotation of the open ANNOTATION_BEGIN run, if any
     size_t currentLineNumber_;              ///< Current line being parsed
+    ExclusionVisitor* visitor_;             ///< Receiver of events for the parse in progress
     
-    // Helper methods for parsing different sections
+    // Handlers for the line kinds identified by Tokenizer::classifyLine.
+    // Each is called only for lines of its own kind and reports what it
+    // finds to visitor_.
     /**
-     * @brief Parse file header information
-     * @param line Current line
-     * @return True if line was a header line
+     * @brief Parse file header information from a comment line
+     * @param line Current line (a "//" comment)
+     * @return True if the comment carried a header field
      */
-    bool parseHeader(const std::string& line);
+    bool parseHeader(std::string_view line);
     
     /**
      * @brief Parse CHECKSUM line
      * @param line Current line
      * @return True if successfully parsed
      */
-    bool parseChecksum(const std::string& line);
+    bool parseChecksum(std::string_view line);
     
     /**
      * @brief Parse INSTANCE or MODULE line
      * @param line Current line
+     * @param isModule True for MODULE, false for INSTANCE
      * @return True if successfully parsed
      */
-    bool parseScope(const std::string& line);
+    bool parseScope(std::string_view line, bool isModule);
     
     /**
-     * @brief Parse ANNOTATION line
+     * @brief Parse ANNOTATION or ANNOTATION_BEGIN line
+     * 
+     * ANNOTATION applies to the next exclusion. ANNOTATION_BEGIN applies to
+     * every exclusion up to ANNOTATION_END, unless one has its own ANNOTATION.
+     * 
      * @param line Current line
+     * @param beginsRun True for ANNOTATION_BEGIN
      * @return True if successfully parsed
      */
-    bool parseAnnotation(const std::string& line);
+    bool parseAnnotation(std::string_view line, bool beginsRun = false);
     
     /**
      * @brief Parse Block exclusion line
      * @param line Current line
      * @return True if successfully parsed
      */
-    bool parseBlockExclusion(const std::string& line);
+    bool parseBlockExclusion(std::string_view line);
     
     /**
      * @brief Parse Toggle exclusion line
      * @param line Current line
      * @return True if successfully parsed
      */
-    bool parseToggleExclusion(const std::string& line);
+    bool parseToggleExclusion(std::string_view line);
     
     /**
      * @brief Parse FSM exclusion line
      * @param line Current line
      * @return True if successfully parsed
      */
-    bool parseFsmExclusion(const std::string& line);
+    bool parseFsmExclusion(std::string_view line);
     
     /**
      * @brief Parse Condition exclusion line
      * @param line Current line
      * @return True if successfully parsed
      */
-    bool parseConditionExclusion(const std::string& line);
+    bool parseConditionExclusion(std::string_view line);
     
     /**
      * @brief Parse Transition line (FSM transition)
      * @param line Current line
      * @return True if successfully parsed
      */
-    bool parseTransition(const std::string& line);
+    bool parseTransition(std::string_view line);
+    
+    /**
+     * @brief Get the scope in effect, as reported to the visitor
+     * @return View of the current scope state
+     */
+    ScopeView currentScopeView() const;
+    
+    /**
+     * @brief Get the annotation for the next exclusion
+     * @return Pending ANNOTATION, else the open run's annotation
+     */
+    std::string_view currentAnnotation() const {
+        return pendingAnnotation_.empty() ? std::string_view(runAnnotation_) : std::string_view(pendingAnnotation_);
+    }
     
     /**
-     * @brief Extract quoted string from line
-     * @param line Line to parse
-     * @param startPos Starting position
-     * @return Extracted string and new position
+     * @brief Validate checksum format
+     * @param checksum Checksum string to validate
+     * @return True if valid format
      */
-    std::pair<std::string, size_t> extractQuotedString(const std::string& line, 
-                                                       size_t startPos) const;
+    bool validateChecksum(std::string_view checksum) const;
+    
+    /// A file opened by parseFile/parseFiles, together with its open error if any
+    struct LoadedInput;
     
     /**
-     * @brief Extract word from line
-     * @param line Line to parse
-     * @param startPos Starting position
-     * @return Extracted word and new position
+     * @brief Open a file for parsing, mapping it when allowed
+     * 
+     * maxFileSize is only enforced when the file has to be read onto the heap.
+     * 
+     * @param filename Path to the file
+     * @param file Receives the opened file
+     * @param errorMessage Receives the reason on failure
+     * @return True if the file contents are available
      */
-    std::pair<std::string, size_t> extractWord(const std::string& line, 
-                                               size_t startPos) const;
+    bool openInput(const std::string& filename, FileUtils::MappedFile& file, 
+                   std::string& errorMessage) const;
     
     /**
-     * @brief Trim whitespace from string
-     * @param str String to trim
-     * @return Trimmed string
+     * @brief Parse one independent chunk of a file into this parser's fresh data
+     * 
+     * The caller seeds currentScope_, currentChecksum_ and currentIsModule_
+     * with the state in effect at the chunk's first line.
+     * 
+     * @param text Chunk contents, starting at a safe split point (or the file start)
+     * @param firstLine 1-based line number of the chunk's first line in the file
+     * @param sourceIdentifier Identifier for the source (for error messages)
+     * @param inputMode I/O path that produced the buffer (reported in the result)
+     * @return Parse result for the chunk
      */
-    std::string trim(const std::string& str) const;
+    ParseResult parseChunk(std::string_view text, size_t firstLine, 
+                           const std::string& sourceIdentifier, InputMode inputMode);
     
     /**
-     * @brief Check if line is a comment
-     * @param line Line to check
-     * @return True if line is a comment
+     * @brief Parse opened inputs and append them to data_ in input order
+     * 
+     * Each input is parsed whole, or split into chunks when splitLargeFiles is
+     * set. The pieces run serially or on a ThreadPool according to threadCount
+     * (largest first) and are always appended in file and chunk order.
+     * 
+     * @param inputs Opened inputs
+     * @param continueOnError If false, stop at the first input that fails
+     * @return Combined parse result
      */
-    bool isComment(const std::string& line) const;
+    ParseResult parseInputs(std::vector<LoadedInput>& inputs, bool continueOnError);
     
     /**
-     * @brief Validate checksum format
-     * @param checksum Checksum string to validate
-     * @return True if valid format
+     * @brief Parse exclusion data held in a contiguous buffer
+     *
+     * This is the common zero-copy path behind parseFile, parseString and
+     * parseStream. Lines and fields are tokenized as views into the buffer
+     * and reported to the visitor.
+     *
+     * @param buffer Complete file contents
+     * @param sourceIdentifier Identifier for the source (for error messages)
+     * @param inputMode I/O path that produced the buffer (reported in the result)
+     * @param visitor Receiver of parse events
+     * @return Parse result with success/failure and statistics
+     */
+    ParseResult parseBuffer(std::string_view buffer, const std::string& sourceIdentifier,
+                            InputMode inputMode, ExclusionVisitor& visitor);
+    
+    /**
+     * @brief Classify one line and hand it to its handler
+     * @param rawLine Line without its newline
+     * @param result Result to update with counts and warnings
+     * @return False if the line ends the parse (unrecognized line in strictMode)
      */
-    bool validateChecksum(const std::string& checksum) const;
+    bool parseLine(std::string_view rawLine, ParseResult& result);
     
     /**
      * @brief Reset parser state for new file
@@ -284,6 +377,25 @@ public:
     
     /**
      * @brief Parse a single exclusion file
+     * 
+     * When ParserConfig::useMemoryMap is set the file is parsed straight from
+     * mapped pages and maxFileSize does not apply. Otherwise (or if mapping
+     * fails) the file is read into a heap buffer, subject to maxFileSize.
+     * The path taken is reported in ParseResult::inputMode.
+     * 
+     * With ParserConfig::splitLargeFiles set, a file larger than twice
+     * splitChunkSize is cut at line boundaries where no annotation is
+     * pending. Each chunk starts from the scope and checksum in effect at its
+     * first line, is parsed independently (on threadCount workers), and the
+     * chunks are appended in order, which yields the same data as a single
+     * serial parse.
+     * 
+     * With ParserConfig::cacheDirectory set, a file whose contents were
+     * parsed before (with the same strictMode and validateChecksums) is
+     * loaded from its cache entry instead, with the same data, counters and
+     * warnings; otherwise it is parsed and an entry is written.
+     * ParseResult::cacheHits and cacheMisses report which happened.
+     * 
      * @param filename Path to the file to parse
      * @return Parse result with success/failure and statistics
      */
@@ -308,7 +420,74 @@ public:
                            const std::string& sourceIdentifier = "stream");
     
     /**
-     * @brief Parse multiple exclusion files
+     * @brief Parse a single exclusion file, reporting records to a visitor
+     * 
+     * No ExclusionData is built and the parser's data is left untouched.
+     * The file is mapped or read exactly as in parseFile(filename);
+     * splitLargeFiles does not apply since events are delivered in file order.
+     * 
+     * @param filename Path to the file to parse
+     * @param visitor Receiver of parse events
+     * @return Parse result with success/failure and statistics
+     */
+    ParseResult parseFile(const std::string& filename, ExclusionVisitor& visitor);
+    
+    /**
+     * @brief Load an .elb binary cache written by ExclusionWriter::writeBinaryFile()
+     * 
+     * The file is mapped (ParserConfig::useMemoryMap) or read into one heap
+     * buffer, and the snapshot uses it in place: no record is decoded. The
+     * header checksum, format version and section bounds are always checked,
+     * and the content checksum too unless verifyContent is false. The
+     * parser's data is left untouched.
+     * 
+     * @param filename Path to the .elb file
+     * @param frozen Receives the snapshot on success
+     * @param verifyContent Also check the checksum over the whole file
+     * @return Parse result; exclusionsParsed and exclusionCounts describe the snapshot
+     */
+    ParseResult loadBinaryFile(const std::string& filename, FrozenExclusionData& frozen,
+                               bool verifyContent = true) const;
+    
+    /**
+     * @brief Parse exclusion data from a string, reporting records to a visitor
+     * @param content String content to parse
+     * @param visitor Receiver of parse events
+     * @param sourceIdentifier Identifier for the source (for error messages)
+     * @return Parse result with success/failure and statistics
+     */
+    ParseResult parseString(const std::string& content, ExclusionVisitor& visitor,
+                           const std::string& sourceIdentifier = "string");
+    
+    /**
+     * @brief Parse an input stream line by line, reporting records to a visitor
+     * 
+     * Only the current line is held in memory, so arbitrarily large streams
+     * are processed in constant space.
+     * 
+     * @param stream Input stream to read from
+     * @param visitor Receiver of parse events
+     * @param sourceIdentifier Identifier for the source (for error messages)
+     * @return Parse result with success/failure and statistics
+     */
+    ParseResult parseStream(std::istream& stream, ExclusionVisitor& visitor,
+                           const std::string& sourceIdentifier = "stream");
+    
+    /**
+     * @brief Parse multiple exclusion files into one combined data set
+     * 
+     * Each file is parsed into a private ExclusionData which is then appended
+     * (ExclusionData::append) in input order, so the combined data is the same
+     * as parsing the files one after another. With ParserConfig::threadCount
+     * other than 1 the files are parsed concurrently on a bounded thread pool,
+     * largest file first; the merge still happens in input order, so the
+     * result is identical to the serial path. With splitLargeFiles set, large
+     * files are additionally split into chunks that are scheduled the same way.
+     * 
+     * With ParserConfig::cacheDirectory set, each file is looked up in the
+     * cache first (see parseFile(filename)); cached files are replayed on the
+     * same workers and new entries are written as the results are merged.
+     * 
      * @param filenames Vector of file paths to parse
      * @param continueOnError If true, continue parsing other files if one fails
      * @return Combined parse result for all files
@@ -418,6 +597,83 @@ namespace FileUtils {
      */
     EXCLUSION_API std::string readFile(const std::string& filename);
     
+    /**
+     * @brief Read-only view of a whole file
+     * 
+     * On POSIX systems the file is memory-mapped so its contents can be parsed
+     * without a heap copy. If mapping is disabled or fails (or on platforms
+     * without mmap) the file is read into an internal buffer instead. Either
+     * way view() exposes the complete contents until the object is closed.
+     */
+    class EXCLUSION_API MappedFile {
+    public:
+        /**
+         * @brief Default constructor (no file open)
+         */
+        MappedFile();
+        
+        /**
+         * @brief Open a file on construction
+         * @param filename Path to file
+         * @param allowMapping If false, always use the buffered fallback
+         */
+        explicit MappedFile(const std::string& filename, bool allowMapping = true);
+        
+        /**
+         * @brief Destructor, unmaps or releases the file contents
+         */
+        ~MappedFile();
+        
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        
+        /**
+         * @brief Open a file, closing any file currently held
+         * @param filename Path to file
+         * @param allowMapping If false, always use the buffered fallback
+         * @return True if the file contents are available
+         */
+        bool open(const std::string& filename, bool allowMapping = true);
+        
+        /**
+         * @brief Release the file contents
+         */
+        void close();
+        
+        /**
+         * @brief Check whether a file is open
+         * @return True if view() is valid
+         */
+        bool isOpen() const { return open_; }
+        
+        /**
+         * @brief Check whether the contents are memory-mapped
+         * @return True if mapped, false if buffered (or not open)
+         */
+        bool isMapped() const { return mapped_; }
+        
+        /**
+         * @brief Get the file contents
+         * @return View of the whole file (valid until close or destruction)
+         */
+        std::string_view view() const { return std::string_view(data_, size_); }
+        
+        /**
+         * @brief Get the file size
+         * @return Size in bytes
+         */
+        size_t size() const { return size_; }
+        
+    private:
+        const char* data_;      ///< Start of the contents (mapping or buffer_)
+        size_t size_;           ///< Size of the contents in bytes
+        bool mapped_;           ///< True if data_ points at a mapping
+        bool open_;             ///< True if a file is held
+        std::string buffer_;    ///< Backing storage for the buffered fallback
+    };
+    
     /**
      * @brief Get file extension
      * @param filename Path to file
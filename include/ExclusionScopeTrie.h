@@ -0,0 +1,201 @@
+/**
+ * @file ExclusionScopeTrie.h
+ * @brief Path-segment trie over hierarchical scope names
+ *
+ * Instance scope names are dotted hierarchical paths such as
+ * "tb.gpu0.chip0.core.udcnc.udpcsc.dcio". ScopeTrie files every scope name
+ * under its path segments, so "all scopes under a path" and segment-glob
+ * queries only visit the part of the hierarchy they return, instead of
+ * testing every scope in the data. Module scopes (plain names without dots)
+ * are single-segment paths.
+ *
+ * ExclusionData owns a ScopeTrie and keeps it updated as scopes are added
+ * through getOrCreateScope(), merge() and append(), and erased through
+ * eraseScope(). The trie does not copy the names: it points at the keys of
+ * ExclusionData::scopes, whose nodes never move.
+ *
+ * @author AMD Advanced Micro Devices Inc. - Verification Infrastructure Team
+ * @version 2.0.0
+ * @date September 13, 2025
+ * @copyright (c) 2025 Advanced Micro Devices Inc. All rights reserved.
+ */
+
+#ifndef EXCLUSION_SCOPE_TRIE_H
+#define EXCLUSION_SCOPE_TRIE_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Export/Import macros for DLL support
+#ifndef EXCLUSION_API
+    #ifdef _WIN32
+        #ifdef EXCLUSION_PARSER_EXPORTS
+            #define EXCLUSION_API __declspec(dllexport)
+        #else
+            #define EXCLUSION_API __declspec(dllimport)
+        #endif
+    #else
+        #define EXCLUSION_API
+    #endif
+#endif
+
+namespace ExclusionParser {
+
+/**
+ * @brief Index of scope names by their dot-separated path segments
+ *
+ * Queries:
+ * - findUnder("tb.gpu0.chip0") returns the scope "tb.gpu0.chip0" itself (if
+ *   present) and every scope whose name continues with ".<segment>...".
+ * - findMatching("tb.*.chip?.**.dcio") matches segment by segment: '*' and
+ *   '?' match within one segment, and a segment of exactly "**" matches any
+ *   number of segments, including none.
+ *
+ * Both walk only the trie nodes on the way to their results.
+ *
+ * The trie stores a pointer to each inserted name rather than a copy, so a
+ * name must stay alive and unchanged until it is erased or the trie is
+ * cleared. Copies of a trie point at the same names.
+ */
+class EXCLUSION_API ScopeTrie {
+public:
+    /**
+     * @brief Constructor (empty trie)
+     */
+    ScopeTrie();
+
+    /**
+     * @brief Add a scope name
+     * @param scopeName Dotted scope path (referenced, not copied)
+     * @return True if the name was not indexed before
+     */
+    bool insert(const std::string& scopeName);
+    bool insert(std::string&& scopeName) = delete;  ///< A temporary would leave a dangling name
+
+    /**
+     * @brief Remove a scope name
+     *
+     * Path nodes that no longer lead to any scope are unlinked, so later
+     * subtree queries do not walk them.
+     *
+     * @param scopeName Dotted scope path
+     * @return True if the name was indexed
+     */
+    bool erase(std::string_view scopeName);
+
+    /**
+     * @brief Check whether a scope name is indexed
+     * @param scopeName Dotted scope path
+     * @return True if present
+     */
+    bool contains(std::string_view scopeName) const;
+
+    /**
+     * @brief Remove all scope names
+     */
+    void clear();
+
+    /**
+     * @brief Get the number of indexed scope names
+     * @return Scope count
+     */
+    size_t size() const { return size_; }
+
+    /**
+     * @brief Check whether the trie holds no scope names
+     * @return True if empty
+     */
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * @brief Get all scopes at or below a hierarchical path
+     * @param path Dotted path; an empty path returns every scope
+     * @return Matching scope names, parents before their children
+     */
+    std::vector<std::string> findUnder(std::string_view path) const;
+
+    /**
+     * @brief Visit all scopes at or below a hierarchical path
+     * @param path Dotted path; an empty path visits every scope
+     * @param func Called with each matching scope name
+     */
+    void forEachUnder(std::string_view path,
+                      const std::function<void(const std::string&)>& func) const;
+
+    /**
+     * @brief Visit all scopes whose name starts with a string
+     * 
+     * Unlike forEachUnder(), the prefix need not end at a segment boundary:
+     * "tb.gpu0.ch" visits the scopes under "tb.gpu0.chip0", "tb.gpu0.chip1"
+     * and so on, but none below other children of "tb.gpu0".
+     * 
+     * @param prefix Leading text of the scope names; empty visits every scope
+     * @param func Called with each matching scope name
+     */
+    void forEachWithPrefix(std::string_view prefix,
+                           const std::function<void(const std::string&)>& func) const;
+
+    /**
+     * @brief Get all scopes matching a segment glob
+     * @param pattern Dotted pattern; see the class description for the syntax
+     * @return Matching scope names
+     */
+    std::vector<std::string> findMatching(std::string_view pattern) const;
+
+private:
+    /// Hash that lets the child maps be searched with a string_view segment
+    struct SegmentHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view segment) const {
+            return std::hash<std::string_view>{}(segment);
+        }
+    };
+
+    /// Child node index by path segment
+    using ChildMap = std::unordered_map<std::string, uint32_t, SegmentHash, std::equal_to<>>;
+
+    /// One path segment; nodes live in nodes_ and refer to each other by index
+    struct Node {
+        ChildMap children;                                      ///< Child index by segment
+        const std::string* scopeName = nullptr;                 ///< Indexed name, if a scope ends here
+    };
+
+    std::vector<Node> nodes_;           ///< Node storage; nodes_[0] is the root
+    std::vector<uint32_t> freeNodes_;   ///< Unlinked node slots available for reuse
+    size_t size_ = 0;                   ///< Number of nodes with a scopeName
+
+    /**
+     * @brief Find the node for a dotted path
+     * @param path Dotted path; empty selects the root
+     * @return Node index, or -1 if the path is not in the trie
+     */
+    int64_t findNode(std::string_view path) const;
+
+    /**
+     * @brief Get or add a child node
+     * @param parent Parent node index
+     * @param segment Path segment
+     * @return Child node index
+     */
+    uint32_t addChild(uint32_t parent, std::string_view segment);
+
+    /**
+     * @brief Visit every scope in a subtree, parents first
+     */
+    void collect(uint32_t node, const std::function<void(const std::string&)>& func) const;
+
+    /**
+     * @brief Match the pattern segments from index segment on, below a node
+     */
+    void match(uint32_t node, const std::vector<std::string_view>& segments, size_t segment,
+               std::vector<std::string>& results, std::unordered_set<uint64_t>* visited) const;
+};
+
+} // namespace ExclusionParser
+
+#endif // EXCLUSION_SCOPE_TRIE_H
@@ -0,0 +1,166 @@
+/**
+ * @file ExclusionStreamWriter.h
+ * @brief Incremental .el writer for generators that produce exclusions one by one
+ *
+ * ExclusionWriter formats a complete ExclusionData. Generators that scan a
+ * netlist produce millions of exclusions and would have to hold all of them
+ * before writing. ExclusionStreamWriter instead formats each record as it is
+ * added, into an OutputBuffer that goes to the file in large writes. Memory
+ * use stays constant no matter how many records are written: one flush
+ * threshold of text plus the single record held back for annotation
+ * collapsing.
+ *
+ * Consecutive records with the same annotation are written as one
+ * ANNOTATION_BEGIN/ANNOTATION_END run instead of repeating an ANNOTATION line
+ * before each record. A record whose annotation differs from both of its
+ * neighbours keeps the single-line ANNOTATION form.
+ *
+ * Records are written in the order they are added; sortExclusions and
+ * generateChecksums do not apply, since neither can be done without the
+ * whole scope. The other WriterConfig options are honoured.
+ *
+ * @author AMD Advanced Micro Devices Inc. - Verification Infrastructure Team
+ * @version 2.0.0
+ * @date September 13, 2025
+ * @copyright (c) 2025 Advanced Micro Devices Inc. All rights reserved.
+ */
+
+#ifndef EXCLUSION_STREAM_WRITER_H
+#define EXCLUSION_STREAM_WRITER_H
+
+#include "ExclusionWriter.h"
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace ExclusionParser {
+
+/**
+ * @brief Writes .el text record by record with bounded memory
+ *
+ * Usage Example:
+ * @code
+ * ExclusionStreamWriter stream;
+ * if (!stream.open("toggles.el")) { ... }
+ * stream.writeHeader("netlist_scan");
+ * stream.beginScope("tb.dut.core", "1234567890", false);
+ * for (const auto& toggle : scan) {
+ *     stream.add(toggle);
+ * }
+ * auto result = stream.close();
+ * @endcode
+ */
+class EXCLUSION_API ExclusionStreamWriter {
+public:
+    /**
+     * @brief Constructor
+     * @param config Writer configuration (sortExclusions and generateChecksums are ignored)
+     */
+    explicit ExclusionStreamWriter(const WriterConfig& config = WriterConfig());
+
+    /**
+     * @brief Destructor (closes the writer if still open)
+     */
+    ~ExclusionStreamWriter();
+
+    ExclusionStreamWriter(const ExclusionStreamWriter&) = delete;
+    ExclusionStreamWriter& operator=(const ExclusionStreamWriter&) = delete;
+
+    /**
+     * @brief Start writing to a file
+     * @param filename Output file path
+     * @return True if the file was created
+     */
+    bool open(const std::string& filename);
+
+    /**
+     * @brief Start writing to a caller-owned stream
+     * @param stream Output stream (must outlive the writer or the close() call)
+     * @return True if the stream is usable
+     */
+    bool open(std::ostream& stream);
+
+    /**
+     * @brief Check whether the writer is open
+     * @return True between open() and close()
+     */
+    bool isOpen() const { return buffer_ != nullptr; }
+
+    /**
+     * @brief Write the file header comment (if includeComments is set)
+     * @param generatedBy Generator name (default: ExclusionCoverageParser)
+     * @param generationDate Date string (default: now)
+     * @param exclusionMode Exclusion mode (default: default)
+     */
+    void writeHeader(const std::string& generatedBy = "", const std::string& generationDate = "",
+                     const std::string& exclusionMode = "");
+
+    /**
+     * @brief Start a new scope; following records belong to it
+     * @param name Scope name
+     * @param checksum Scope checksum (no CHECKSUM line if empty)
+     * @param isModule True for MODULE:, false for INSTANCE:
+     */
+    void beginScope(const std::string& name, const std::string& checksum = "", bool isModule = false);
+
+    /**
+     * @brief Write one exclusion of the current scope
+     *
+     * The record's annotation field is written (or collapsed into a run)
+     * along with it. Records added before the first beginScope() are
+     * skipped with a warning.
+     *
+     * @param block Block exclusion
+     */
+    void add(const BlockExclusion& block);
+    void add(const ToggleExclusion& toggle);    ///< @copydoc add(const BlockExclusion&)
+    void add(const FsmExclusion& fsm);          ///< @copydoc add(const BlockExclusion&)
+    void add(const ConditionExclusion& condition); ///< @copydoc add(const BlockExclusion&)
+
+    /**
+     * @brief Finish writing: close any annotation run, flush and close the file
+     * @return Write result with statistics (success is false if any write failed)
+     */
+    WriteResult close();
+
+private:
+    ExclusionWriter writer_;        ///< Line formatters and configuration
+    std::ofstream file_;            ///< Output file (when opened by name)
+    std::ostream* sink_;            ///< Current output stream
+    std::unique_ptr<OutputBuffer> buffer_;  ///< Text on its way to sink_ (nullptr when closed)
+    WriteResult result_;            ///< Statistics of the current output
+    bool inScope_;                  ///< Whether beginScope() has been called
+    size_t skippedRecords_;         ///< Records added outside of a scope
+
+    // Annotation collapsing state
+    OutputBuffer heldLine_;         ///< Last annotated record, not yet written
+    std::string heldAnnotation_;    ///< Annotation of heldLine_ (empty if nothing is held)
+    std::string runAnnotation_;     ///< Annotation of the open ANNOTATION_BEGIN run (empty if none)
+
+    /**
+     * @brief Count and write one record, collapsing its annotation with its neighbours'
+     * @param type Exclusion type (for statistics)
+     * @param annotation Record annotation
+     * @param formatLine Writes the record's line into the buffer it is given
+     */
+    template <typename FormatLine>
+    void addRecord(ExclusionType type, std::string_view annotation, FormatLine&& formatLine);
+
+    /**
+     * @brief End the open annotation run or write the held record
+     */
+    void flushAnnotation();
+
+    /**
+     * @brief Start a new output on a stream
+     * @param stream Output stream
+     * @return True if the stream is usable
+     */
+    bool start(std::ostream& stream);
+};
+
+} // namespace ExclusionParser
+
+#endif // EXCLUSION_STREAM_WRITER_H
@@ -0,0 +1,355 @@
+/**
+ * @file ExclusionStringPool.h
+ * @brief Shared immutable strings and the interning pool that deduplicates them
+ *
+ * Exclusion files repeat the same text many times: a handful of annotation
+ * texts are attached to thousands of exclusions, every bit of a bus carries
+ * the same net description, and each ToggleExclusion repeats the signal name
+ * it is already filed under. InternedString stores such fields as a single
+ * pointer to one reference-counted copy of the text, and StringPool (owned by
+ * ExclusionData) hands out the same copy for equal text.
+ *
+ * InternedString reads like a const string: it converts implicitly to
+ * std::string and std::string_view, compares with strings and literals, and
+ * can be assigned from any string. Strings assigned directly (outside a pool)
+ * get their own copy, so exclusion structures remain usable on their own.
+ *
+ * @author AMD Advanced Micro Devices Inc. - Verification Infrastructure Team
+ * @version 2.0.0
+ * @date September 13, 2025
+ * @copyright (c) 2025 Advanced Micro Devices Inc. All rights reserved.
+ */
+
+#ifndef EXCLUSION_STRING_POOL_H
+#define EXCLUSION_STRING_POOL_H
+
+#include <atomic>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Export/Import macros for DLL support
+#ifndef EXCLUSION_API
+    #ifdef _WIN32
+        #ifdef EXCLUSION_PARSER_EXPORTS
+            #define EXCLUSION_API __declspec(dllexport)
+        #else
+            #define EXCLUSION_API __declspec(dllimport)
+        #endif
+    #else
+        #define EXCLUSION_API
+    #endif
+#endif
+
+namespace ExclusionParser {
+
+class StringPool;
+
+/**
+ * @brief Handle to a shared, immutable, reference-counted string
+ *
+ * The handle is one pointer wide. Copying it shares the text instead of
+ * copying it, and the empty string needs no storage at all.
+ */
+class EXCLUSION_API InternedString {
+public:
+    /// Heap block holding the reference count and length, followed by the text
+    struct Rep {
+        std::atomic<size_t> references;     ///< Handles (and pools) sharing this text
+        size_t size;                        ///< Text length in bytes
+
+        /**
+         * @brief Get the text stored after the header
+         * @return Pointer to size bytes of text plus a terminating '\0'
+         */
+        const char* text() const { return reinterpret_cast<const char*>(this + 1); }
+
+        /**
+         * @brief Get the text as a view
+         * @return View of the text
+         */
+        std::string_view view() const { return std::string_view(text(), size); }
+    };
+
+private:
+    Rep* rep_;      ///< Shared text, or nullptr for the empty string
+
+    friend class StringPool;
+
+    /**
+     * @brief Share an existing block (used by StringPool)
+     * @param rep Block to share
+     */
+    explicit InternedString(Rep* rep) : rep_(retain(rep)) {}
+
+    /**
+     * @brief Allocate a new block holding a copy of the text
+     * @param text Text to copy (must not be empty)
+     * @return Block with one reference
+     */
+    static Rep* allocate(std::string_view text);
+
+    /**
+     * @brief Free a block whose last reference was dropped
+     * @param rep Block to free
+     */
+    static void deallocate(Rep* rep);
+
+    /**
+     * @brief Add one reference
+     * @param rep Block to retain (may be nullptr)
+     * @return rep
+     */
+    static Rep* retain(Rep* rep) {
+        if (rep) {
+            rep->references.fetch_add(1, std::memory_order_relaxed);
+        }
+        return rep;
+    }
+
+    /**
+     * @brief Drop one reference, freeing the block with the last one
+     * @param rep Block to release (may be nullptr)
+     */
+    static void release(Rep* rep) {
+        if (rep && rep->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            deallocate(rep);
+        }
+    }
+
+public:
+    /**
+     * @brief Construct an empty string
+     */
+    InternedString() : rep_(nullptr) {}
+
+    /**
+     * @brief Construct with a private (non-pooled) copy of the text
+     * @param text Text to copy
+     */
+    InternedString(std::string_view text) : rep_(text.empty() ? nullptr : allocate(text)) {}
+
+    /**
+     * @brief Construct with a private (non-pooled) copy of the text
+     * @param text Text to copy
+     */
+    InternedString(const std::string& text) : InternedString(std::string_view(text)) {}
+
+    /**
+     * @brief Construct with a private (non-pooled) copy of the text
+     * @param text Null-terminated text to copy
+     */
+    InternedString(const char* text) : InternedString(std::string_view(text)) {}
+
+    InternedString(const InternedString& other) : rep_(retain(other.rep_)) {}
+    InternedString(InternedString&& other) noexcept : rep_(other.rep_) { other.rep_ = nullptr; }
+
+    InternedString& operator=(const InternedString& other) {
+        Rep* previous = rep_;
+        rep_ = retain(other.rep_);
+        release(previous);
+        return *this;
+    }
+
+    InternedString& operator=(InternedString&& other) noexcept {
+        if (this != &other) {
+            release(rep_);
+            rep_ = other.rep_;
+            other.rep_ = nullptr;
+        }
+        return *this;
+    }
+
+    ~InternedString() { release(rep_); }
+
+    /**
+     * @brief Get the text as a view
+     * @return View of the shared text, valid while any handle to it exists
+     */
+    std::string_view view() const { return rep_ ? rep_->view() : std::string_view(); }
+
+    /**
+     * @brief Get a copy of the text
+     * @return Text as std::string
+     */
+    std::string str() const { return std::string(view()); }
+
+    operator std::string_view() const { return view(); }    ///< Implicit read-only view
+    operator std::string() const { return str(); }          ///< Implicit copy
+
+    /**
+     * @brief Identity of the shared text (equal for handles from one pool)
+     * @return Storage address, or nullptr for the empty string
+     */
+    const void* storage() const { return rep_; }
+
+    bool empty() const { return rep_ == nullptr; }                  ///< True for the empty string
+    size_t size() const { return rep_ ? rep_->size : 0; }           ///< Length in bytes
+    size_t length() const { return size(); }                        ///< Length in bytes
+    const char* c_str() const { return rep_ ? rep_->text() : ""; }  ///< Null-terminated text
+    const char* data() const { return c_str(); }                    ///< Text bytes
+
+    /**
+     * @brief Find a substring
+     * @param needle Text to search for
+     * @param position Offset to start at
+     * @return Offset of the match, or std::string::npos
+     */
+    size_t find(std::string_view needle, size_t position = 0) const {
+        return view().find(needle, position);
+    }
+
+    /**
+     * @brief Equality; shared handles compare without touching the text
+     */
+    bool operator==(const InternedString& other) const {
+        return rep_ == other.rep_ || view() == other.view();
+    }
+
+    bool operator==(const std::string& other) const { return view() == other; }  ///< Text equality
+    bool operator==(std::string_view other) const { return view() == other; }    ///< Text equality
+    bool operator==(const char* other) const { return view() == other; }         ///< Text equality
+
+    /**
+     * @brief Lexicographic ordering by text
+     */
+    bool operator<(const InternedString& other) const { return view() < other.view(); }
+};
+
+/// @name Concatenation with std::string and literals
+/// @{
+inline std::string operator+(const std::string& lhs, const InternedString& rhs) { return lhs + rhs.str(); }
+inline std::string operator+(const char* lhs, const InternedString& rhs) { return lhs + rhs.str(); }
+inline std::string operator+(const InternedString& lhs, const std::string& rhs) { return lhs.str() + rhs; }
+inline std::string operator+(const InternedString& lhs, const char* rhs) { return lhs.str() + rhs; }
+/// @}
+
+/**
+ * @brief Stream output of the text
+ */
+inline std::ostream& operator<<(std::ostream& stream, const InternedString& value) {
+    return stream << value.view();
+}
+
+/**
+ * @brief Table of distinct texts handed out as shared InternedString handles
+ *
+ * Interning equal text twice returns handles to the same storage. The pool
+ * holds a reference to every text it has seen until clear(); handles
+ * already given out stay valid after clear() or after the pool is destroyed.
+ *
+ * Usage Example:
+ * @code
+ * StringPool pool;
+ * InternedString a = pool.intern("unused");
+ * InternedString b = pool.intern(std::string("unused"));
+ * assert(a.storage() == b.storage());
+ * @endcode
+ *
+ * @note Not thread-safe; each ExclusionData has its own pool.
+ */
+class EXCLUSION_API StringPool {
+public:
+    using Rep = InternedString::Rep;
+
+    /// Blocks of an absorbed pool that have to be replaced by this pool's (see absorb())
+    using Remap = std::unordered_map<const Rep*, Rep*>;
+
+private:
+    /// One table slot: a text's hash and block (nullptr when unused)
+    struct Slot {
+        size_t hash;    ///< Hash of the text
+        Rep* rep;       ///< Text, owned by one pool reference
+    };
+
+    /// Open-addressing table with linear probing; the size is zero or a power of two
+    std::vector<Slot> slots_;
+    size_t count_ = 0;  ///< Occupied slots
+
+    /**
+     * @brief Hash a text
+     * @param text Text to hash
+     * @return Hash value
+     */
+    static size_t hashText(std::string_view text) { return std::hash<std::string_view>()(text); }
+
+    /**
+     * @brief Find the slot holding a text, or the empty slot where it belongs
+     * @param text Text to look for
+     * @param hash hashText(text)
+     * @return Slot for the text (slots_ must not be empty)
+     */
+    Slot& findSlot(std::string_view text, size_t hash);
+
+    /**
+     * @brief Make room for at least one more text, doubling the table when half full
+     */
+    void reserveOne();
+
+public:
+    StringPool() = default;
+    StringPool(const StringPool& other);
+    StringPool(StringPool&& other) noexcept;
+    StringPool& operator=(const StringPool& other);
+    StringPool& operator=(StringPool&& other) noexcept;
+    ~StringPool();
+
+    /**
+     * @brief Get the shared handle for a text, adding it if new
+     * @param text Text to intern
+     * @return Handle shared by all equal texts from this pool
+     */
+    InternedString intern(std::string_view text);
+
+    /**
+     * @brief Add another pool's texts to this one
+     *
+     * Texts new to this pool are shared as they are (no copy). For texts this
+     * pool already holds, remap receives an entry from the other pool's block
+     * to this pool's; pass handles that came from the other pool through
+     * rehome() to share this pool's copy instead. Each distinct text is
+     * hashed once, however many handles refer to it.
+     *
+     * @param other Pool whose texts to add
+     * @param remap Receives blocks that have to be replaced
+     */
+    void absorb(const StringPool& other, Remap& remap);
+
+    /**
+     * @brief Replace a handle whose block was remapped by absorb()
+     * @param value Handle to update
+     * @param remap Mapping filled by absorb()
+     */
+    static void rehome(InternedString& value, const Remap& remap) {
+        if (value.rep_) {
+            auto it = remap.find(value.rep_);
+            if (it != remap.end()) {
+                value = InternedString(it->second);
+            }
+        }
+    }
+
+    /**
+     * @brief Get the number of distinct texts
+     * @return Distinct text count
+     */
+    size_t size() const { return count_; }
+
+    /**
+     * @brief Get the number of bytes of distinct text held
+     * @return Sum of the distinct text lengths
+     */
+    size_t getTextBytes() const;
+
+    /**
+     * @brief Forget all texts (existing handles stay valid)
+     */
+    void clear();
+};
+
+} // namespace ExclusionParser
+
+#endif // EXCLUSION_STRING_POOL_H
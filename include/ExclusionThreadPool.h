@@ -0,0 +1,104 @@
+/**
+ * @file ExclusionThreadPool.h
+ * @brief Bounded worker thread pool used for parallel parsing and writing
+ * 
+ * This file contains a small fixed-size thread pool. Tasks are queued in
+ * submission order and picked up by the first free worker; each submit()
+ * returns a std::future for the task's result. The pool is used by
+ * ExclusionParser::parseFiles to parse several files concurrently.
+ * 
+ * @author AMD Advanced Micro Devices Inc. - Verification Infrastructure Team
+ * @version 2.0.0
+ * @date September 13, 2025
+ * @copyright (c) 2025 Advanced Micro Devices Inc. All rights reserved.
+ * 
+ * @note Destroying the pool waits for every queued task to finish.
+ */
+
+#ifndef EXCLUSION_THREAD_POOL_H
+#define EXCLUSION_THREAD_POOL_H
+
+#include "ExclusionTypes.h"
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <semaphore>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ExclusionParser {
+
+/**
+ * @brief Fixed-size pool of worker threads
+ * 
+ * Usage Example:
+ * @code
+ * ThreadPool pool(4);
+ * auto future = pool.submit([] { return 42; });
+ * int value = future.get();
+ * @endcode
+ */
+class EXCLUSION_API ThreadPool {
+public:
+    /**
+     * @brief Constructor, starts the worker threads
+     * @param threadCount Number of workers (0 = hardware concurrency)
+     */
+    explicit ThreadPool(size_t threadCount = 0);
+    
+    /**
+     * @brief Destructor, drains the queue and joins all workers
+     */
+    ~ThreadPool();
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    /**
+     * @brief Queue a task for execution
+     * @param task Callable taking no arguments
+     * @return Future receiving the task's result (or exception)
+     */
+    template<typename F>
+    std::future<std::invoke_result_t<std::decay_t<F>>> submit(F&& task) {
+        using Result = std::invoke_result_t<std::decay_t<F>>;
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> future = packaged->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.emplace_back([packaged] { (*packaged)(); });
+        }
+        available_.release();
+        return future;
+    }
+    
+    /**
+     * @brief Get the number of worker threads
+     * @return Worker count
+     */
+    size_t getThreadCount() const { return workers_.size(); }
+    
+    /**
+     * @brief Resolve a requested thread count
+     * @param requested Requested count (0 = hardware concurrency)
+     * @return Effective count, at least 1
+     */
+    static size_t resolveThreadCount(size_t requested);
+    
+private:
+    std::vector<std::thread> workers_;              ///< Worker threads
+    std::deque<std::function<void()>> tasks_;       ///< Pending tasks in submission order
+    std::mutex mutex_;                              ///< Guards tasks_
+    std::counting_semaphore<> available_;           ///< One permit per queued task, plus one per worker at shutdown
+    
+    /**
+     * @brief Worker thread main loop
+     */
+    void workerLoop();
+};
+
+} // namespace ExclusionParser
+
+#endif // EXCLUSION_THREAD_POOL_H
@@ -0,0 +1,332 @@
+/**
+ * @file ExclusionTokenizer.h
+ * @brief Zero-copy tokenizer primitives for .el exclusion list files
+ *
+ * This file contains the lightweight tokenizer layer used by ExclusionParser to
+ * scan exclusion files without copying. All tokens are std::string_view slices
+ * of the caller's input buffer; nothing is allocated until a parsed field is
+ * finally stored in an exclusion structure.
+ *
+ * Tokenizer Components:
+ * - LineReader splits an input buffer into lines (handles "\n" and "\r\n")
+ * - Cursor walks a single line and extracts words and quoted fields
+ * - Free helper functions for trimming and prefix tests on string views
+ * - classifyLine() identifies a record's kind from its leading keyword
+ *
+ * @author AMD Advanced Micro Devices Inc. - Verification Infrastructure Team
+ * @version 2.0.0
+ * @date September 13, 2025
+ * @copyright (c) 2025 Advanced Micro Devices Inc. All rights reserved.
+ *
+ * @note Views returned by the tokenizer are only valid while the underlying
+ *       buffer is alive and unmodified.
+ */
+
+#ifndef EXCLUSION_TOKENIZER_H
+#define EXCLUSION_TOKENIZER_H
+
+#include <string_view>
+#include <cstddef>
+
+namespace ExclusionParser {
+namespace Tokenizer {
+
+/**
+ * @brief Check whether a character is whitespace for tokenizing purposes
+ * @param c Character to test
+ * @return True for space, tab, carriage return or newline
+ */
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+/**
+ * @brief Trim leading and trailing whitespace from a view
+ * @param str View to trim
+ * @return Trimmed view into the same buffer
+ */
+inline std::string_view trim(std::string_view str) {
+    size_t start = 0;
+    while (start < str.size() && isSpace(str[start])) {
+        start++;
+    }
+    size_t end = str.size();
+    while (end > start && isSpace(str[end - 1])) {
+        end--;
+    }
+    return str.substr(start, end - start);
+}
+
+/**
+ * @brief Check whether a view starts with a prefix
+ * @param str View to test
+ * @param prefix Expected prefix
+ * @return True if str begins with prefix
+ */
+inline bool startsWith(std::string_view str, std::string_view prefix) {
+    return str.size() >= prefix.size() && str.compare(0, prefix.size(), prefix) == 0;
+}
+
+/**
+ * @brief Remove one pair of enclosing double quotes, if present
+ * @param str View to unquote
+ * @return View without the surrounding quotes
+ */
+inline std::string_view unquote(std::string_view str) {
+    if (str.size() >= 2 && str.front() == '"' && str.back() == '"') {
+        return str.substr(1, str.size() - 2);
+    }
+    return str;
+}
+
+/**
+ * @brief Kind of a trimmed .el line, as identified by its leading keyword
+ */
+enum class LineKind {
+    EMPTY,              ///< Blank line
+    COMMENT,            ///< "//" comment or "=====" separator (may carry header fields)
+    CHECKSUM,           ///< CHECKSUM: "..."
+    INSTANCE,           ///< INSTANCE: hierarchical.path
+    MODULE,             ///< MODULE: name
+    ANNOTATION,         ///< ANNOTATION: "..."
+    ANNOTATION_BEGIN,   ///< ANNOTATION_BEGIN: "..."
+    ANNOTATION_END,     ///< ANNOTATION_END
+    BLOCK,              ///< Block id "checksum" "source"
+    TOGGLE,             ///< Toggle [dir] signal [bit] "net ..."
+    FSM,                ///< Fsm name "checksum"
+    TRANSITION,         ///< Transition from->to "id"
+    CONDITION,          ///< Condition id "checksum" "expr params" (coverage)
+    UNKNOWN             ///< Anything else
+};
+
+/**
+ * @brief Identify the kind of a trimmed line in a single dispatch step
+ *
+ * Switches on the first character and then compares at most two keyword
+ * prefixes, so every line is classified in a handful of byte comparisons
+ * regardless of its length.
+ *
+ * @param line Trimmed line
+ * @return Line kind
+ */
+inline LineKind classifyLine(std::string_view line) {
+    if (line.empty()) {
+        return LineKind::EMPTY;
+    }
+    
+    switch (line[0]) {
+        case '/':
+            return startsWith(line, "//") ? LineKind::COMMENT : LineKind::UNKNOWN;
+        case '=':
+            return startsWith(line, "==================================================")
+                       ? LineKind::COMMENT : LineKind::UNKNOWN;
+        case 'T':
+            if (startsWith(line, "Toggle ")) return LineKind::TOGGLE;
+            if (startsWith(line, "Transition ")) return LineKind::TRANSITION;
+            break;
+        case 'A':
+            if (startsWith(line, "ANNOTATION")) {
+                std::string_view tail = line.substr(10);
+                if (startsWith(tail, ":")) return LineKind::ANNOTATION;
+                if (startsWith(tail, "_BEGIN:")) return LineKind::ANNOTATION_BEGIN;
+                if (startsWith(tail, "_END")) return LineKind::ANNOTATION_END;
+            }
+            break;
+        case 'B':
+            if (startsWith(line, "Block ")) return LineKind::BLOCK;
+            break;
+        case 'C':
+            if (startsWith(line, "CHECKSUM:")) return LineKind::CHECKSUM;
+            if (startsWith(line, "Condition ")) return LineKind::CONDITION;
+            break;
+        case 'I':
+            if (startsWith(line, "INSTANCE:")) return LineKind::INSTANCE;
+            break;
+        case 'M':
+            if (startsWith(line, "MODULE:")) return LineKind::MODULE;
+            break;
+        case 'F':
+            if (startsWith(line, "Fsm ")) return LineKind::FSM;
+            break;
+        default:
+            break;
+    }
+    return LineKind::UNKNOWN;
+}
+
+/**
+ * @brief Splits an input buffer into lines without copying
+ *
+ * Lines are returned without their terminating '\n'. A trailing '\r' is left
+ * in place; callers normally trim() each line anyway.
+ */
+class LineReader {
+private:
+    std::string_view buffer_;   ///< Complete input buffer
+    size_t position_;           ///< Offset of the next unread line
+    size_t lineNumber_;         ///< Number of lines returned so far
+
+public:
+    /**
+     * @brief Constructor
+     * @param buffer Input buffer to split
+     */
+    explicit LineReader(std::string_view buffer)
+        : buffer_(buffer), position_(0), lineNumber_(0) {}
+
+    /**
+     * @brief Read the next line
+     * @param line Receives the line view (without newline)
+     * @return False once the buffer is exhausted
+     */
+    bool next(std::string_view& line) {
+        if (position_ >= buffer_.size()) {
+            return false;
+        }
+        size_t end = buffer_.find('\n', position_);
+        if (end == std::string_view::npos) {
+            end = buffer_.size();
+        }
+        line = buffer_.substr(position_, end - position_);
+        position_ = end + 1;
+        lineNumber_++;
+        return true;
+    }
+
+    /**
+     * @brief Get the 1-based number of the line most recently returned
+     * @return Line number
+     */
+    size_t lineNumber() const { return lineNumber_; }
+
+    /**
+     * @brief Get the offset of the next unread byte
+     * @return Byte offset into the buffer
+     */
+    size_t position() const { return position_; }
+};
+
+/**
+ * @brief Scans words and quoted fields within a single line
+ *
+ * The cursor never allocates; every extracted token is a view into the line.
+ */
+class Cursor {
+private:
+    std::string_view line_;     ///< Line being scanned
+    size_t position_;           ///< Current scan offset
+
+public:
+    /**
+     * @brief Constructor
+     * @param line Line to scan
+     * @param position Starting offset
+     */
+    explicit Cursor(std::string_view line, size_t position = 0)
+        : line_(line), position_(position < line.size() ? position : line.size()) {}
+
+    /**
+     * @brief Skip any whitespace at the current position
+     */
+    void skipSpace() {
+        while (position_ < line_.size() && isSpace(line_[position_])) {
+            position_++;
+        }
+    }
+
+    /**
+     * @brief Extract the next whitespace-delimited word
+     * @return Word view (empty at end of line)
+     */
+    std::string_view word() {
+        skipSpace();
+        size_t start = position_;
+        while (position_ < line_.size() && !isSpace(line_[position_])) {
+            position_++;
+        }
+        return line_.substr(start, position_ - start);
+    }
+
+    /**
+     * @brief Extract characters up to (not including) any of the stop characters
+     * @param stops Characters that terminate the token
+     * @return Token view
+     */
+    std::string_view until(std::string_view stops) {
+        size_t start = position_;
+        size_t end = line_.find_first_of(stops, position_);
+        if (end == std::string_view::npos) {
+            end = line_.size();
+        }
+        position_ = end;
+        return line_.substr(start, end - start);
+    }
+
+    /**
+     * @brief Extract the contents of the next double-quoted field
+     *
+     * Searches forward for an opening quote and returns everything up to the
+     * following quote. If no complete field is found the cursor moves to the
+     * end of the line and an empty view is returned.
+     *
+     * @return Field contents without the quotes
+     */
+    std::string_view quoted() {
+        size_t quoteStart = line_.find('"', position_);
+        if (quoteStart == std::string_view::npos) {
+            position_ = line_.size();
+            return {};
+        }
+        size_t quoteEnd = line_.find('"', quoteStart + 1);
+        if (quoteEnd == std::string_view::npos) {
+            position_ = line_.size();
+            return {};
+        }
+        position_ = quoteEnd + 1;
+        return line_.substr(quoteStart + 1, quoteEnd - quoteStart - 1);
+    }
+
+    /**
+     * @brief Consume a literal token if it is next on the line
+     * @param token Literal to match
+     * @return True if the token was present and consumed
+     */
+    bool consume(std::string_view token) {
+        if (startsWith(line_.substr(position_), token)) {
+            position_ += token.size();
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Peek at the character under the cursor
+     * @return Current character, or '\0' at end of line
+     */
+    char peek() const {
+        return position_ < line_.size() ? line_[position_] : '\0';
+    }
+
+    /**
+     * @brief Get the unread remainder of the line
+     * @return Remaining view
+     */
+    std::string_view rest() const { return line_.substr(position_); }
+
+    /**
+     * @brief Get the current scan offset
+     * @return Offset within the line
+     */
+    size_t position() const { return position_; }
+
+    /**
+     * @brief Check whether the whole line has been consumed
+     * @return True at end of line
+     */
+    bool atEnd() const { return position_ >= line_.size(); }
+};
+
+} // namespace Tokenizer
+} // namespace ExclusionParser
+
+#endif // EXCLUSION_TOKENIZER_H
@@ -41,11 +41,14 @@
 #ifndef EXCLUSION_TYPES_H
 #define EXCLUSION_TYPES_H
 
+#include <algorithm>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <unordered_map>
 #include <memory>
 #include <optional>
+#include <iterator>
 
 // Export/Import macros for DLL support
 #ifdef _WIN32
@@ -58,8 +61,40 @@
     #define EXCLUSION_API
 #endif
 
+#include "ExclusionStringPool.h"
+#include "ExclusionScopeTrie.h"
+
+#ifdef EXCLUSION_USE_PMR
+#include <memory_resource>
+#endif
+
 namespace ExclusionParser {
 
+/**
+ * @brief Container types used for scopes and exclusions
+ * 
+ * In the default build these are the std containers. Configuring with
+ * EXCLUSION_USE_PMR (CMake option of the same name) switches them to their
+ * std::pmr counterparts so that every ExclusionData allocates its scopes and
+ * exclusion containers from a monotonic arena it owns. The two builds are not
+ * ABI compatible; consumers must be compiled with the same setting.
+ */
+#ifdef EXCLUSION_USE_PMR
+template <typename Key, typename Value>
+using ExclusionMap = std::pmr::unordered_map<Key, Value>;
+
+template <typename Value>
+using ExclusionVector = std::pmr::vector<Value>;
+#else
+template <typename Key, typename Value>
+using ExclusionMap = std::unordered_map<Key, Value>;
+
+template <typename Value>
+using ExclusionVector = std::vector<Value>;
+#endif
+
+class FrozenExclusionData;
+
 /**
  * @brief Enumeration for hardware coverage exclusion types
  * 
@@ -107,7 +142,7 @@ struct EXCLUSION_API BlockExclusion {
     std::string blockId;        ///< Unique block identifier within scope (e.g., "161", "block_42")
     std::string checksum;       ///< Cryptographic checksum for database integrity (e.g., "1104666086")
     std::string sourceCode;     ///< Complete Verilog/SystemVerilog source line being excluded
-    std::string annotation;     ///< Optional human-readable annotation explaining exclusion rationale
+    InternedString annotation;  ///< Optional human-readable annotation explaining exclusion rationale
     
     /**
      * @brief Default constructor for BlockExclusion
@@ -117,8 +152,13 @@ struct EXCLUSION_API BlockExclusion {
      * @param annot Optional annotation explaining why this block is excluded (default empty)
      */
     BlockExclusion(const std::string& id = "", const std::string& cs = "", 
-                   const std::string& code = "", const std::string& annot = "")
+                   const std::string& code = "", const InternedString& annot = {})
         : blockId(id), checksum(cs), sourceCode(code), annotation(annot) {}
+    
+    /**
+     * @brief Member-wise equality
+     */
+    bool operator==(const BlockExclusion& other) const = default;
 };
 
 /**
@@ -140,10 +180,10 @@ struct EXCLUSION_API BlockExclusion {
  */
 struct EXCLUSION_API ToggleExclusion {
     ToggleDirection direction;   ///< Specific transition direction to exclude (0->1, 1->0, or both)
-    std::string signalName;      ///< Full hierarchical signal name in the design
+    InternedString signalName;   ///< Full hierarchical signal name in the design
     std::optional<int> bitIndex; ///< Optional bit index for array/bus signals (std::nullopt for scalar)
-    std::string netDescription;  ///< Descriptive net information from verification database
-    std::string annotation;      ///< Optional human-readable exclusion rationale and documentation
+    InternedString netDescription; ///< Descriptive net information from verification database
+    InternedString annotation;   ///< Optional human-readable exclusion rationale and documentation
     
     /**
      * @brief Default constructor for ToggleExclusion
@@ -154,12 +194,234 @@ struct EXCLUSION_API ToggleExclusion {
      * @param annot Optional annotation explaining exclusion rationale (default empty)
      */
     ToggleExclusion(ToggleDirection dir = ToggleDirection::BOTH, 
-                    const std::string& name = "", 
+                    const InternedString& name = {}, 
                     std::optional<int> bit = std::nullopt,
-                    const std::string& desc = "", 
-                    const std::string& annot = "")
+                    const InternedString& desc = {}, 
+                    const InternedString& annot = {})
         : direction(dir), signalName(name), bitIndex(bit), 
           netDescription(desc), annotation(annot) {}
+    
+    /**
+     * @brief Member-wise equality
+     */
+    bool operator==(const ToggleExclusion& other) const = default;
+};
+
+/**
+ * @brief Columnar (structure-of-arrays) store for the toggle exclusions of a scope
+ * 
+ * Each row holds a signal, an optional bit index, a direction bitmask, a net
+ * description and an annotation in five parallel columns. The text columns
+ * are InternedString handles, so a row takes 29 bytes however long the
+ * texts are.
+ * 
+ * Toggle exclusions mostly come in 1to0/0to1 pairs for the same net. add()
+ * folds the second half of such a pair into the previous row when signal,
+ * bit, description and annotation all match. forEachDirection() expands a
+ * row back into its toggles in the order they were added.
+ * 
+ * Usage Example:
+ * @code
+ * ToggleTable table;
+ * table.add(ToggleExclusion(ToggleDirection::ONE_TO_ZERO, "clk", std::nullopt, "net clk"));
+ * table.add(ToggleExclusion(ToggleDirection::ZERO_TO_ONE, "clk", std::nullopt, "net clk"));
+ * assert(table.getRowCount() == 1 && table.getExclusionCount() == 2);
+ * @endcode
+ * 
+ * @note The columns always use the default allocator, also with EXCLUSION_USE_PMR.
+ */
+class EXCLUSION_API ToggleTable {
+public:
+    /// @name Direction bitmask values
+    /// @{
+    static constexpr uint8_t ZERO_TO_ONE_BIT = 1u << static_cast<unsigned>(ToggleDirection::ZERO_TO_ONE);
+    static constexpr uint8_t ONE_TO_ZERO_BIT = 1u << static_cast<unsigned>(ToggleDirection::ONE_TO_ZERO);
+    static constexpr uint8_t BOTH_BIT = 1u << static_cast<unsigned>(ToggleDirection::BOTH);
+    static constexpr uint8_t ZERO_TO_ONE_FIRST = 0x80;    ///< A folded pair was added as 0to1, then 1to0
+    /// @}
+    
+    static constexpr int32_t NO_BIT = INT32_MIN;    ///< Bit index column value for scalar signals
+    
+private:
+    std::vector<InternedString> signals_;       ///< Signal name per row
+    std::vector<int32_t> bitIndices_;           ///< Bit index per row, or NO_BIT
+    std::vector<uint8_t> directions_;           ///< Direction bitmask per row
+    std::vector<InternedString> descriptions_;  ///< Net description per row
+    std::vector<InternedString> annotations_;   ///< Annotation per row
+    size_t exclusionCount_ = 0;                 ///< Toggles represented (folded pairs count twice)
+    
+public:
+    /**
+     * @brief Get the bitmask value of a direction
+     * @param direction Toggle direction
+     * @return Single-bit mask
+     */
+    static uint8_t directionBit(ToggleDirection direction) {
+        return static_cast<uint8_t>(1u << static_cast<unsigned>(direction));
+    }
+    
+    /**
+     * @brief Add a toggle exclusion, folding it into the last row when it completes a pair
+     * @param direction Toggle direction
+     * @param signalName Signal name
+     * @param bitIndex Bit index, if any
+     * @param netDescription Net description
+     * @param annotation Annotation
+     */
+    void add(ToggleDirection direction, const InternedString& signalName, std::optional<int> bitIndex,
+             const InternedString& netDescription, const InternedString& annotation) {
+        int32_t bit = bitIndex.has_value() ? static_cast<int32_t>(*bitIndex) : NO_BIT;
+        uint8_t mask = directionBit(direction);
+        exclusionCount_++;
+        
+        if (!directions_.empty() && direction != ToggleDirection::BOTH) {
+            uint8_t& last = directions_.back();
+            uint8_t other = mask == ZERO_TO_ONE_BIT ? ONE_TO_ZERO_BIT : ZERO_TO_ONE_BIT;
+            if (last == other && bitIndices_.back() == bit && signals_.back() == signalName &&
+                descriptions_.back() == netDescription && annotations_.back() == annotation) {
+                last = static_cast<uint8_t>(last | mask | (other == ZERO_TO_ONE_BIT ? ZERO_TO_ONE_FIRST : 0));
+                return;
+            }
+        }
+        
+        signals_.push_back(signalName);
+        bitIndices_.push_back(bit);
+        directions_.push_back(mask);
+        descriptions_.push_back(netDescription);
+        annotations_.push_back(annotation);
+    }
+    
+    /**
+     * @brief Add a toggle exclusion, folding it into the last row when it completes a pair
+     * @param toggle Toggle exclusion to add
+     */
+    void add(const ToggleExclusion& toggle) {
+        add(toggle.direction, toggle.signalName, toggle.bitIndex, toggle.netDescription, toggle.annotation);
+    }
+    
+    /**
+     * @brief Append all rows of another table
+     * 
+     * A single-direction first row is added through add(), so a pair split
+     * across the two tables (e.g. by a chunk boundary) is still folded.
+     * 
+     * @param other Table to append
+     */
+    void append(const ToggleTable& other) {
+        if (other.empty()) {
+            return;
+        }
+        
+        size_t first = 0;
+        uint8_t mask = other.directions_[0];
+        if (mask == ZERO_TO_ONE_BIT || mask == ONE_TO_ZERO_BIT) {
+            add(mask == ZERO_TO_ONE_BIT ? ToggleDirection::ZERO_TO_ONE : ToggleDirection::ONE_TO_ZERO,
+                other.signals_[0], other.bitIndex(0), other.descriptions_[0], other.annotations_[0]);
+            first = 1;
+        }
+        
+        signals_.insert(signals_.end(), other.signals_.begin() + first, other.signals_.end());
+        bitIndices_.insert(bitIndices_.end(), other.bitIndices_.begin() + first, other.bitIndices_.end());
+        directions_.insert(directions_.end(), other.directions_.begin() + first, other.directions_.end());
+        descriptions_.insert(descriptions_.end(), other.descriptions_.begin() + first, other.descriptions_.end());
+        annotations_.insert(annotations_.end(), other.annotations_.begin() + first, other.annotations_.end());
+        exclusionCount_ += other.exclusionCount_ - first;
+    }
+    
+    size_t getRowCount() const { return directions_.size(); }      ///< Number of rows
+    size_t getExclusionCount() const { return exclusionCount_; }   ///< Number of toggles represented
+    bool empty() const { return directions_.empty(); }             ///< True if the table has no rows
+    
+    /// @name Row access
+    /// @{
+    const InternedString& signalName(size_t row) const { return signals_[row]; }
+    const InternedString& netDescription(size_t row) const { return descriptions_[row]; }
+    const InternedString& annotation(size_t row) const { return annotations_[row]; }
+    uint8_t directionMask(size_t row) const { return directions_[row]; }
+    std::optional<int> bitIndex(size_t row) const {
+        return bitIndices_[row] == NO_BIT ? std::nullopt : std::optional<int>(bitIndices_[row]);
+    }
+    /// @}
+    
+    /**
+     * @brief Call a function for each toggle of a row, in the order they were added
+     * @param row Row index
+     * @param function Called with each ToggleDirection of the row
+     */
+    template <typename Function>
+    void forEachDirection(size_t row, Function&& function) const {
+        uint8_t mask = directions_[row];
+        if (mask & BOTH_BIT) {
+            function(ToggleDirection::BOTH);
+        } else if ((mask & (ZERO_TO_ONE_BIT | ONE_TO_ZERO_BIT)) == (ZERO_TO_ONE_BIT | ONE_TO_ZERO_BIT)) {
+            bool zeroToOneFirst = (mask & ZERO_TO_ONE_FIRST) != 0;
+            function(zeroToOneFirst ? ToggleDirection::ZERO_TO_ONE : ToggleDirection::ONE_TO_ZERO);
+            function(zeroToOneFirst ? ToggleDirection::ONE_TO_ZERO : ToggleDirection::ZERO_TO_ONE);
+        } else {
+            function(mask & ZERO_TO_ONE_BIT ? ToggleDirection::ZERO_TO_ONE : ToggleDirection::ONE_TO_ZERO);
+        }
+    }
+    
+    /**
+     * @brief Build the ToggleExclusion for one direction of a row
+     * @param row Row index
+     * @param direction Direction to use
+     * @return Toggle exclusion sharing the row's texts
+     */
+    ToggleExclusion getToggle(size_t row, ToggleDirection direction) const {
+        return ToggleExclusion(direction, signals_[row], bitIndex(row), descriptions_[row], annotations_[row]);
+    }
+    
+    /**
+     * @brief Call a function for every toggle in the table, rows expanded in order
+     * @param function Called with each const ToggleExclusion&
+     */
+    template <typename Function>
+    void forEachToggle(Function&& function) const {
+        for (size_t row = 0; row < directions_.size(); ++row) {
+            forEachDirection(row, [&](ToggleDirection direction) {
+                function(getToggle(row, direction));
+            });
+        }
+    }
+    
+    /**
+     * @brief Point the text columns at another pool's copies (see StringPool::absorb())
+     * @param remap Blocks to replace
+     */
+    void rehomeStrings(const StringPool::Remap& remap) {
+        for (size_t row = 0; row < directions_.size(); ++row) {
+            StringPool::rehome(signals_[row], remap);
+            StringPool::rehome(descriptions_[row], remap);
+            StringPool::rehome(annotations_[row], remap);
+        }
+    }
+    
+    /**
+     * @brief Get the bytes held by the columns (texts not included)
+     * @return Column capacity in bytes
+     */
+    size_t getColumnBytes() const {
+        return (signals_.capacity() + descriptions_.capacity() + annotations_.capacity()) * sizeof(InternedString) +
+               bitIndices_.capacity() * sizeof(int32_t) + directions_.capacity() * sizeof(uint8_t);
+    }
+    
+    /**
+     * @brief Remove all rows
+     */
+    void clear() {
+        signals_.clear();
+        bitIndices_.clear();
+        directions_.clear();
+        descriptions_.clear();
+        annotations_.clear();
+        exclusionCount_ = 0;
+    }
+    
+    /**
+     * @brief Row-wise equality
+     */
+    bool operator==(const ToggleTable& other) const = default;
 };
 
 /**
@@ -186,7 +448,7 @@ struct EXCLUSION_API FsmExclusion {
     std::string fromState;       ///< Source state name (for transition exclusions, empty for state exclusions)
     std::string toState;         ///< Destination state name (for transition exclusions, empty for state exclusions)
     std::string transitionId;    ///< Transition encoding or identifier (e.g., "11->0", "encode_01")
-    std::string annotation;      ///< Optional human-readable exclusion rationale and documentation
+    InternedString annotation;   ///< Optional human-readable exclusion rationale and documentation
     bool isTransition;           ///< True for state transition exclusions, false for individual state exclusions
     
     /**
@@ -196,7 +458,7 @@ struct EXCLUSION_API FsmExclusion {
      * @param annot Optional annotation explaining why this state is excluded (default empty)
      */
     FsmExclusion(const std::string& name = "", const std::string& cs = "", 
-                 const std::string& annot = "")
+                 const InternedString& annot = {})
         : fsmName(name), checksum(cs), annotation(annot), isTransition(false) {}
     
     /**
@@ -209,19 +471,17 @@ struct EXCLUSION_API FsmExclusion {
      */
     FsmExclusion(const std::string& name, const std::string& from, 
                  const std::string& to, const std::string& transId, 
-                 const std::string& annot = "")
+                 const InternedString& annot = {})
         : fsmName(name), fromState(from), toState(to), 
           transitionId(transId), annotation(annot), isTransition(true) {}
+    
+    /**
+     * @brief Member-wise equality
+     */
+    bool operator==(const FsmExclusion& other) const = default;
 };
 
 /**
- * @brief Structure representing a condition exclusion
- * 
- * Condition exclusions represent conditional coverage points that are
- * excluded from analysis, typically complex boolean expressions.
- * 
- * Example from file:
- * /**
  * @brief Structure representing a conditional/branch coverage exclusion
  * 
  * Condition exclusions define complex Boolean expressions and decision points
@@ -244,7 +504,7 @@ struct EXCLUSION_API ConditionExclusion {
     std::string expression;      ///< Complete Boolean expression being excluded from coverage
     std::string parameters;      ///< Additional coverage analysis parameters (e.g., "1 -1", "branch_weights")
     std::string coverage;        ///< Coverage type specification (e.g., "branch", "condition", "1 \"01\"")
-    std::string annotation;      ///< Optional human-readable exclusion rationale and documentation
+    InternedString annotation;   ///< Optional human-readable exclusion rationale and documentation
     
     /**
      * @brief Default constructor for ConditionExclusion
@@ -257,9 +517,14 @@ struct EXCLUSION_API ConditionExclusion {
      */
     ConditionExclusion(const std::string& id = "", const std::string& cs = "",
                        const std::string& expr = "", const std::string& params = "",
-                       const std::string& cov = "", const std::string& annot = "")
+                       const std::string& cov = "", const InternedString& annot = {})
         : conditionId(id), checksum(cs), expression(expr), 
           parameters(params), coverage(cov), annotation(annot) {}
+    
+    /**
+     * @brief Member-wise equality
+     */
+    bool operator==(const ConditionExclusion& other) const = default;
 };
 
 /**
@@ -281,16 +546,20 @@ struct EXCLUSION_API ExclusionScope {
     
     // Exclusion containers using unordered_map for efficient lookup
     /// Block exclusions mapped by block ID
-    std::unordered_map<std::string, BlockExclusion> blockExclusions;
+    ExclusionMap<std::string, BlockExclusion> blockExclusions;
     
     /// Toggle exclusions mapped by signal name + direction + bit index
-    std::unordered_map<std::string, std::vector<ToggleExclusion>> toggleExclusions;
+    ExclusionMap<std::string, ExclusionVector<ToggleExclusion>> toggleExclusions;
+    
+    /// Toggle exclusions in columnar form (filled instead of toggleExclusions
+    /// when ParserConfig::columnarToggles is set; see compactToggleExclusions())
+    ToggleTable toggleTable;
     
     /// FSM exclusions mapped by FSM name
-    std::unordered_map<std::string, std::vector<FsmExclusion>> fsmExclusions;
+    ExclusionMap<std::string, ExclusionVector<FsmExclusion>> fsmExclusions;
     
     /// Condition exclusions mapped by condition ID
-    std::unordered_map<std::string, ConditionExclusion> conditionExclusions;
+    ExclusionMap<std::string, ConditionExclusion> conditionExclusions;
     
     /**
      * @brief Constructor
@@ -302,6 +571,66 @@ struct EXCLUSION_API ExclusionScope {
                    bool module = false)
         : scopeName(name), checksum(cs), isModule(module) {}
     
+#ifdef EXCLUSION_USE_PMR
+    /// Allocator used for the exclusion containers (taken from the owning ExclusionData)
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+    
+    /**
+     * @brief Construct an empty scope whose containers allocate from a memory resource
+     * @param allocator Allocator for the exclusion containers
+     */
+    explicit ExclusionScope(const allocator_type& allocator)
+        : ExclusionScope("", "", false, allocator) {}
+    
+    /**
+     * @brief Constructor with an allocator for the exclusion containers
+     * @param name Scope name
+     * @param cs Checksum
+     * @param module True if this is a module scope
+     * @param allocator Allocator for the exclusion containers
+     */
+    ExclusionScope(const std::string& name, const std::string& cs, bool module,
+                   const allocator_type& allocator)
+        : scopeName(name), checksum(cs), isModule(module),
+          blockExclusions(allocator), toggleExclusions(allocator),
+          fsmExclusions(allocator), conditionExclusions(allocator) {}
+    
+    /**
+     * @brief Copy a scope into containers using another allocator
+     * @param other Scope to copy
+     * @param allocator Allocator for the exclusion containers
+     */
+    ExclusionScope(const ExclusionScope& other, const allocator_type& allocator)
+        : scopeName(other.scopeName), checksum(other.checksum), isModule(other.isModule),
+          blockExclusions(other.blockExclusions, allocator),
+          toggleExclusions(other.toggleExclusions, allocator), toggleTable(other.toggleTable),
+          fsmExclusions(other.fsmExclusions, allocator),
+          conditionExclusions(other.conditionExclusions, allocator) {}
+    
+    /**
+     * @brief Move a scope into containers using another allocator
+     * 
+     * Containers are taken over as a whole when the allocators are equal and
+     * moved element by element otherwise.
+     * 
+     * @param other Scope to move from
+     * @param allocator Allocator for the exclusion containers
+     */
+    ExclusionScope(ExclusionScope&& other, const allocator_type& allocator)
+        : scopeName(std::move(other.scopeName)), checksum(std::move(other.checksum)),
+          isModule(other.isModule),
+          blockExclusions(std::move(other.blockExclusions), allocator),
+          toggleExclusions(std::move(other.toggleExclusions), allocator),
+          toggleTable(std::move(other.toggleTable)),
+          fsmExclusions(std::move(other.fsmExclusions), allocator),
+          conditionExclusions(std::move(other.conditionExclusions), allocator) {}
+    
+    ExclusionScope(const ExclusionScope& other) = default;
+    ExclusionScope(ExclusionScope&& other) = default;
+    ExclusionScope& operator=(const ExclusionScope& other) = default;
+    ExclusionScope& operator=(ExclusionScope&& other) = default;
+#endif
+    
     /**
      * @brief Add a block exclusion to this scope
      * @param exclusion Block exclusion to add
@@ -310,6 +639,15 @@ struct EXCLUSION_API ExclusionScope {
         blockExclusions[exclusion.blockId] = exclusion;
     }
     
+    /**
+     * @brief Add a block exclusion to this scope, taking ownership of its strings
+     * @param exclusion Block exclusion to move into the scope
+     */
+    void addBlockExclusion(BlockExclusion&& exclusion) {
+        auto& slot = blockExclusions[exclusion.blockId];
+        slot = std::move(exclusion);
+    }
+    
     /**
      * @brief Add a toggle exclusion to this scope
      * @param exclusion Toggle exclusion to add
@@ -318,6 +656,15 @@ struct EXCLUSION_API ExclusionScope {
         toggleExclusions[exclusion.signalName].push_back(exclusion);
     }
     
+    /**
+     * @brief Add a toggle exclusion to this scope, taking ownership of its strings
+     * @param exclusion Toggle exclusion to move into the scope
+     */
+    void addToggleExclusion(ToggleExclusion&& exclusion) {
+        auto& toggles = toggleExclusions[exclusion.signalName];
+        toggles.push_back(std::move(exclusion));
+    }
+    
     /**
      * @brief Add an FSM exclusion to this scope
      * @param exclusion FSM exclusion to add
@@ -326,6 +673,15 @@ struct EXCLUSION_API ExclusionScope {
         fsmExclusions[exclusion.fsmName].push_back(exclusion);
     }
     
+    /**
+     * @brief Add an FSM exclusion to this scope, taking ownership of its strings
+     * @param exclusion FSM exclusion to move into the scope
+     */
+    void addFsmExclusion(FsmExclusion&& exclusion) {
+        auto& fsms = fsmExclusions[exclusion.fsmName];
+        fsms.push_back(std::move(exclusion));
+    }
+    
     /**
      * @brief Add a condition exclusion to this scope
      * @param exclusion Condition exclusion to add
@@ -335,19 +691,206 @@ struct EXCLUSION_API ExclusionScope {
     }
     
     /**
-     * @brief Get total number of exclusions in this scope
-     * @return Total count of all exclusions
+     * @brief Add a condition exclusion to this scope, taking ownership of its strings
+     * @param exclusion Condition exclusion to move into the scope
      */
-    size_t getTotalExclusionCount() const {
-        size_t total = blockExclusions.size() + conditionExclusions.size();
+    void addConditionExclusion(ConditionExclusion&& exclusion) {
+        auto& slot = conditionExclusions[exclusion.conditionId];
+        slot = std::move(exclusion);
+    }
+    
+    /**
+     * @brief Get the number of toggle exclusions in both toggle stores
+     * @return Toggle exclusion count
+     */
+    size_t getToggleExclusionCount() const {
+        size_t total = toggleTable.getExclusionCount();
         for (const auto& pair : toggleExclusions) {
             total += pair.second.size();
         }
+        return total;
+    }
+    
+    /**
+     * @brief Call a function for every toggle exclusion, toggleExclusions first, then toggleTable
+     * @param function Called with each const ToggleExclusion&
+     */
+    template <typename Function>
+    void forEachToggle(Function&& function) const {
+        for (const auto& [signalName, toggles] : toggleExclusions) {
+            for (const auto& toggle : toggles) {
+                function(toggle);
+            }
+        }
+        toggleTable.forEachToggle(function);
+    }
+    
+    /**
+     * @brief Move all toggle exclusions from toggleExclusions into toggleTable
+     * 
+     * Signals are taken in sorted order so the result does not depend on
+     * hash map iteration order.
+     */
+    void compactToggleExclusions() {
+        std::vector<const std::string*> signalOrder;
+        signalOrder.reserve(toggleExclusions.size());
+        for (const auto& [signalName, toggles] : toggleExclusions) {
+            signalOrder.push_back(&signalName);
+        }
+        std::sort(signalOrder.begin(), signalOrder.end(),
+                  [](const std::string* a, const std::string* b) { return *a < *b; });
+        for (const std::string* signalName : signalOrder) {
+            for (const auto& toggle : toggleExclusions.find(*signalName)->second) {
+                toggleTable.add(toggle);
+            }
+        }
+        toggleExclusions.clear();
+    }
+    
+    /**
+     * @brief Move all rows of toggleTable into toggleExclusions (one entry per toggle)
+     */
+    void expandToggleTable() {
+        for (size_t row = 0; row < toggleTable.getRowCount(); ++row) {
+            auto& toggles = toggleExclusions[toggleTable.signalName(row)];
+            toggleTable.forEachDirection(row, [&](ToggleDirection direction) {
+                toggles.push_back(toggleTable.getToggle(row, direction));
+            });
+        }
+        toggleTable.clear();
+    }
+    
+    /**
+     * @brief Get total number of exclusions in this scope
+     * @return Total count of all exclusions
+     */
+    size_t getTotalExclusionCount() const {
+        size_t total = blockExclusions.size() + conditionExclusions.size() + getToggleExclusionCount();
         for (const auto& pair : fsmExclusions) {
             total += pair.second.size();
         }
         return total;
     }
+    
+    /**
+     * @brief Member-wise equality
+     */
+    bool operator==(const ExclusionScope& other) const = default;
+};
+
+/**
+ * @brief Scope map that counts the insertions and erasures made through it
+ * 
+ * ExclusionData::scopes is public, so scopes can be added or erased without
+ * going through ExclusionData. The change count lets ExclusionData tell in
+ * constant time whether its scope index still describes the map. Every
+ * member that can insert or erase is wrapped; lookups and edits of the
+ * scopes themselves are not counted.
+ */
+class ScopeMap : public ExclusionMap<std::string, ExclusionScope> {
+private:
+    using Base = ExclusionMap<std::string, ExclusionScope>;
+    
+    uint64_t changes_ = 0;          ///< Calls that changed the set of keys
+    
+    /// Counts a change if the map size differs when the wrapped call returns
+    class SizeWatch {
+    private:
+        ScopeMap& map_;
+        size_t before_;
+    public:
+        explicit SizeWatch(ScopeMap& map) : map_(map), before_(map.size()) {}
+        ~SizeWatch() {
+            if (map_.size() != before_) {
+                ++map_.changes_;
+            }
+        }
+    };
+    
+public:
+    using Base::Base;
+    
+    ScopeMap() = default;
+    ScopeMap(const ScopeMap& other) = default;
+    ScopeMap(ScopeMap&& other) = default;
+    
+    ScopeMap& operator=(const ScopeMap& other) {
+        Base::operator=(other);
+        ++changes_;
+        return *this;
+    }
+    
+    ScopeMap& operator=(ScopeMap&& other) {
+        Base::operator=(std::move(other));
+        ++changes_;
+        ++other.changes_;
+        return *this;
+    }
+    
+    /**
+     * @brief Get the number of calls that inserted or erased scopes
+     * @return Change count (only ever compared for equality)
+     */
+    uint64_t getChangeCount() const { return changes_; }
+    
+    template <typename Key>
+    ExclusionScope& operator[](Key&& key) {
+        SizeWatch watch(*this);
+        return Base::operator[](std::forward<Key>(key));
+    }
+    
+    template <typename... Args>
+    decltype(auto) insert(Args&&... args) {
+        SizeWatch watch(*this);
+        return Base::insert(std::forward<Args>(args)...);
+    }
+    
+    template <typename... Args>
+    decltype(auto) insert_or_assign(Args&&... args) {
+        SizeWatch watch(*this);
+        return Base::insert_or_assign(std::forward<Args>(args)...);
+    }
+    
+    template <typename... Args>
+    decltype(auto) emplace(Args&&... args) {
+        SizeWatch watch(*this);
+        return Base::emplace(std::forward<Args>(args)...);
+    }
+    
+    template <typename... Args>
+    decltype(auto) emplace_hint(Args&&... args) {
+        SizeWatch watch(*this);
+        return Base::emplace_hint(std::forward<Args>(args)...);
+    }
+    
+    template <typename... Args>
+    decltype(auto) try_emplace(Args&&... args) {
+        SizeWatch watch(*this);
+        return Base::try_emplace(std::forward<Args>(args)...);
+    }
+    
+    template <typename... Args>
+    decltype(auto) erase(Args&&... args) {
+        SizeWatch watch(*this);
+        return Base::erase(std::forward<Args>(args)...);
+    }
+    
+    template <typename... Args>
+    decltype(auto) extract(Args&&... args) {
+        SizeWatch watch(*this);
+        return Base::extract(std::forward<Args>(args)...);
+    }
+    
+    void clear() {
+        SizeWatch watch(*this);
+        Base::clear();
+    }
+    
+    void swap(ScopeMap& other) {
+        Base::swap(other);
+        ++changes_;
+        ++other.changes_;
+    }
 };
 
 /**
@@ -364,15 +907,186 @@ struct EXCLUSION_API ExclusionData {
     std::string generationDate;     ///< Date when file was generated
     std::string exclusionMode;      ///< Exclusion mode (e.g., "default")
     
+#ifdef EXCLUSION_USE_PMR
+private:
+    /// Arena holding scopes and exclusion containers (declared first so it outlives them)
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> arena_ =
+        std::make_unique<std::pmr::monotonic_buffer_resource>();
+    
+public:
+    /// All scopes (instances and modules) mapped by scope name
+    ScopeMap scopes{arena_.get()};
+#else
     /// All scopes (instances and modules) mapped by scope name
-    std::unordered_map<std::string, ExclusionScope> scopes;
+    ScopeMap scopes;
+#endif
+    
+    /// Shared storage for annotations, net descriptions and toggle signal names
+    StringPool stringPool;
+    
+private:
+    /// Scope names by path segment, pointing at the keys of scopes
+    ScopeTrie scopeIndex_;
+    
+    /// scopes.getChangeCount() when scopeIndex_ last matched the map
+    uint64_t scopeIndexChanges_ = 0;
+    
+    /// Modification count; assignment moves it past the values of both sides
+    struct Generation {
+        uint64_t value = 0;
+        
+        Generation() = default;
+        Generation(const Generation& other) = default;
+        Generation& operator=(const Generation& other) {
+            value = std::max(value, other.value) + 1;
+            return *this;
+        }
+    };
+    Generation generation_;
+    
+    /**
+     * @brief Record that the index matches the map again, if it did before the edit
+     * @param wasCurrent isScopeIndexCurrent() before the edit
+     */
+    void syncScopeIndex(bool wasCurrent) {
+        if (wasCurrent) {
+            scopeIndexChanges_ = scopes.getChangeCount();
+        }
+    }
+    
+    /**
+     * @brief Take over the scope index of data whose scopes were just moved here
+     * @param other Moved-from data (left with no scopes)
+     * @param indexed Whether other's index matched its scopes before the move
+     */
+    void adoptScopeIndex(ExclusionData& other, bool indexed) {
+#ifdef EXCLUSION_USE_PMR
+        // Scopes were moved into new nodes in this object's arena
+        (void)indexed;
+        rebuildScopeIndex();
+        other.scopeIndex_.clear();
+#else
+        // Map nodes, and with them the indexed keys, moved unchanged
+        if (indexed) {
+            scopeIndex_ = std::move(other.scopeIndex_);
+            scopeIndexChanges_ = scopes.getChangeCount();
+        } else {
+            rebuildScopeIndex();
+        }
+        other.scopeIndex_.clear();
+#endif
+        other.scopes.clear();
+        other.scopeIndexChanges_ = other.scopes.getChangeCount();
+    }
     
+public:
     /**
      * @brief Constructor
      * @param filename Original filename
      */
     ExclusionData(const std::string& filename = "") : fileName(filename) {}
     
+    /**
+     * @brief Copy constructor; the scope index is rebuilt over the copy's own keys
+     */
+    ExclusionData(const ExclusionData& other)
+        : fileName(other.fileName), generatedBy(other.generatedBy),
+          formatVersion(other.formatVersion), generationDate(other.generationDate),
+          exclusionMode(other.exclusionMode),
+#ifdef EXCLUSION_USE_PMR
+          scopes(other.scopes, arena_.get()),
+#else
+          scopes(other.scopes),
+#endif
+          stringPool(other.stringPool) {
+        rebuildScopeIndex();
+    }
+    
+    /**
+     * @brief Move constructor
+     * 
+     * Scope nodes move with the map, so the index stays valid, except with
+     * EXCLUSION_USE_PMR, where scopes are moved into this object's own arena
+     * and the index is rebuilt.
+     */
+    ExclusionData(ExclusionData&& other)
+        : fileName(std::move(other.fileName)), generatedBy(std::move(other.generatedBy)),
+          formatVersion(std::move(other.formatVersion)),
+          generationDate(std::move(other.generationDate)),
+          exclusionMode(std::move(other.exclusionMode)),
+#ifdef EXCLUSION_USE_PMR
+          scopes(std::move(other.scopes), arena_.get()),
+#else
+          scopes(std::move(other.scopes)),
+#endif
+          stringPool(std::move(other.stringPool)) {
+        // The moved map keeps other's change count
+        adoptScopeIndex(other, other.scopeIndexChanges_ == scopes.getChangeCount());
+    }
+    
+    ExclusionData& operator=(const ExclusionData& other) {
+        if (this != &other) {
+            fileName = other.fileName;
+            generatedBy = other.generatedBy;
+            formatVersion = other.formatVersion;
+            generationDate = other.generationDate;
+            exclusionMode = other.exclusionMode;
+#ifdef EXCLUSION_USE_PMR
+            releaseScopes();
+#endif
+            scopes = other.scopes;
+            stringPool = other.stringPool;
+            generation_ = other.generation_;
+            rebuildScopeIndex();
+        }
+        return *this;
+    }
+    
+    ExclusionData& operator=(ExclusionData&& other) {
+        if (this != &other) {
+            fileName = std::move(other.fileName);
+            generatedBy = std::move(other.generatedBy);
+            formatVersion = std::move(other.formatVersion);
+            generationDate = std::move(other.generationDate);
+            exclusionMode = std::move(other.exclusionMode);
+#ifdef EXCLUSION_USE_PMR
+            releaseScopes();
+#endif
+            bool indexed = other.isScopeIndexCurrent();
+            scopes = std::move(other.scopes);
+            stringPool = std::move(other.stringPool);
+            generation_ = other.generation_;
+            adoptScopeIndex(other, indexed);
+            other.markModified();
+        }
+        return *this;
+    }
+    
+#ifdef EXCLUSION_USE_PMR
+    /**
+     * @brief Get the arena that scopes and exclusion containers allocate from
+     * @return Memory resource owned by this object
+     */
+    std::pmr::memory_resource* getMemoryResource() const { return arena_.get(); }
+    
+    /**
+     * @brief Drop all scopes and hand the whole arena back at once
+     * 
+     * Exclusion destructors still run, but no container node is freed
+     * individually; the arena returns its blocks in one step.
+     */
+    void releaseScopes() {
+        // Nothing may still own arena memory when it is released, and the
+        // new map's buckets must come from the arena after the release
+        scopeIndex_.clear();
+        std::destroy_at(&scopes);
+        arena_->release();
+        std::construct_at(&scopes, arena_.get());
+        scopeIndexChanges_ = scopes.getChangeCount();
+        markModified();
+    }
+#endif
+    
     /**
      * @brief Add or get a scope (instance or module)
      * @param scopeName Name of the scope
@@ -383,11 +1097,17 @@ struct EXCLUSION_API ExclusionData {
     ExclusionScope& getOrCreateScope(const std::string& scopeName, 
                                      const std::string& checksum = "", 
                                      bool isModule = false) {
-        auto it = scopes.find(scopeName);
-        if (it == scopes.end()) {
-            scopes[scopeName] = ExclusionScope(scopeName, checksum, isModule);
+        // The caller may edit the scope through the returned reference
+        markModified();
+        
+        // One hash and lookup; the scope is only constructed when it is new
+        bool indexed = isScopeIndexCurrent();
+        auto [it, inserted] = scopes.try_emplace(scopeName, scopeName, checksum, isModule);
+        if (inserted) {
+            scopeIndex_.insert(it->first);
+            syncScopeIndex(indexed);
         }
-        return scopes[scopeName];
+        return it->second;
     }
     
     /**
@@ -396,9 +1116,21 @@ struct EXCLUSION_API ExclusionData {
      * @param overwriteExisting If true, overwrite existing exclusions
      */
     void merge(const ExclusionData& other, bool overwriteExisting = false) {
+        markModified();
+        
+        StringPool::Remap remap;
+        stringPool.absorb(other.stringPool, remap);
+        
+        bool indexed = isScopeIndexCurrent();
         for (const auto& [scopeName, scope] : other.scopes) {
             if (scopes.find(scopeName) == scopes.end() || overwriteExisting) {
-                scopes[scopeName] = scope;
+                auto [it, inserted] = scopes.try_emplace(scopeName);
+                if (inserted) {
+                    scopeIndex_.insert(it->first);
+                }
+                auto& target = it->second;
+                target = scope;
+                rehomeStrings(target, remap);
             } else {
                 // Merge individual exclusions
                 auto& existingScope = scopes[scopeName];
@@ -416,6 +1148,7 @@ struct EXCLUSION_API ExclusionData {
                         existingScope.addToggleExclusion(toggle);
                     }
                 }
+                existingScope.toggleTable.append(scope.toggleTable);
                 
                 // Merge FSM exclusions
                 for (const auto& [fsmName, fsms] : scope.fsmExclusions) {
@@ -430,22 +1163,223 @@ struct EXCLUSION_API ExclusionData {
                         existingScope.conditionExclusions[condId] = condition;
                     }
                 }
+                
+                rehomeStrings(existingScope, remap);
             }
         }
+        syncScopeIndex(indexed);
+    }
+    
+    /**
+     * @brief Append another ExclusionData as if it had been parsed after this one
+     * 
+     * Unlike merge(), this reproduces the result of parsing both sources into
+     * the same ExclusionData in sequence: header fields and keyed exclusions
+     * (block, condition) from other replace existing ones, toggle and FSM
+     * exclusions are appended in order, and an existing scope keeps its
+     * checksum and type.
+     * 
+     * @param other ExclusionData to append (left in a valid but unspecified state)
+     */
+    void append(ExclusionData&& other) {
+        markModified();
+        other.markModified();
+        
+        if (!other.fileName.empty()) fileName = std::move(other.fileName);
+        if (!other.generatedBy.empty()) generatedBy = std::move(other.generatedBy);
+        if (!other.formatVersion.empty()) formatVersion = std::move(other.formatVersion);
+        if (!other.generationDate.empty()) generationDate = std::move(other.generationDate);
+        if (!other.exclusionMode.empty()) exclusionMode = std::move(other.exclusionMode);
+        
+        // Share text with this data's pool; only duplicated texts need their handles updated
+        StringPool::Remap remap;
+        stringPool.absorb(other.stringPool, remap);
+        other.stringPool.clear();
+        
+        bool indexed = isScopeIndexCurrent();
+        for (auto& [scopeName, scope] : other.scopes) {
+            rehomeStrings(scope, remap);
+            
+            auto it = scopes.find(scopeName);
+            if (it == scopes.end()) {
+                auto added = scopes.emplace(scopeName, std::move(scope)).first;
+                scopeIndex_.insert(added->first);
+                continue;
+            }
+            
+            auto& existingScope = it->second;
+            for (auto& [blockId, block] : scope.blockExclusions) {
+                existingScope.blockExclusions[blockId] = std::move(block);
+            }
+            for (auto& [signalName, toggles] : scope.toggleExclusions) {
+                auto& target = existingScope.toggleExclusions[signalName];
+                target.insert(target.end(), std::make_move_iterator(toggles.begin()),
+                              std::make_move_iterator(toggles.end()));
+            }
+            existingScope.toggleTable.append(scope.toggleTable);
+            for (auto& [fsmName, fsms] : scope.fsmExclusions) {
+                auto& target = existingScope.fsmExclusions[fsmName];
+                target.insert(target.end(), std::make_move_iterator(fsms.begin()),
+                              std::make_move_iterator(fsms.end()));
+            }
+            for (auto& [condId, condition] : scope.conditionExclusions) {
+                existingScope.conditionExclusions[condId] = std::move(condition);
+            }
+        }
+        syncScopeIndex(indexed);
+        other.scopeIndex_.clear();
+        other.scopes.clear();
+        other.scopeIndexChanges_ = other.scopes.getChangeCount();
     }
     
     /**
      * @brief Clear all data (reset to empty state)
      */
     void clear() {
+        markModified();
         fileName.clear();
         generatedBy.clear();
         formatVersion.clear();
         generationDate.clear();
         exclusionMode.clear();
+#ifdef EXCLUSION_USE_PMR
+        releaseScopes();
+#else
+        scopeIndex_.clear();
         scopes.clear();
+        scopeIndexChanges_ = scopes.getChangeCount();
+#endif
+        stringPool.clear();
     }
     
+    /**
+     * @brief Get the modification count
+     * 
+     * Changes on every edit made through this object's methods (including
+     * getOrCreateScope(), whose result may be edited), on every record an
+     * ExclusionDataBuilder stores, and on markModified(). Caches derived from
+     * the data, such as ExclusionDataManager's search indexes, compare it to
+     * decide whether to rebuild.
+     * 
+     * @return Value that differs from any earlier one after a change
+     */
+    uint64_t getGeneration() const {
+        return generation_.value;
+    }
+    
+    /**
+     * @brief Record an edit made directly through the public containers
+     * 
+     * Call after changing the exclusions of a scope found through the
+     * scopes map, so caches derived from the data see the change.
+     */
+    void markModified() {
+        ++generation_.value;
+    }
+    
+    /**
+     * @brief Get the hierarchical index over the scope names
+     * 
+     * The index follows scopes added through getOrCreateScope(), merge() and
+     * append() and erased through eraseScope(). Scopes inserted into or
+     * erased from the scopes map directly bypass it; call rebuildScopeIndex()
+     * afterwards. The index points at the map's keys, so use it only while
+     * isScopeIndexCurrent() is true.
+     * 
+     * @return Index of scope names by path segment
+     */
+    const ScopeTrie& getScopeIndex() const {
+        return scopeIndex_;
+    }
+    
+    /**
+     * @brief Check that the scope index covers exactly the scopes in the map
+     * 
+     * Constant time: compares the map's change count with the one recorded
+     * when the index last matched it, so any direct insertion or erasure
+     * (even an erase followed by an insert) is detected.
+     * 
+     * @return True if the index can answer queries for this data
+     */
+    bool isScopeIndexCurrent() const {
+        return scopeIndexChanges_ == scopes.getChangeCount();
+    }
+    
+    /**
+     * @brief Re-index all scopes after direct edits to the scopes map
+     */
+    void rebuildScopeIndex() {
+        scopeIndex_.clear();
+        for (const auto& [scopeName, scope] : scopes) {
+            scopeIndex_.insert(scopeName);
+        }
+        scopeIndexChanges_ = scopes.getChangeCount();
+    }
+    
+    /**
+     * @brief Remove a scope and all of its exclusions, keeping the scope index current
+     * @param scopeName Name of the scope
+     * @return True if the scope existed
+     */
+    bool eraseScope(const std::string& scopeName) {
+        auto it = scopes.find(scopeName);
+        if (it == scopes.end()) {
+            return false;
+        }
+        
+        bool indexed = isScopeIndexCurrent();
+        scopeIndex_.erase(it->first);
+        scopes.erase(it);
+        syncScopeIndex(indexed);
+        markModified();
+        return true;
+    }
+    
+    /**
+     * @brief Point a scope's pooled fields at this data's copies of their text
+     * 
+     * Used after StringPool::absorb() when exclusions arrive from another
+     * ExclusionData, so equal text from different sources is stored once.
+     * 
+     * @param scope Scope whose annotations, net descriptions and toggle signal names to update
+     * @param remap Blocks to replace, as filled by StringPool::absorb()
+     */
+    static void rehomeStrings(ExclusionScope& scope, const StringPool::Remap& remap) {
+        if (remap.empty()) {
+            return;
+        }
+        for (auto& [blockId, block] : scope.blockExclusions) {
+            StringPool::rehome(block.annotation, remap);
+        }
+        for (auto& [signalName, toggles] : scope.toggleExclusions) {
+            for (auto& toggle : toggles) {
+                StringPool::rehome(toggle.signalName, remap);
+                StringPool::rehome(toggle.netDescription, remap);
+                StringPool::rehome(toggle.annotation, remap);
+            }
+        }
+        scope.toggleTable.rehomeStrings(remap);
+        for (auto& [fsmName, fsms] : scope.fsmExclusions) {
+            for (auto& fsm : fsms) {
+                StringPool::rehome(fsm.annotation, remap);
+            }
+        }
+        for (auto& [condId, condition] : scope.conditionExclusions) {
+            StringPool::rehome(condition.annotation, remap);
+        }
+    }
+    
+    /**
+     * @brief Build an immutable, flat snapshot for read-only use
+     * 
+     * Defined with FrozenExclusionData (include ExclusionFrozenData.h to call it).
+     * 
+     * @return Snapshot independent of this object
+     * @throws std::length_error If the data is too large for the snapshot's
+     *         32-bit offsets and indexes
+     */
+    FrozenExclusionData freeze() const;
+    
     /**
      * @brief Get total number of scopes
      * @return Number of scopes (instances + modules)
@@ -481,9 +1415,7 @@ struct EXCLUSION_API ExclusionData {
             counts[ExclusionType::BLOCK] += scope.blockExclusions.size();
             counts[ExclusionType::CONDITION] += scope.conditionExclusions.size();
             
-            for (const auto& [signalName, toggles] : scope.toggleExclusions) {
-                counts[ExclusionType::TOGGLE] += toggles.size();
-            }
+            counts[ExclusionType::TOGGLE] += scope.getToggleExclusionCount();
             
             for (const auto& [fsmName, fsms] : scope.fsmExclusions) {
                 counts[ExclusionType::FSM] += fsms.size();
@@ -492,6 +1424,15 @@ struct EXCLUSION_API ExclusionData {
         
         return counts;
     }
+    
+    /**
+     * @brief Equality of metadata and scopes (the string pool is storage, not content)
+     */
+    bool operator==(const ExclusionData& other) const {
+        return fileName == other.fileName && generatedBy == other.generatedBy &&
+               formatVersion == other.formatVersion && generationDate == other.generationDate &&
+               exclusionMode == other.exclusionMode && scopes == other.scopes;
+    }
 };
 
 /**
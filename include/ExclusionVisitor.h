@@ -0,0 +1,275 @@
+/**
+ * @file ExclusionVisitor.h
+ * @brief Event-driven (SAX-style) callbacks for streaming exclusion parsing
+ *
+ * This file contains the ExclusionVisitor interface through which
+ * ExclusionParser reports every record it recognizes, and the
+ * ExclusionDataBuilder visitor that assembles those events into ExclusionData.
+ *
+ * Tools that only count, filter or forward exclusions can implement their own
+ * visitor and call the visitor overloads of ExclusionParser::parseFile,
+ * parseString or parseStream. No ExclusionData is built in that case, and
+ * parseStream then reads line by line so memory use stays constant no matter
+ * how large the input is.
+ *
+ * @author AMD Advanced Micro Devices Inc. - Verification Infrastructure Team
+ * @version 2.0.0
+ * @date September 13, 2025
+ * @copyright (c) 2025 Advanced Micro Devices Inc. All rights reserved.
+ *
+ * @note All std::string_view arguments are only valid for the duration of the
+ *       callback. Copy anything that must outlive it.
+ */
+
+#ifndef EXCLUSION_VISITOR_H
+#define EXCLUSION_VISITOR_H
+
+#include "ExclusionTypes.h"
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace ExclusionParser {
+
+/**
+ * @brief Header fields recognized in the leading comment block
+ */
+enum class HeaderField {
+    GENERATED_BY,       ///< "// Generated By User: ..."
+    FORMAT_VERSION,     ///< "// Format Version: ..."
+    GENERATION_DATE,    ///< "// Date: ..."
+    EXCLUSION_MODE      ///< "// ExclMode: ..."
+};
+
+/**
+ * @brief Scope (INSTANCE or MODULE) in effect for a record
+ */
+struct ScopeView {
+    std::string_view name;          ///< Hierarchical instance path or module name
+    std::string_view checksum;      ///< Most recent CHECKSUM value
+    bool isModule = false;          ///< True for MODULE, false for INSTANCE
+};
+
+/**
+ * @brief Block exclusion event
+ */
+struct BlockView {
+    ScopeView scope;                ///< Enclosing scope
+    std::string_view blockId;       ///< Block identifier
+    std::string_view checksum;      ///< Block checksum
+    std::string_view sourceCode;    ///< Excluded source code
+    std::string_view annotation;    ///< Annotation attached to this record (may be empty)
+};
+
+/**
+ * @brief Toggle exclusion event
+ */
+struct ToggleView {
+    ScopeView scope;                ///< Enclosing scope
+    ToggleDirection direction = ToggleDirection::BOTH; ///< Excluded transition direction
+    std::string_view signalName;    ///< Signal name without any bit select
+    std::string_view range;         ///< Part-select such as "[37:34]" (empty if none)
+    std::optional<int> bitIndex;    ///< Single-bit index, if present
+    std::string_view netDescription; ///< Quoted net description
+    std::string_view annotation;    ///< Annotation attached to this record (may be empty)
+};
+
+/**
+ * @brief FSM state exclusion event
+ */
+struct FsmView {
+    ScopeView scope;                ///< Enclosing scope
+    std::string_view fsmName;       ///< FSM (state variable) name
+    std::string_view checksum;      ///< FSM checksum
+    std::string_view annotation;    ///< Annotation attached to this record (may be empty)
+};
+
+/**
+ * @brief FSM transition exclusion event
+ */
+struct TransitionView {
+    ScopeView scope;                ///< Enclosing scope
+    std::string_view fromState;     ///< Source state
+    std::string_view toState;       ///< Destination state
+    std::string_view transitionId;  ///< Quoted transition encoding, e.g. "0->1"
+    std::string_view annotation;    ///< Annotation attached to this record (may be empty)
+};
+
+/**
+ * @brief Condition exclusion event
+ */
+struct ConditionView {
+    ScopeView scope;                ///< Enclosing scope
+    std::string_view conditionId;   ///< Condition identifier
+    std::string_view checksum;      ///< Condition checksum
+    std::string_view expression;    ///< Boolean expression
+    std::string_view parameters;    ///< Trailing expression parameters
+    std::string_view coverage;      ///< Coverage specification without parentheses
+    std::string_view annotation;    ///< Annotation attached to this record (may be empty)
+};
+
+/**
+ * @brief Receiver of parse events
+ *
+ * Every callback has an empty default implementation, so a visitor only
+ * overrides the events it cares about. Exclusion events are only raised
+ * inside a scope; exclusion lines before the first INSTANCE/MODULE are
+ * skipped, as they always have been.
+ *
+ * Usage Example:
+ * @code
+ * struct ToggleCounter : ExclusionVisitor {
+ *     size_t toggles = 0;
+ *     void onToggle(const ToggleView&) override { toggles++; }
+ * };
+ *
+ * ToggleCounter counter;
+ * ExclusionParser parser;
+ * std::ifstream input("huge.el");
+ * parser.parseStream(input, counter);
+ * @endcode
+ */
+class EXCLUSION_API ExclusionVisitor {
+public:
+    virtual ~ExclusionVisitor() = default;
+
+    /**
+     * @brief Header field found in a comment line
+     * @param field Which header field
+     * @param value Field value
+     */
+    virtual void onHeader(HeaderField field, std::string_view value) { (void)field; (void)value; }
+
+    /**
+     * @brief CHECKSUM line
+     * @param checksum Checksum value without quotes
+     */
+    virtual void onChecksum(std::string_view checksum) { (void)checksum; }
+
+    /**
+     * @brief INSTANCE or MODULE line
+     * @param scope New current scope
+     */
+    virtual void onScope(const ScopeView& scope) { (void)scope; }
+
+    /**
+     * @brief ANNOTATION or ANNOTATION_BEGIN line
+     * @param text Annotation text without quotes
+     */
+    virtual void onAnnotation(std::string_view text) { (void)text; }
+
+    /**
+     * @brief ANNOTATION_END line
+     */
+    virtual void onAnnotationEnd() {}
+
+    /**
+     * @brief Block exclusion
+     * @param block Block record
+     */
+    virtual void onBlock(const BlockView& block) { (void)block; }
+
+    /**
+     * @brief Toggle exclusion
+     * @param toggle Toggle record
+     */
+    virtual void onToggle(const ToggleView& toggle) { (void)toggle; }
+
+    /**
+     * @brief FSM state exclusion
+     * @param fsm FSM record
+     */
+    virtual void onFsm(const FsmView& fsm) { (void)fsm; }
+
+    /**
+     * @brief FSM transition exclusion
+     * @param transition Transition record
+     */
+    virtual void onTransition(const TransitionView& transition) { (void)transition; }
+
+    /**
+     * @brief Condition exclusion
+     * @param condition Condition record
+     */
+    virtual void onCondition(const ConditionView& condition) { (void)condition; }
+
+    /**
+     * @brief Line that matched no known record format
+     * @param line Trimmed line
+     * @param lineNumber 1-based line number
+     */
+    virtual void onUnrecognized(std::string_view line, size_t lineNumber) { (void)line; (void)lineNumber; }
+};
+
+/**
+ * @brief Visitor that stores every event in an ExclusionData
+ *
+ * This is the visitor ExclusionParser uses for its own data-building parse
+ * methods. Fields are copied only here, when a record is finally stored;
+ * annotations, net descriptions and toggle signal names are interned in
+ * the data's StringPool rather than copied per record.
+ *
+ * The scope is looked up once per onScope and kept as a pointer for the
+ * records that follow, so exclusion lines do not re-hash the (often long)
+ * hierarchical scope name. Pointers into ExclusionData::scopes stay valid
+ * when the map rehashes, since unordered_map never moves its elements. The
+ * same holds for the cached toggle list of the bus whose bits are being read.
+ *
+ * With columnar toggles, toggles go to ExclusionScope::toggleTable instead
+ * of toggleExclusions, which folds each 1to0/0to1 pair into one row.
+ */
+class EXCLUSION_API ExclusionDataBuilder : public ExclusionVisitor {
+public:
+    /**
+     * @brief Constructor
+     * @param data Data to add records to (must outlive the builder)
+     * @param columnarToggles If true, store toggles in each scope's toggleTable
+     */
+    explicit ExclusionDataBuilder(ExclusionData& data, bool columnarToggles = false);
+
+    void onHeader(HeaderField field, std::string_view value) override;
+    void onScope(const ScopeView& scope) override;
+    void onBlock(const BlockView& block) override;
+    void onToggle(const ToggleView& toggle) override;
+    void onFsm(const FsmView& fsm) override;
+    void onTransition(const TransitionView& transition) override;
+    void onCondition(const ConditionView& condition) override;
+
+private:
+    ExclusionData& data_;           ///< Destination data
+    bool columnarToggles_;          ///< Store toggles in ExclusionScope::toggleTable
+    std::string scopeKey_;          ///< Name of the cached scope (also the lookup key buffer)
+    std::string checksumKey_;       ///< Reused buffer for scope checksums
+    std::string signalKey_;         ///< Reused buffer for part-select signal names
+    ExclusionScope* cachedScope_;   ///< Scope named scopeKey_, or nullptr before the first lookup
+    
+    // Most recent interned texts and toggle list, reused while records repeat them
+    InternedString lastSignal_;                     ///< Signal of the most recent toggle
+    InternedString lastNetDescription_;             ///< Net description of the most recent toggle
+    InternedString lastAnnotation_;                 ///< Annotation of the most recent record
+    ExclusionScope* lastToggleScope_;               ///< Scope of the most recent toggle
+    ExclusionVector<ToggleExclusion>* lastToggles_; ///< Toggle list of lastSignal_ in lastToggleScope_
+
+    /**
+     * @brief Get or create the scope a record belongs to
+     *
+     * Returns the cached scope when the name matches, which is a length check
+     * and a compare rather than a hash and map lookup.
+     *
+     * @param scope Scope in effect for the record
+     * @return Stored scope
+     */
+    ExclusionScope& resolveScope(const ScopeView& scope);
+    
+    /**
+     * @brief Intern a text through the data's StringPool, reusing the previous result
+     * @param last Previous result for this field (updated)
+     * @param text Text to intern
+     * @return Shared handle for text
+     */
+    const InternedString& intern(InternedString& last, std::string_view text);
+};
+
+} // namespace ExclusionParser
+
+#endif // EXCLUSION_VISITOR_H
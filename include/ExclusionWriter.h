@@ -38,8 +38,12 @@
 
 #include "ExclusionTypes.h"
 #include "ExclusionData.h"
+#include "ExclusionOutputBuffer.h"
 #include <fstream>
+#include <functional>
+#include <future>
 #include <memory>
+#include <optional>
 
 namespace ExclusionParser {
 
@@ -51,12 +55,15 @@ namespace ExclusionParser {
 struct EXCLUSION_API WriterConfig {
     bool includeComments;           ///< Include file header comments
     bool includeAnnotations;        ///< Include exclusion annotations
-    bool sortExclusions;           ///< Sort exclusions within each scope
+    bool sortExclusions;           ///< Sort scopes and exclusions by name, numbers by value ("2" before "161")
     bool generateChecksums;        ///< Generate checksums for scopes
     bool preserveOrder;            ///< Preserve original order from input
     std::string indentation;       ///< Indentation string (default: no indent)
     std::string lineEnding;        ///< Line ending style ("\n" or "\r\n")
     bool compactFormat;            ///< Use compact format (minimal whitespace)
+    size_t threadCount;            ///< Worker threads formatting scopes (1 = serial, 0 = hardware concurrency)
+    bool atomicWrite;              ///< Write files beside their target and rename into place when complete
+    bool syncToDisk;               ///< Flush written files (and, with atomicWrite, the rename) to disk
     
     /**
      * @brief Default constructor with sensible defaults
@@ -64,7 +71,7 @@ struct EXCLUSION_API WriterConfig {
     WriterConfig() 
         : includeComments(true), includeAnnotations(true), sortExclusions(false),
           generateChecksums(true), preserveOrder(true), indentation(""),
-          lineEnding("\n"), compactFormat(false) {}
+          lineEnding("\n"), compactFormat(false), threadCount(1), atomicWrite(false), syncToDisk(false) {}
 };
 
 /**
@@ -101,6 +108,55 @@ struct EXCLUSION_API WriteResult {
     std::string getSummary() const;
 };
 
+/**
+ * @brief Filtered, non-owning view of exclusion data for writing
+ * 
+ * Selects scopes (by name and/or predicate) and exclusion types of a
+ * borrowed ExclusionData without copying any of it. The writer iterates
+ * the view directly, so splitting one data set into several files costs
+ * one pass per file and no copies of the data.
+ * 
+ * Usage Example:
+ * @code
+ * ExclusionDataView view(data);
+ * view.typeMask = ExclusionDataView::typeBit(ExclusionType::TOGGLE);
+ * view.scopeFilter = [](const std::string& name, const ExclusionScope&) {
+ *     return name.starts_with("tb.dma.");
+ * };
+ * writer.writeFile("dma_toggles.el", view);
+ * @endcode
+ */
+struct EXCLUSION_API ExclusionDataView {
+    static constexpr unsigned ALL_TYPES = 0xF;  ///< typeMask selecting every exclusion type
+    
+    const ExclusionData* data;                              ///< Viewed data (must outlive the view)
+    std::optional<std::vector<std::string>> scopeNames;     ///< Scopes to include, in this order (nullopt = all)
+    unsigned typeMask;                                      ///< typeBit() of each exclusion type to include
+    
+    /// Optional further selection of scopes (called with the scope name and scope)
+    std::function<bool(const std::string&, const ExclusionScope&)> scopeFilter;
+    
+    /**
+     * @brief Construct a view of all scopes and types of the data
+     * @param viewed Data to view
+     */
+    explicit ExclusionDataView(const ExclusionData& viewed) : data(&viewed), typeMask(ALL_TYPES) {}
+    
+    /**
+     * @brief Get the typeMask bit of an exclusion type
+     * @param type Exclusion type
+     * @return Mask bit
+     */
+    static unsigned typeBit(ExclusionType type) { return 1u << static_cast<unsigned>(type); }
+    
+    /**
+     * @brief Check whether an exclusion type is included
+     * @param type Exclusion type
+     * @return True if typeMask selects it
+     */
+    bool includesType(ExclusionType type) const { return (typeMask & typeBit(type)) != 0; }
+};
+
 /**
  * @brief Main writer class for exclusion coverage files
  * 
@@ -130,113 +186,207 @@ struct EXCLUSION_API WriteResult {
  * @endcode
  */
 class EXCLUSION_API ExclusionWriter {
+    friend class ExclusionStreamWriter;     ///< Reuses the line formatters
+    
 private:
     WriterConfig config_;                   ///< Writer configuration
     
+    /// Entry of ExclusionData::scopes
+    using ScopeEntry = std::pair<const std::string, ExclusionScope>;
+    
     // Helper methods for writing different sections
+    /**
+     * @brief Format a view of the data into a buffer
+     * @param buffer Output buffer (flushed as it fills if it has a sink)
+     * @param view Scopes and types to write
+     * @param scopeOrder The view's scopes from selectScopes()
+     * @return Write result with statistics
+     */
+    WriteResult writeToBuffer(OutputBuffer& buffer, const ExclusionDataView& view,
+                              const std::vector<const ScopeEntry*>& scopeOrder) const;
+    
+    /**
+     * @brief Estimate the output size of already selected scopes
+     * @param view Scopes and types to write
+     * @param scopeOrder The view's scopes from selectScopes()
+     * @return Estimated size in bytes
+     */
+    size_t estimateOutputSize(const ExclusionDataView& view,
+                              const std::vector<const ScopeEntry*>& scopeOrder) const;
+    
+    /**
+     * @brief Get the scopes of a view in output order
+     * 
+     * The view's scopeNames order (duplicates and unknown names dropped) or
+     * the data's order, sorted by name with sortExclusions.
+     * 
+     * @param view Data view
+     * @return Pointers to the selected scope entries
+     */
+    std::vector<const ScopeEntry*> selectScopes(const ExclusionDataView& view) const;
+    
+    /**
+     * @brief Format scopes on a worker pool and append them in order
+     * 
+     * Runs of consecutive scopes are formatted into per-task buffers and
+     * appended to the output in the given order, so the text is identical
+     * to formatting them one after another. Only a few tasks run ahead of
+     * the one being appended, which bounds the memory held.
+     * 
+     * @param buffer Output buffer
+     * @param scopeOrder Scopes in output order
+     * @param typeMask Exclusion types to write (see ExclusionDataView)
+     * @param threadCount Number of workers
+     * @return Number of lines written
+     */
+    size_t writeScopesParallel(OutputBuffer& buffer, const std::vector<const ScopeEntry*>& scopeOrder,
+                               unsigned typeMask, size_t threadCount) const;
+    
+    /**
+     * @brief Start writeFile() on a background thread with a given configuration
+     * @param filename Path to output file
+     * @param data Exclusion data to write
+     * @param config Configuration of the background writer
+     * @return Future of the write result
+     */
+    std::future<WriteResult> startFileWrite(const std::string& filename, std::shared_ptr<const ExclusionData> data,
+                                            const WriterConfig& config) const;
+    
     /**
      * @brief Write file header
-     * @param stream Output stream
+     * @param buffer Output buffer
      * @param data Exclusion data
      * @return Number of lines written
      */
-    size_t writeHeader(std::ostream& stream, const ExclusionData& data) const;
+    size_t writeHeader(OutputBuffer& buffer, const ExclusionData& data) const;
     
     /**
      * @brief Write a scope (instance or module)
-     * @param stream Output stream
+     * @param buffer Output buffer
      * @param scopeName Name of the scope
      * @param scope Scope data
+     * @param typeMask Exclusion types to write (see ExclusionDataView)
      * @return Number of lines written
      */
-    size_t writeScope(std::ostream& stream, const std::string& scopeName, 
-                     const ExclusionScope& scope) const;
+    size_t writeScope(OutputBuffer& buffer, const std::string& scopeName, 
+                     const ExclusionScope& scope, unsigned typeMask) const;
     
     /**
      * @brief Write block exclusions for a scope
-     * @param stream Output stream
+     * @param buffer Output buffer
      * @param scope Scope containing block exclusions
      * @return Number of lines written
      */
-    size_t writeBlockExclusions(std::ostream& stream, const ExclusionScope& scope) const;
+    size_t writeBlockExclusions(OutputBuffer& buffer, const ExclusionScope& scope) const;
     
     /**
      * @brief Write toggle exclusions for a scope
-     * @param stream Output stream
+     * @param buffer Output buffer
      * @param scope Scope containing toggle exclusions
      * @return Number of lines written
      */
-    size_t writeToggleExclusions(std::ostream& stream, const ExclusionScope& scope) const;
+    size_t writeToggleExclusions(OutputBuffer& buffer, const ExclusionScope& scope) const;
+    
+    /**
+     * @brief Write the Block line of one block exclusion (without its annotation)
+     * @param buffer Output buffer
+     * @param blockId Block ID
+     * @param block Block exclusion
+     * @return Number of lines written
+     */
+    size_t writeBlockLine(OutputBuffer& buffer, std::string_view blockId, const BlockExclusion& block) const;
+    
+    /**
+     * @brief Write the Toggle line of one toggle exclusion (without its annotation)
+     * @param buffer Output buffer
+     * @param direction Toggle direction
+     * @param signalName Signal name
+     * @param bitIndex Bit index, if any
+     * @param netDescription Net description
+     * @return Number of lines written
+     */
+    size_t writeToggleLine(OutputBuffer& buffer, ToggleDirection direction, std::string_view signalName,
+                           std::optional<int> bitIndex, std::string_view netDescription) const;
+    
+    /**
+     * @brief Write the Fsm or Transition line of one FSM exclusion (without its annotation)
+     * @param buffer Output buffer
+     * @param fsm FSM exclusion
+     * @return Number of lines written
+     */
+    size_t writeFsmLine(OutputBuffer& buffer, const FsmExclusion& fsm) const;
+    
+    /**
+     * @brief Write the Condition line of one condition exclusion (without its annotation)
+     * @param buffer Output buffer
+     * @param conditionId Condition ID
+     * @param condition Condition exclusion
+     * @return Number of lines written
+     */
+    size_t writeConditionLine(OutputBuffer& buffer, std::string_view conditionId,
+                              const ConditionExclusion& condition) const;
     
     /**
      * @brief Write FSM exclusions for a scope
-     * @param stream Output stream
+     * @param buffer Output buffer
      * @param scope Scope containing FSM exclusions
      * @return Number of lines written
      */
-    size_t writeFsmExclusions(std::ostream& stream, const ExclusionScope& scope) const;
+    size_t writeFsmExclusions(OutputBuffer& buffer, const ExclusionScope& scope) const;
     
     /**
      * @brief Write condition exclusions for a scope
-     * @param stream Output stream
+     * @param buffer Output buffer
      * @param scope Scope containing condition exclusions
      * @return Number of lines written
      */
-    size_t writeConditionExclusions(std::ostream& stream, const ExclusionScope& scope) const;
+    size_t writeConditionExclusions(OutputBuffer& buffer, const ExclusionScope& scope) const;
     
     /**
      * @brief Write an annotation if present
-     * @param stream Output stream
+     * @param buffer Output buffer
      * @param annotation Annotation text
+     * @param keyword Line keyword (ANNOTATION or ANNOTATION_BEGIN)
      * @return Number of lines written
      */
-    size_t writeAnnotation(std::ostream& stream, const std::string& annotation) const;
+    size_t writeAnnotation(OutputBuffer& buffer, std::string_view annotation,
+                           std::string_view keyword = "ANNOTATION") const;
     
     /**
      * @brief Write checksum line
-     * @param stream Output stream
+     * @param buffer Output buffer
      * @param checksum Checksum value
      * @return Number of lines written
      */
-    size_t writeChecksum(std::ostream& stream, const std::string& checksum) const;
-    
-    /**
-     * @brief Escape string for output (handle quotes, etc.)
-     * @param str String to escape
-     * @return Escaped string
-     */
-    std::string escapeString(const std::string& str) const;
-    
-    /**
-     * @brief Format toggle direction for output
-     * @param direction Toggle direction
-     * @return Formatted direction string
-     */
-    std::string formatToggleDirection(ToggleDirection direction) const;
+    size_t writeChecksum(OutputBuffer& buffer, std::string_view checksum) const;
     
     /**
      * @brief Generate checksum for scope
      * @param scope Scope to generate checksum for
+     * @param typeMask Exclusion types that are written (see ExclusionDataView)
      * @return Generated checksum string
      */
-    std::string generateScopeChecksum(const ExclusionScope& scope) const;
+    std::string generateScopeChecksum(const ExclusionScope& scope,
+                                      unsigned typeMask = ExclusionDataView::ALL_TYPES) const;
     
     /**
-     * @brief Get sorted exclusion order
-     * @param scope Scope to sort
-     * @return Vectors of sorted keys for each exclusion type
+     * @brief Start a line (writes the configured indentation)
+     * @param buffer Output buffer
      */
-    std::tuple<std::vector<std::string>, std::vector<std::string>, 
-               std::vector<std::string>, std::vector<std::string>> 
-    getSortedOrder(const ExclusionScope& scope) const;
+    void beginLine(OutputBuffer& buffer) const {
+        buffer.append(config_.indentation);
+    }
     
     /**
-     * @brief Write line with proper formatting
-     * @param stream Output stream
-     * @param line Line to write
+     * @brief End a line (writes the configured line ending, flushing a full buffer)
+     * @param buffer Output buffer
      * @return Number of lines written (always 1)
      */
-    size_t writeLine(std::ostream& stream, const std::string& line) const;
+    size_t endLine(OutputBuffer& buffer) const {
+        buffer.append(config_.lineEnding);
+        buffer.flushIfFull();
+        return 1;
+    }
     
     /**
      * @brief Add warning to current write result
@@ -269,29 +419,112 @@ public:
     
     /**
      * @brief Write exclusion data to a file
+     * 
+     * With WriterConfig::atomicWrite the text goes to a temporary file in
+     * the same directory, which is renamed over filename only once it is
+     * complete: readers see the old file or the new one, never a truncated
+     * one, and a failed write leaves filename untouched.
+     * 
      * @param filename Path to output file
      * @param data Exclusion data to write
      * @return Write result with success/failure and statistics
      */
     WriteResult writeFile(const std::string& filename, const ExclusionData& data) const;
     
+    /**
+     * @brief Write a filtered view of exclusion data to a file
+     * @param filename Path to output file
+     * @param view Scopes and types to write
+     * @return Write result with success/failure and statistics
+     */
+    WriteResult writeFile(const std::string& filename, const ExclusionDataView& view) const;
+    
+    /**
+     * @brief Write exclusion data to a file on a background thread
+     * 
+     * Runs writeFile() with the current configuration; the caller can keep
+     * working while the output is formatted and flushed.
+     * 
+     * @param filename Path to output file
+     * @param data Exclusion data to write (kept alive until the write completes)
+     * @return Future of the write result
+     */
+    std::future<WriteResult> writeFileAsync(const std::string& filename,
+                                            std::shared_ptr<const ExclusionData> data) const;
+    
+    /**
+     * @brief Write an .elb binary cache of exclusion data
+     * 
+     * The file holds the image of data.freeze() (see FrozenExclusionData),
+     * which ExclusionParser::loadBinaryFile() maps back without decoding.
+     * Writer formatting options do not apply. Data too large for the
+     * snapshot's 32-bit offsets fails the write without creating the file.
+     * 
+     * @param filename Path to output file (conventionally *.elb)
+     * @param data Exclusion data to write
+     * @return Write result; linesWritten is 0
+     */
+    WriteResult writeBinaryFile(const std::string& filename, const ExclusionData& data) const;
+    
+    /**
+     * @brief Write an .elb binary cache of a frozen snapshot
+     * @param filename Path to output file (conventionally *.elb)
+     * @param frozen Snapshot to write
+     * @return Write result; linesWritten is 0
+     */
+    WriteResult writeBinaryFile(const std::string& filename, const FrozenExclusionData& frozen) const;
+    
     /**
      * @brief Write exclusion data to a string
+     * 
+     * Lines are formatted straight into the result, presized from
+     * estimateOutputSize().
+     * 
      * @param data Exclusion data to write
      * @return Formatted string representation
      */
     std::string writeToString(const ExclusionData& data) const;
     
+    /**
+     * @brief Write a filtered view of exclusion data to a string
+     * @param view Scopes and types to write
+     * @return Formatted string representation
+     */
+    std::string writeToString(const ExclusionDataView& view) const;
+    
     /**
      * @brief Write exclusion data to an output stream
+     * 
+     * Lines are formatted into an OutputBuffer, reserved once at
+     * OutputBuffer::DEFAULT_FLUSH_THRESHOLD bytes, that is handed to the
+     * stream in writes of about that size. With
+     * WriterConfig::threadCount other than 1, scopes are formatted on a
+     * worker pool; the output is byte-identical to the serial path.
+     * 
      * @param stream Output stream to write to
      * @param data Exclusion data to write
      * @return Write result with success/failure and statistics
      */
     WriteResult writeToStream(std::ostream& stream, const ExclusionData& data) const;
     
+    /**
+     * @brief Write a filtered view of exclusion data to an output stream
+     * 
+     * Only the scopes and exclusion types the view selects are written;
+     * the data is read in place. Scopes follow the view's scopeNames order
+     * when given (sorted by name with sortExclusions).
+     * 
+     * @param stream Output stream to write to
+     * @param view Scopes and types to write
+     * @return Write result with success/failure and statistics
+     */
+    WriteResult writeToStream(std::ostream& stream, const ExclusionDataView& view) const;
+    
     /**
      * @brief Write only specific scopes to a file
+     * 
+     * Writes an ExclusionDataView of the named scopes, in the given order.
+     * 
      * @param filename Path to output file
      * @param data Exclusion data containing scopes
      * @param scopeNames Vector of scope names to write
@@ -302,6 +535,9 @@ public:
     
     /**
      * @brief Write exclusions of specific types only
+     * 
+     * Writes an ExclusionDataView with the matching typeMask.
+     * 
      * @param filename Path to output file
      * @param data Exclusion data to filter
      * @param types Vector of exclusion types to include
@@ -320,6 +556,12 @@ public:
     
     /**
      * @brief Write multiple exclusion data sets to separate files
+     * 
+     * Files are written through writeFileAsync(), several at a time
+     * (max(2, threadCount) in flight, each formatted serially), so one file
+     * is formatted while the previous ones flush. No further files are
+     * started after a failure.
+     * 
      * @param baseFilename Base filename (will be modified for each file)
      * @param dataList Vector of exclusion data sets
      * @return Combined write result for all files
@@ -349,6 +591,13 @@ public:
      */
     size_t estimateOutputSize(const ExclusionData& data) const;
     
+    /**
+     * @brief Estimate output file size of a filtered view
+     * @param view Scopes and types to write
+     * @return Estimated size in bytes
+     */
+    size_t estimateOutputSize(const ExclusionDataView& view) const;
+    
     /**
      * @brief Enable/disable debug mode for verbose logging
      * @param enable True to enable debug mode
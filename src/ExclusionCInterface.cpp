@@ -220,7 +220,7 @@ EXCLUSION_API ExclusionErrorCode AddExclusionScope(ExclusionDataHandle data, con
     
     return SafeExecute([&]() -> ExclusionErrorCode {
         ExclusionParser::ExclusionScope scope(scopeName, checksum, isModule != 0);
-        data->data->scopes[scopeName] = scope;
+        data->data->getOrCreateScope(scopeName) = scope;
         return EXCLUSION_SUCCESS;
     });
 }
@@ -291,7 +291,7 @@ EXCLUSION_API ExclusionErrorCode AddBlockExclusion(ExclusionDataHandle data, con
     
     return SafeExecute([&]() -> ExclusionErrorCode {
         ExclusionParser::BlockExclusion block(blockId, checksum, sourceCode, annotation);
-        data->data->scopes[scopeName].blockExclusions[blockId] = block;
+        data->data->getOrCreateScope(scopeName).blockExclusions[blockId] = block;
         return EXCLUSION_SUCCESS;
     });
 }
@@ -308,7 +308,7 @@ EXCLUSION_API ExclusionErrorCode AddToggleExclusion(ExclusionDataHandle data, co
         auto toggleDir = static_cast<ExclusionParser::ToggleDirection>(direction);
         std::optional<int> bitIdx = (bitIndex >= 0) ? std::optional<int>(bitIndex) : std::nullopt;
         ExclusionParser::ToggleExclusion toggle(toggleDir, signalName, bitIdx, description, annotation);
-        data->data->scopes[scopeName].toggleExclusions[signalName].push_back(toggle);
+        data->data->getOrCreateScope(scopeName).toggleExclusions[signalName].push_back(toggle);
         return EXCLUSION_SUCCESS;
     });
 }
@@ -322,7 +322,7 @@ EXCLUSION_API ExclusionErrorCode AddFsmStateExclusion(ExclusionDataHandle data,
     
     return SafeExecute([&]() -> ExclusionErrorCode {
         ExclusionParser::FsmExclusion fsm(fsmName, checksum, annotation);
-        data->data->scopes[scopeName].fsmExclusions[fsmName].push_back(fsm);
+        data->data->getOrCreateScope(scopeName).fsmExclusions[fsmName].push_back(fsm);
         return EXCLUSION_SUCCESS;
     });
 }
@@ -336,7 +336,7 @@ EXCLUSION_API ExclusionErrorCode AddFsmTransitionExclusion(ExclusionDataHandle d
     
     return SafeExecute([&]() -> ExclusionErrorCode {
         ExclusionParser::FsmExclusion fsm(fsmName, fromState, toState, checksum, annotation);
-        data->data->scopes[scopeName].fsmExclusions[fsmName].push_back(fsm);
+        data->data->getOrCreateScope(scopeName).fsmExclusions[fsmName].push_back(fsm);
         return EXCLUSION_SUCCESS;
     });
 }
@@ -352,7 +352,7 @@ EXCLUSION_API ExclusionErrorCode AddConditionExclusion(ExclusionDataHandle data,
     
     return SafeExecute([&]() -> ExclusionErrorCode {
         ExclusionParser::ConditionExclusion condition(conditionId, checksum, expression, parameters, coverage, annotation);
-        data->data->scopes[scopeName].conditionExclusions[conditionId] = condition;
+        data->data->getOrCreateScope(scopeName).conditionExclusions[conditionId] = condition;
         return EXCLUSION_SUCCESS;
     });
 }
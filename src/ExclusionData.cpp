@@ -22,12 +22,203 @@
 
 #include "ExclusionData.h"
 #include <algorithm>
-#include <regex>
+#include <array>
 #include <cctype>
 #include <sstream>
+#include <unordered_set>
 
 namespace ExclusionParser {
 
+namespace {
+
+/**
+ * @brief Check whether a scope name is a path or lies below it
+ */
+bool isUnderPath(const std::string& scopeName, const std::string& path) {
+    if (path.empty()) return true;
+    return scopeName.compare(0, path.size(), path) == 0 &&
+           (scopeName.size() == path.size() || scopeName[path.size()] == '.');
+}
+
+/**
+ * @brief Split text into lowercase words (runs of letters, digits and '_')
+ */
+std::vector<std::string> annotationTokens(std::string_view text) {
+    std::vector<std::string> tokens;
+    std::string token;
+    for (char c : text) {
+        if (std::isalnum(static_cast<unsigned char>(c)) || c == '_') {
+            token += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        } else if (!token.empty()) {
+            tokens.push_back(std::move(token));
+            token.clear();
+        }
+    }
+    if (!token.empty()) {
+        tokens.push_back(std::move(token));
+    }
+    return tokens;
+}
+
+/**
+ * @brief Pick the longest word of a substring query
+ * 
+ * Any text containing the query contains each of its words inside one of
+ * its own words, so this word narrows the candidates for the whole query.
+ */
+std::string longestToken(std::string_view query) {
+    std::string longest;
+    for (auto& token : annotationTokens(query)) {
+        if (token.size() > longest.size()) {
+            longest = std::move(token);
+        }
+    }
+    return longest;
+}
+
+} // namespace
+
+/**
+ * @brief Secondary indexes over every exclusion of the managed data
+ * 
+ * entries lists the exclusions in the order a full scan in search() visits
+ * them, and every posting list is sorted, so results taken from the indexes
+ * come out in the same order as from a scan. Text fields point into the
+ * indexed data.
+ */
+struct ExclusionDataManager::SearchIndex {
+    /// One exclusion (a columnar toggle row contributes one entry per direction)
+    struct Entry {
+        const std::string* scopeName;   ///< Key of the scope in ExclusionData::scopes
+        const ExclusionScope* scope;    ///< Owning scope
+        ExclusionType type;             ///< Exclusion type
+        std::string_view id;            ///< Block/condition ID, or signal/FSM name
+        size_t ordinal;                 ///< Position among the toggles/FSMs filed under id
+        std::optional<int> bitIndex;    ///< Toggle bit index
+        std::string_view annotation;    ///< Annotation text
+    };
+    
+    using Postings = std::vector<uint32_t>;
+    
+    const ExclusionData* source = nullptr;  ///< Data the indexes were built from
+    uint64_t generation = 0;                ///< source->getGeneration() at build time
+    uint64_t scopeChanges = 0;              ///< source->scopes.getChangeCount() at build time
+    std::vector<Entry> entries;             ///< All exclusions in scan order
+    std::array<Postings, 4> byType;         ///< Entries by ExclusionType
+    std::array<Postings, 2> byScopeKind;    ///< Entries in instance [0] and module [1] scopes
+    std::unordered_map<std::string_view, Postings> bySignal;   ///< Toggle entries by signal name
+    std::unordered_map<std::string_view, Postings> byFsm;      ///< FSM entries by FSM name
+    std::unordered_map<std::string, Postings> byToken;         ///< Entries by annotation word
+    
+    /**
+     * @brief Index every exclusion of a data set
+     */
+    void build(const ExclusionData& data) {
+        source = &data;
+        generation = data.getGeneration();
+        scopeChanges = data.scopes.getChangeCount();
+        
+        // Annotations are shared by many exclusions; split each distinct text once
+        std::unordered_map<std::string_view, std::vector<std::string>> tokenCache;
+        auto add = [&](Entry entry) {
+            auto id = static_cast<uint32_t>(entries.size());
+            byType[static_cast<size_t>(entry.type)].push_back(id);
+            byScopeKind[entry.scope->isModule ? 1 : 0].push_back(id);
+            if (entry.type == ExclusionType::TOGGLE) {
+                bySignal[entry.id].push_back(id);
+            } else if (entry.type == ExclusionType::FSM) {
+                byFsm[entry.id].push_back(id);
+            }
+            if (!entry.annotation.empty()) {
+                auto cached = tokenCache.try_emplace(entry.annotation);
+                if (cached.second) {
+                    cached.first->second = annotationTokens(entry.annotation);
+                }
+                for (const auto& token : cached.first->second) {
+                    Postings& postings = byToken[token];
+                    if (postings.empty() || postings.back() != id) {
+                        postings.push_back(id);
+                    }
+                }
+            }
+            entries.push_back(entry);
+        };
+        
+        for (const auto& [scopeName, scope] : data.scopes) {
+            for (const auto& [blockId, block] : scope.blockExclusions) {
+                add({&scopeName, &scope, ExclusionType::BLOCK, blockId, 0, std::nullopt, block.annotation});
+            }
+            for (const auto& [signalName, toggles] : scope.toggleExclusions) {
+                for (size_t i = 0; i < toggles.size(); ++i) {
+                    add({&scopeName, &scope, ExclusionType::TOGGLE, signalName, i, toggles[i].bitIndex,
+                         toggles[i].annotation});
+                }
+            }
+            std::unordered_map<std::string_view, size_t> toggleOrdinal;
+            const ToggleTable& table = scope.toggleTable;
+            for (size_t row = 0; row < table.getRowCount(); ++row) {
+                std::string_view signalName = table.signalName(row);
+                size_t& ordinal = toggleOrdinal[signalName];
+                table.forEachDirection(row, [&](ToggleDirection) {
+                    add({&scopeName, &scope, ExclusionType::TOGGLE, signalName, ordinal++, table.bitIndex(row),
+                         table.annotation(row)});
+                });
+            }
+            for (const auto& [fsmName, fsms] : scope.fsmExclusions) {
+                for (size_t i = 0; i < fsms.size(); ++i) {
+                    add({&scopeName, &scope, ExclusionType::FSM, fsmName, i, std::nullopt, fsms[i].annotation});
+                }
+            }
+            for (const auto& [condId, condition] : scope.conditionExclusions) {
+                add({&scopeName, &scope, ExclusionType::CONDITION, condId, 0, std::nullopt, condition.annotation});
+            }
+        }
+    }
+    
+    /**
+     * @brief Collect the postings of all keys containing a substring
+     * @return Sorted, duplicate-free entry IDs
+     */
+    template <typename Map>
+    static Postings lookupContaining(const Map& index, std::string_view text) {
+        Postings merged;
+        size_t lists = 0;
+        for (const auto& [key, postings] : index) {
+            if (std::string_view(key).find(text) != std::string_view::npos) {
+                merged.insert(merged.end(), postings.begin(), postings.end());
+                lists++;
+            }
+        }
+        if (lists > 1) {
+            std::sort(merged.begin(), merged.end());
+            merged.erase(std::unique(merged.begin(), merged.end()), merged.end());
+        }
+        return merged;
+    }
+    
+    /**
+     * @brief Check an entry against every criterion, with the semantics of a full scan
+     */
+    static bool accepts(const Entry& entry, const SearchCriteria& criteria, const CompiledPattern* scopePattern) {
+        if (criteria.type.has_value() && entry.type != criteria.type.value()) return false;
+        if (criteria.isModule.has_value() && entry.scope->isModule != criteria.isModule.value()) return false;
+        if (criteria.scopeName.has_value() &&
+            entry.scopeName->find(criteria.scopeName.value()) == std::string::npos) return false;
+        if (scopePattern && !scopePattern->matches(*entry.scopeName)) return false;
+        if (criteria.scopePath.has_value() && !isUnderPath(*entry.scopeName, criteria.scopePath.value())) return false;
+        if (criteria.annotation.has_value() &&
+            entry.annotation.find(criteria.annotation.value()) == std::string_view::npos) return false;
+        if (entry.type == ExclusionType::TOGGLE) {
+            if (criteria.signalName.has_value() &&
+                entry.id.find(criteria.signalName.value()) == std::string_view::npos) return false;
+            if (criteria.bitIndex.has_value() && entry.bitIndex != criteria.bitIndex) return false;
+        }
+        if (entry.type == ExclusionType::FSM && criteria.fsmName.has_value() &&
+            entry.id.find(criteria.fsmName.value()) == std::string_view::npos) return false;
+        return true;
+    }
+};
+
 // Utility function implementations
 std::string toggleDirectionToString(ToggleDirection direction) {
     switch (direction) {
@@ -56,13 +247,56 @@ std::string exclusionTypeToString(ExclusionType type) {
 
 // ExclusionDataManager implementation
 ExclusionDataManager::ExclusionDataManager() 
-    : data_(std::make_shared<ExclusionData>()) {
+    : data_(std::make_shared<ExclusionData>()), indexingEnabled_(false) {
 }
 
 ExclusionDataManager::~ExclusionDataManager() = default;
 
+ExclusionDataManager::ExclusionDataManager(const ExclusionDataManager& other)
+    : data_(other.data_), indexingEnabled_(other.indexingEnabled_) {
+}
+
+ExclusionDataManager& ExclusionDataManager::operator=(const ExclusionDataManager& other) {
+    if (this != &other) {
+        data_ = other.data_;
+        indexingEnabled_ = other.indexingEnabled_;
+        invalidateIndexes();
+    }
+    return *this;
+}
+
+void ExclusionDataManager::setIndexingEnabled(bool enabled) {
+    indexingEnabled_ = enabled;
+    if (!enabled) {
+        invalidateIndexes();
+    }
+}
+
+void ExclusionDataManager::invalidateIndexes() {
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    index_.reset();
+}
+
+std::shared_ptr<const ExclusionDataManager::SearchIndex> ExclusionDataManager::getIndex() const {
+    if (!indexingEnabled_ || !data_) return nullptr;
+    
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    if (!index_ || index_->source != data_.get() || index_->generation != data_->getGeneration() ||
+        index_->scopeChanges != data_->scopes.getChangeCount()) {
+        auto index = std::make_shared<SearchIndex>();
+        index->build(*data_);
+        index_ = std::move(index);
+    }
+    // The caller's reference keeps the indexes alive if another thread drops them
+    return index_;
+}
+
 void ExclusionDataManager::setData(std::shared_ptr<ExclusionData> data) {
     data_ = data ? data : std::make_shared<ExclusionData>();
+    if (!data_->isScopeIndexCurrent()) {
+        data_->rebuildScopeIndex();
+    }
+    invalidateIndexes();
 }
 
 std::shared_ptr<ExclusionData> ExclusionDataManager::getData() const {
@@ -73,12 +307,14 @@ void ExclusionDataManager::clear() {
     if (data_) {
         data_->clear();
     }
+    invalidateIndexes();
 }
 
 bool ExclusionDataManager::mergeData(const ExclusionData& other, bool overwriteExisting) {
     if (!data_) {
         data_ = std::make_shared<ExclusionData>();
     }
+    invalidateIndexes();
     
     try {
         data_->merge(other, overwriteExisting);
@@ -95,18 +331,72 @@ ExclusionDataManager::search(const SearchCriteria& criteria) const {
     
     if (!data_) return results;
     
-    for (const auto& [scopeName, scope] : data_->scopes) {
+    std::optional<CompiledPattern> scopePattern;
+    if (criteria.scopePattern.has_value()) {
+        scopePattern.emplace(criteria.scopePattern.value());
+    }
+    
+    if (auto index = getIndex()) {
+        // Start from the smallest posting list that covers every possible result
+        std::vector<const SearchIndex::Postings*> candidates;
+        SearchIndex::Postings signalPostings, fsmPostings, tokenPostings;
+        if (criteria.type.has_value()) {
+            candidates.push_back(&index->byType[static_cast<size_t>(criteria.type.value())]);
+        }
+        if (criteria.isModule.has_value()) {
+            candidates.push_back(&index->byScopeKind[criteria.isModule.value() ? 1 : 0]);
+        }
+        if (criteria.type == ExclusionType::TOGGLE && criteria.signalName.has_value()) {
+            signalPostings = SearchIndex::lookupContaining(index->bySignal, criteria.signalName.value());
+            candidates.push_back(&signalPostings);
+        }
+        if (criteria.type == ExclusionType::FSM && criteria.fsmName.has_value()) {
+            fsmPostings = SearchIndex::lookupContaining(index->byFsm, criteria.fsmName.value());
+            candidates.push_back(&fsmPostings);
+        }
+        if (criteria.annotation.has_value()) {
+            std::string token = longestToken(criteria.annotation.value());
+            if (!token.empty()) {
+                tokenPostings = SearchIndex::lookupContaining(index->byToken, token);
+                candidates.push_back(&tokenPostings);
+            }
+        }
+        
+        auto accept = [&](const SearchIndex::Entry& entry) {
+            if (SearchIndex::accepts(entry, criteria, scopePattern ? &*scopePattern : nullptr)) {
+                results.emplace_back(*entry.scopeName, entry.type);
+            }
+        };
+        if (candidates.empty()) {
+            for (const auto& entry : index->entries) {
+                accept(entry);
+            }
+        } else {
+            // The other criteria are checked on each candidate, which intersects them
+            const SearchIndex::Postings* smallest = *std::min_element(candidates.begin(), candidates.end(),
+                [](const auto* a, const auto* b) { return a->size() < b->size(); });
+            for (uint32_t id : *smallest) {
+                accept(index->entries[id]);
+            }
+        }
+        return results;
+    }
+    
+    auto searchScope = [&](const std::string& scopeName, const ExclusionScope& scope) {
         // Filter by scope name if specified
         if (criteria.scopeName.has_value()) {
             if (scopeName.find(criteria.scopeName.value()) == std::string::npos) {
-                continue;
+                return;
             }
         }
+        if (scopePattern && !scopePattern->matches(scopeName)) {
+            return;
+        }
         
         // Filter by scope type if specified
         if (criteria.isModule.has_value()) {
             if (scope.isModule != criteria.isModule.value()) {
-                continue;
+                return;
             }
         }
         
@@ -136,13 +426,41 @@ ExclusionDataManager::search(const SearchCriteria& criteria) const {
                             continue;
                         }
                     }
+                    if (criteria.bitIndex.has_value() && toggle.bitIndex != criteria.bitIndex) {
+                        continue;
+                    }
                     results.emplace_back(scopeName, ExclusionType::TOGGLE);
                 }
             }
+            
+            // Columnar toggles: filter on the row, then count each toggle it holds
+            const ToggleTable& table = scope.toggleTable;
+            for (size_t row = 0; row < table.getRowCount(); ++row) {
+                if (criteria.signalName.has_value() &&
+                    table.signalName(row).find(criteria.signalName.value()) == std::string::npos) {
+                    continue;
+                }
+                if (criteria.annotation.has_value() &&
+                    table.annotation(row).find(criteria.annotation.value()) == std::string::npos) {
+                    continue;
+                }
+                if (criteria.bitIndex.has_value() && table.bitIndex(row) != criteria.bitIndex) {
+                    continue;
+                }
+                table.forEachDirection(row, [&](ToggleDirection) {
+                    results.emplace_back(scopeName, ExclusionType::TOGGLE);
+                });
+            }
         }
         
         if (!criteria.type.has_value() || criteria.type.value() == ExclusionType::FSM) {
             for (const auto& [fsmName, fsms] : scope.fsmExclusions) {
+                if (criteria.fsmName.has_value()) {
+                    if (fsmName.find(criteria.fsmName.value()) == std::string::npos) {
+                        continue;
+                    }
+                }
+                
                 for (const auto& fsm : fsms) {
                     if (criteria.annotation.has_value()) {
                         if (fsm.annotation.find(criteria.annotation.value()) == std::string::npos) {
@@ -164,6 +482,26 @@ ExclusionDataManager::search(const SearchCriteria& criteria) const {
                 results.emplace_back(scopeName, ExclusionType::CONDITION);
             }
         }
+    };
+    
+    if (!criteria.scopePath.has_value()) {
+        for (const auto& [scopeName, scope] : data_->scopes) {
+            searchScope(scopeName, scope);
+        }
+    } else if (data_->isScopeIndexCurrent()) {
+        // Only visit the subtree below the path
+        data_->getScopeIndex().forEachUnder(criteria.scopePath.value(), [&](const std::string& scopeName) {
+            auto it = data_->scopes.find(scopeName);
+            if (it != data_->scopes.end()) {
+                searchScope(it->first, it->second);
+            }
+        });
+    } else {
+        for (const auto& [scopeName, scope] : data_->scopes) {
+            if (isUnderPath(scopeName, criteria.scopePath.value())) {
+                searchScope(scopeName, scope);
+            }
+        }
     }
     
     return results;
@@ -181,8 +519,37 @@ std::vector<std::string> ExclusionDataManager::findScopesMatching(const std::str
     
     if (!data_) return matches;
     
+    CompiledPattern compiled(pattern);
+    if (!data_->isScopeIndexCurrent()) {
+        for (const auto& [scopeName, scope] : data_->scopes) {
+            if (compiled.matches(scopeName)) {
+                matches.push_back(scopeName);
+            }
+        }
+        return matches;
+    }
+    
+    // Only scopes starting with the text before the first wildcard can match
+    data_->getScopeIndex().forEachWithPrefix(compiled.getLiteralPrefix(), [&](const std::string& scopeName) {
+        if (compiled.matches(scopeName)) {
+            matches.push_back(scopeName);
+        }
+    });
+    
+    return matches;
+}
+
+std::vector<std::string> ExclusionDataManager::findScopesUnder(const std::string& path) const {
+    std::vector<std::string> matches;
+    
+    if (!data_) return matches;
+    
+    if (data_->isScopeIndexCurrent()) {
+        return data_->getScopeIndex().findUnder(path);
+    }
+    
     for (const auto& [scopeName, scope] : data_->scopes) {
-        if (PatternMatcher::matches(pattern, scopeName)) {
+        if (isUnderPath(scopeName, path)) {
             matches.push_back(scopeName);
         }
     }
@@ -190,6 +557,21 @@ std::vector<std::string> ExclusionDataManager::findScopesMatching(const std::str
     return matches;
 }
 
+std::vector<std::string> ExclusionDataManager::findScopesMatchingPath(const std::string& pattern) const {
+    if (!data_) return {};
+    
+    if (data_->isScopeIndexCurrent()) {
+        return data_->getScopeIndex().findMatching(pattern);
+    }
+    
+    // Index a snapshot of the edited map rather than duplicating the matcher
+    ScopeTrie index;
+    for (const auto& [scopeName, scope] : data_->scopes) {
+        index.insert(scopeName);
+    }
+    return index.findMatching(pattern);
+}
+
 ExclusionStatistics ExclusionDataManager::getStatistics() const {
     ExclusionStatistics stats;
     
@@ -213,11 +595,9 @@ ExclusionStatistics ExclusionDataManager::getStatistics() const {
             if (!block.annotation.empty()) stats.annotatedExclusions++;
         }
         
-        for (const auto& [signalName, toggles] : scope.toggleExclusions) {
-            for (const auto& toggle : toggles) {
-                if (!toggle.annotation.empty()) stats.annotatedExclusions++;
-            }
-        }
+        scope.forEachToggle([&stats](const ToggleExclusion& toggle) {
+            if (!toggle.annotation.empty()) stats.annotatedExclusions++;
+        });
         
         for (const auto& [fsmName, fsms] : scope.fsmExclusions) {
             for (const auto& fsm : fsms) {
@@ -240,10 +620,20 @@ std::unordered_set<std::string> ExclusionDataManager::getAllSignalNames() const
     
     if (!data_) return signalNames;
     
+    if (auto index = getIndex()) {
+        for (const auto& [signalName, postings] : index->bySignal) {
+            signalNames.emplace(signalName);
+        }
+        return signalNames;
+    }
+    
     for (const auto& [scopeName, scope] : data_->scopes) {
         for (const auto& [signalName, toggles] : scope.toggleExclusions) {
             signalNames.insert(signalName);
         }
+        for (size_t row = 0; row < scope.toggleTable.getRowCount(); ++row) {
+            signalNames.insert(scope.toggleTable.signalName(row));
+        }
     }
     
     return signalNames;
@@ -254,6 +644,13 @@ std::unordered_set<std::string> ExclusionDataManager::getAllFsmNames() const {
     
     if (!data_) return fsmNames;
     
+    if (auto index = getIndex()) {
+        for (const auto& [fsmName, postings] : index->byFsm) {
+            fsmNames.emplace(fsmName);
+        }
+        return fsmNames;
+    }
+    
     for (const auto& [scopeName, scope] : data_->scopes) {
         for (const auto& [fsmName, fsms] : scope.fsmExclusions) {
             fsmNames.insert(fsmName);
@@ -275,6 +672,45 @@ ExclusionDataManager::findByAnnotation(const std::string& annotationSubstring,
         std::transform(searchStr.begin(), searchStr.end(), searchStr.begin(), ::tolower);
     }
     
+    if (auto index = getIndex()) {
+        auto check = [&](const SearchIndex::Entry& entry) {
+            std::string annotation(entry.annotation);
+            if (!caseSensitive) {
+                std::transform(annotation.begin(), annotation.end(), annotation.begin(), ::tolower);
+            }
+            if (annotation.find(searchStr) == std::string::npos) {
+                return;
+            }
+            std::string id(entry.id);
+            switch (entry.type) {
+                case ExclusionType::BLOCK:
+                    results.emplace_back(*entry.scopeName, "Block " + id);
+                    break;
+                case ExclusionType::TOGGLE:
+                    results.emplace_back(*entry.scopeName, "Toggle " + id + "[" + std::to_string(entry.ordinal) + "]");
+                    break;
+                case ExclusionType::FSM:
+                    results.emplace_back(*entry.scopeName, "FSM " + id + "[" + std::to_string(entry.ordinal) + "]");
+                    break;
+                case ExclusionType::CONDITION:
+                    results.emplace_back(*entry.scopeName, "Condition " + id);
+                    break;
+            }
+        };
+        
+        std::string token = longestToken(searchStr);
+        if (token.empty()) {
+            for (const auto& entry : index->entries) {
+                check(entry);
+            }
+        } else {
+            for (uint32_t id : SearchIndex::lookupContaining(index->byToken, token)) {
+                check(index->entries[id]);
+            }
+        }
+        return results;
+    }
+    
     for (const auto& [scopeName, scope] : data_->scopes) {
         // Search block exclusions
         for (const auto& [blockId, block] : scope.blockExclusions) {
@@ -302,6 +738,25 @@ ExclusionDataManager::findByAnnotation(const std::string& annotationSubstring,
             }
         }
         
+        // Columnar toggles are numbered per signal in the same way
+        std::unordered_map<std::string_view, size_t> toggleIndex;
+        for (size_t row = 0; row < scope.toggleTable.getRowCount(); ++row) {
+            std::string annotation = scope.toggleTable.annotation(row);
+            if (!caseSensitive) {
+                std::transform(annotation.begin(), annotation.end(), annotation.begin(), ::tolower);
+            }
+            
+            std::string_view signalName = scope.toggleTable.signalName(row);
+            size_t& index = toggleIndex[signalName];
+            bool matched = annotation.find(searchStr) != std::string::npos;
+            scope.toggleTable.forEachDirection(row, [&](ToggleDirection) {
+                if (matched) {
+                    results.emplace_back(scopeName, "Toggle " + std::string(signalName) + "[" + std::to_string(index) + "]");
+                }
+                index++;
+            });
+        }
+        
         // Search FSM exclusions
         for (const auto& [fsmName, fsms] : scope.fsmExclusions) {
             for (size_t i = 0; i < fsms.size(); ++i) {
@@ -384,6 +839,11 @@ std::vector<std::string> ExclusionDataManager::validateData() const {
                 errors.push_back("Found toggle exclusion with empty signal name in scope: " + scopeName);
             }
         }
+        for (size_t row = 0; row < scope.toggleTable.getRowCount(); ++row) {
+            if (scope.toggleTable.signalName(row).empty()) {
+                errors.push_back("Found toggle exclusion with empty signal name in scope: " + scopeName);
+            }
+        }
         
         // Check for empty FSM names
         for (const auto& [fsmName, fsms] : scope.fsmExclusions) {
@@ -444,6 +904,10 @@ size_t ExclusionDataManager::removeExclusions(const SearchCriteria& criteria) {
         }
     }
     
+    if (removedCount > 0) {
+        data_->markModified();
+    }
+    invalidateIndexes();
     return removedCount;
 }
 
@@ -464,6 +928,15 @@ size_t ExclusionDataManager::getMemoryUsage() const {
     
     size_t usage = sizeof(ExclusionData);
     
+    // Shared (interned) text is counted once, however many exclusions refer to it
+    std::unordered_set<const void*> seenText;
+    auto sharedBytes = [&seenText](const InternedString& text) -> size_t {
+        if (text.empty() || !seenText.insert(text.storage()).second) {
+            return 0;
+        }
+        return sizeof(InternedString::Rep) + text.size() + 1;
+    };
+    
     // Estimate memory usage of scopes and their contents
     for (const auto& [scopeName, scope] : data_->scopes) {
         usage += scopeName.size();
@@ -475,7 +948,7 @@ size_t ExclusionDataManager::getMemoryUsage() const {
         usage += scope.blockExclusions.size() * sizeof(BlockExclusion);
         for (const auto& [blockId, block] : scope.blockExclusions) {
             usage += blockId.size() + block.checksum.size() + 
-                     block.sourceCode.size() + block.annotation.size();
+                     block.sourceCode.size() + sharedBytes(block.annotation);
         }
         
         // Toggle exclusions
@@ -483,10 +956,16 @@ size_t ExclusionDataManager::getMemoryUsage() const {
             usage += signalName.size();
             usage += toggles.size() * sizeof(ToggleExclusion);
             for (const auto& toggle : toggles) {
-                usage += toggle.signalName.size() + toggle.netDescription.size() + 
-                         toggle.annotation.size();
+                usage += sharedBytes(toggle.signalName) + sharedBytes(toggle.netDescription) + 
+                         sharedBytes(toggle.annotation);
             }
         }
+        usage += scope.toggleTable.getColumnBytes();
+        for (size_t row = 0; row < scope.toggleTable.getRowCount(); ++row) {
+            usage += sharedBytes(scope.toggleTable.signalName(row)) +
+                     sharedBytes(scope.toggleTable.netDescription(row)) +
+                     sharedBytes(scope.toggleTable.annotation(row));
+        }
         
         // FSM exclusions
         for (const auto& [fsmName, fsms] : scope.fsmExclusions) {
@@ -495,7 +974,7 @@ size_t ExclusionDataManager::getMemoryUsage() const {
             for (const auto& fsm : fsms) {
                 usage += fsm.fsmName.size() + fsm.checksum.size() + 
                          fsm.fromState.size() + fsm.toState.size() + 
-                         fsm.transitionId.size() + fsm.annotation.size();
+                         fsm.transitionId.size() + sharedBytes(fsm.annotation);
             }
         }
         
@@ -504,36 +983,125 @@ size_t ExclusionDataManager::getMemoryUsage() const {
         for (const auto& [condId, condition] : scope.conditionExclusions) {
             usage += condId.size() + condition.checksum.size() + 
                      condition.expression.size() + condition.parameters.size() + 
-                     condition.coverage.size() + condition.annotation.size();
+                     condition.coverage.size() + sharedBytes(condition.annotation);
         }
     }
     
     return usage;
 }
 
-// PatternMatcher implementation
-bool PatternMatcher::matches(const std::string& pattern, const std::string& str, bool caseSensitive) {
-    std::string regexPattern = pattern;
-    
-    // Escape special regex characters except * and ?
-    std::regex specialChars{R"([-[\]{}()+.,\^$|#\s])"};
-    regexPattern = std::regex_replace(regexPattern, specialChars, R"(\$&)");
-    
-    // Convert wildcards to regex
-    std::regex_replace(regexPattern, std::regex("\\*"), ".*");
-    std::regex_replace(regexPattern, std::regex("\\?"), ".");
+// CompiledPattern implementation
+CompiledPattern::CompiledPattern(std::string_view pattern, bool caseSensitive)
+    : pieces_(1), minLength_(0), caseSensitive_(caseSensitive) {
+    bool inPrefix = true;
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        char c = pattern[i];
+        if (c == '*') {
+            inPrefix = false;
+            // Consecutive stars are one star
+            if (!pieces_.back().text.empty() || pieces_.size() == 1) {
+                pieces_.emplace_back();
+            }
+            continue;
+        }
+        
+        Piece& piece = pieces_.back();
+        bool any = (c == '?');
+        if (c == '\\' && i + 1 < pattern.size()) {
+            c = pattern[++i];
+        }
+        if (any) {
+            inPrefix = false;
+            if (!piece.hasWildcard) {
+                piece.anyChar.assign(piece.text.size(), false);
+                piece.hasWildcard = true;
+            }
+        } else if (inPrefix && caseSensitive_) {
+            literalPrefix_ += c;
+        }
+        
+        piece.text += caseSensitive_ ? c : static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        if (piece.hasWildcard) {
+            piece.anyChar.push_back(any);
+        }
+        minLength_++;
+    }
+}
+
+bool CompiledPattern::matchesAt(const Piece& piece, std::string_view str, size_t position) const {
+    for (size_t i = 0; i < piece.text.size(); ++i) {
+        if (piece.hasWildcard && piece.anyChar[i]) {
+            continue;
+        }
+        char c = str[position + i];
+        if (!caseSensitive_) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        if (c != piece.text[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t CompiledPattern::find(const Piece& piece, std::string_view str, size_t from, size_t to) const {
+    if (piece.text.size() > to - from) {
+        return std::string_view::npos;
+    }
+    if (caseSensitive_ && !piece.hasWildcard) {
+        size_t position = str.substr(0, to).find(piece.text, from);
+        return position;
+    }
+    for (size_t position = from; position + piece.text.size() <= to; ++position) {
+        if (matchesAt(piece, str, position)) {
+            return position;
+        }
+    }
+    return std::string_view::npos;
+}
+
+bool CompiledPattern::matches(std::string_view str) const {
+    if (str.size() < minLength_) {
+        return false;
+    }
     
-    std::regex::flag_type flags = std::regex::ECMAScript;
-    if (!caseSensitive) {
-        flags |= std::regex::icase;
+    const Piece& first = pieces_.front();
+    if (pieces_.size() == 1) {
+        return str.size() == first.text.size() && matchesAt(first, str, 0);
     }
     
-    try {
-        std::regex regex(regexPattern, flags);
-        return std::regex_match(str, regex);
-    } catch (const std::exception&) {
+    // First piece is anchored at the start, last at the end (lengths fit: minLength_)
+    const Piece& last = pieces_.back();
+    size_t end = str.size() - last.text.size();
+    if (!matchesAt(first, str, 0) || !matchesAt(last, str, end)) {
         return false;
     }
+    
+    // Taking each middle piece at its leftmost match leaves the most room for the rest
+    size_t position = first.text.size();
+    for (size_t i = 1; i + 1 < pieces_.size(); ++i) {
+        size_t found = find(pieces_[i], str, position, end);
+        if (found == std::string_view::npos) {
+            return false;
+        }
+        position = found + pieces_[i].text.size();
+    }
+    return true;
+}
+
+std::vector<std::string> CompiledPattern::filter(const std::vector<std::string>& names) const {
+    std::vector<std::string> result;
+    for (const auto& name : names) {
+        if (matches(name)) {
+            result.push_back(name);
+        }
+    }
+    return result;
+}
+
+// PatternMatcher implementation
+bool PatternMatcher::matches(const std::string& pattern, const std::string& str, bool caseSensitive) {
+    return CompiledPattern(pattern, caseSensitive).matches(str);
 }
 
 std::string PatternMatcher::escape(const std::string& str) {
@@ -0,0 +1,627 @@
+/**
+ * @file ExclusionFrozenData.cpp
+ * @brief Implementation of the immutable exclusion snapshot
+ *
+ * @author AMD Advanced Micro Devices Inc. - Verification Infrastructure Team
+ * @version 2.0.0
+ * @date September 13, 2025
+ * @copyright (c) 2025 Advanced Micro Devices Inc. All rights reserved.
+ */
+
+#include "ExclusionFrozenData.h"
+#include "ExclusionVisitor.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+namespace ExclusionParser {
+
+namespace {
+
+/**
+ * @brief Narrow a blob offset, length or record index to the 32 bits the image stores
+ * @throws std::length_error If the value does not fit
+ */
+uint32_t narrow(size_t value, const char* what) {
+    if (value > UINT32_MAX) {
+        throw std::length_error(std::string("Exclusion data too large to freeze: ") + what +
+                                " exceeds " + std::to_string(UINT32_MAX));
+    }
+    return static_cast<uint32_t>(value);
+}
+
+/**
+ * @brief Appends text to the blob, storing each distinct string once
+ *
+ * Keys view the source ExclusionData, which outlives the builder. Pooled
+ * texts (annotations, signal names, net descriptions) repeat at the same
+ * address, so a small cache keyed by address skips most hash lookups.
+ */
+class TextBuilder {
+private:
+    std::string& blob_;
+    std::unordered_map<std::string_view, FrozenExclusionData::TextRef> seen_;
+    std::array<std::pair<std::string_view, FrozenExclusionData::TextRef>, 1024> recent_{};
+
+public:
+    explicit TextBuilder(std::string& blob) : blob_(blob) {}
+
+    FrozenExclusionData::TextRef add(std::string_view text) {
+        if (text.empty()) {
+            return {};
+        }
+        auto& recent = recent_[(reinterpret_cast<uintptr_t>(text.data()) >> 3) % recent_.size()];
+        if (recent.first.data() == text.data() && recent.first.size() == text.size()) {
+            return recent.second;
+        }
+        auto [it, inserted] = seen_.try_emplace(text);
+        if (inserted) {
+            it->second = FrozenExclusionData::TextRef{narrow(blob_.size(), "text blob offset"),
+                                                      narrow(text.size(), "text length")};
+            blob_.append(text);
+        }
+        recent = {text, it->second};
+        return it->second;
+    }
+};
+
+/// Image sections, in file order
+enum Section : size_t {
+    BLOB,
+    METADATA,               ///< TextRef of fileName, generatedBy, formatVersion, generationDate, exclusionMode
+    SCOPES,
+    BLOCKS,
+    TOGGLES,
+    FSMS,
+    CONDITIONS,
+    TOGGLE_ORDER,           ///< Per toggle in stored order, its index within the scope's toggles
+    SCOPE_SLOTS,
+    BLOCK_SLOTS,
+    CONDITION_SLOTS,
+    SECTION_COUNT
+};
+
+constexpr char kMagic[8] = {'E', 'X', 'C', 'L', '.', 'E', 'L', 'B'};
+constexpr uint32_t kByteOrderMark = 0x01020304;
+constexpr size_t kMetadataFields = 5;
+
+/**
+ * @brief Fixed image header; sections follow at 8-byte aligned offsets
+ */
+struct ImageHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;                 ///< kByteOrderMark as stored by the writer
+    uint32_t recordSizes[6];            ///< TextRef, Scope, Block, Toggle, Fsm, Condition
+    uint64_t imageSize;
+    uint64_t contentChecksum;           ///< Over everything after the header
+    uint64_t sections[SECTION_COUNT][2]; ///< Byte offset and byte size of each section
+    uint64_t headerChecksum;            ///< Over all header bytes before this field
+};
+
+static_assert(sizeof(ImageHeader) % 8 == 0, "sections must start 8-byte aligned");
+
+void recordSizes(uint32_t (&sizes)[6]) {
+    sizes[0] = sizeof(FrozenExclusionData::TextRef);
+    sizes[1] = sizeof(FrozenExclusionData::Scope);
+    sizes[2] = sizeof(FrozenExclusionData::Block);
+    sizes[3] = sizeof(FrozenExclusionData::Toggle);
+    sizes[4] = sizeof(FrozenExclusionData::Fsm);
+    sizes[5] = sizeof(FrozenExclusionData::Condition);
+}
+
+inline uint64_t rotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+/**
+ * @brief Build a hash index with at most half of the slots used
+ * @throws std::length_error If a record index does not fit the slot's low 32 bits
+ */
+std::vector<uint64_t> buildSlots(const std::vector<uint64_t>& hashes) {
+    size_t capacity = 2;
+    while (capacity < hashes.size() * 2) {
+        capacity *= 2;
+    }
+    narrow(hashes.size(), "record count");
+    std::vector<uint64_t> slots(capacity, 0);
+    uint64_t mask = capacity - 1;
+    for (size_t index = 0; index < hashes.size(); ++index) {
+        uint64_t slot = hashes[index] & mask;
+        while (slots[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = (hashes[index] & 0xffffffff00000000ULL) | (index + 1);
+    }
+    return slots;
+}
+
+} // namespace
+
+FrozenExclusionData ExclusionData::freeze() const {
+    return FrozenExclusionData(*this);
+}
+
+uint64_t FrozenExclusionData::checksum(std::string_view bytes) {
+    const char* data = bytes.data();
+    size_t size = bytes.size();
+    constexpr uint64_t kPrime1 = 0x9e3779b185ebca87ULL;
+    constexpr uint64_t kPrime2 = 0xc2b2ae3d27d4eb4fULL;
+    uint64_t lanes[4] = {kPrime1, kPrime2, 0, ~kPrime1};
+    size_t position = 0;
+    for (; position + 32 <= size; position += 32) {
+        for (int lane = 0; lane < 4; ++lane) {
+            uint64_t word;
+            std::memcpy(&word, data + position + lane * 8, 8);
+            lanes[lane] = rotateLeft(lanes[lane] + word * kPrime2, 31) * kPrime1;
+        }
+    }
+    uint64_t hash = rotateLeft(lanes[0], 1) + rotateLeft(lanes[1], 7) + rotateLeft(lanes[2], 12) +
+                    rotateLeft(lanes[3], 18) + size;
+    for (; position < size; ++position) {
+        hash = rotateLeft(hash ^ (static_cast<unsigned char>(data[position]) * kPrime1), 11) * kPrime2;
+    }
+    hash ^= hash >> 33;
+    hash *= kPrime2;
+    hash ^= hash >> 29;
+    return hash;
+}
+
+FrozenExclusionData::FrozenExclusionData(const ExclusionData& data) {
+    std::string blob;
+    std::vector<Scope> scopes;
+    std::vector<Block> blocks;
+    std::vector<Toggle> toggles;
+    std::vector<Fsm> fsms;
+    std::vector<Condition> conditions;
+    std::vector<uint32_t> toggleOrder;
+    std::vector<uint32_t> byKey;
+    std::vector<Toggle> stored;
+
+    TextBuilder texts(blob);
+    auto view = [&blob](TextRef ref) { return std::string_view(blob).substr(ref.offset, ref.length); };
+
+    TextRef metadata[kMetadataFields] = {texts.add(data.fileName), texts.add(data.generatedBy),
+                                         texts.add(data.formatVersion), texts.add(data.generationDate),
+                                         texts.add(data.exclusionMode)};
+
+    std::vector<const ExclusionScope*> scopeOrder;
+    scopeOrder.reserve(data.scopes.size());
+    for (const auto& [scopeName, scope] : data.scopes) {
+        scopeOrder.push_back(&scope);
+    }
+    std::sort(scopeOrder.begin(), scopeOrder.end(),
+              [](const ExclusionScope* a, const ExclusionScope* b) { return a->scopeName < b->scopeName; });
+
+    scopes.reserve(scopeOrder.size());
+    for (const ExclusionScope* source : scopeOrder) {
+        Scope scope{};
+        scope.name = texts.add(source->scopeName);
+        scope.checksum = texts.add(source->checksum);
+        scope.isModule = source->isModule;
+
+        scope.blockBegin = narrow(blocks.size(), "block count");
+        for (const auto& [blockId, block] : source->blockExclusions) {
+            blocks.push_back(Block{texts.add(blockId), texts.add(block.checksum), texts.add(block.sourceCode),
+                                   texts.add(block.annotation)});
+        }
+        std::sort(blocks.begin() + scope.blockBegin, blocks.end(), [&](const Block& a, const Block& b) {
+            return view(a.blockId) < view(b.blockId);
+        });
+        scope.blockEnd = narrow(blocks.size(), "block count");
+
+        scope.toggleBegin = narrow(toggles.size(), "toggle count");
+        source->forEachToggle([&](const ToggleExclusion& toggle) {
+            toggles.push_back(Toggle{texts.add(toggle.signalName), texts.add(toggle.netDescription),
+                                     texts.add(toggle.annotation),
+                                     toggle.bitIndex.has_value() ? static_cast<int32_t>(*toggle.bitIndex) : Toggle::NO_BIT,
+                                     toggle.direction});
+        });
+        scope.toggleEnd = narrow(toggles.size(), "toggle count");
+
+        // Sort by signal, bit and direction; toggleOrder keeps the stored order for accept()
+        stored.assign(toggles.begin() + scope.toggleBegin, toggles.end());
+        byKey.resize(stored.size());
+        std::iota(byKey.begin(), byKey.end(), 0u);
+        std::stable_sort(byKey.begin(), byKey.end(), [&](uint32_t a, uint32_t b) {
+            return std::make_tuple(view(stored[a].signalName), stored[a].bit, stored[a].direction) <
+                   std::make_tuple(view(stored[b].signalName), stored[b].bit, stored[b].direction);
+        });
+        toggleOrder.resize(toggles.size());
+        for (uint32_t position = 0; position < byKey.size(); ++position) {
+            toggles[scope.toggleBegin + position] = stored[byKey[position]];
+            toggleOrder[scope.toggleBegin + byKey[position]] = position;
+        }
+
+        scope.fsmBegin = narrow(fsms.size(), "fsm count");
+        for (const auto& [fsmName, fsmList] : source->fsmExclusions) {
+            for (const auto& fsm : fsmList) {
+                fsms.push_back(Fsm{texts.add(fsm.fsmName), texts.add(fsm.checksum), texts.add(fsm.fromState),
+                                   texts.add(fsm.toState), texts.add(fsm.transitionId), texts.add(fsm.annotation),
+                                   fsm.isTransition});
+            }
+        }
+        std::stable_sort(fsms.begin() + scope.fsmBegin, fsms.end(), [&](const Fsm& a, const Fsm& b) {
+            return view(a.fsmName) < view(b.fsmName);
+        });
+        scope.fsmEnd = narrow(fsms.size(), "fsm count");
+
+        scope.conditionBegin = narrow(conditions.size(), "condition count");
+        for (const auto& [condId, condition] : source->conditionExclusions) {
+            conditions.push_back(Condition{texts.add(condId), texts.add(condition.checksum),
+                                           texts.add(condition.expression), texts.add(condition.parameters),
+                                           texts.add(condition.coverage), texts.add(condition.annotation)});
+        }
+        std::sort(conditions.begin() + scope.conditionBegin, conditions.end(),
+                  [&](const Condition& a, const Condition& b) { return view(a.conditionId) < view(b.conditionId); });
+        scope.conditionEnd = narrow(conditions.size(), "condition count");
+
+        scopes.push_back(scope);
+    }
+
+    std::vector<uint64_t> hashes;
+    for (const auto& scope : scopes) {
+        hashes.push_back(hashKey(view(scope.name)));
+    }
+    std::vector<uint64_t> scopeSlots = buildSlots(hashes);
+
+    hashes.clear();
+    for (size_t index = 0; index < scopes.size(); ++index) {
+        for (uint32_t block = scopes[index].blockBegin; block < scopes[index].blockEnd; ++block) {
+            hashes.push_back(hashKey(view(blocks[block].blockId), index + 1));
+        }
+    }
+    std::vector<uint64_t> blockSlots = buildSlots(hashes);
+
+    hashes.clear();
+    for (size_t index = 0; index < scopes.size(); ++index) {
+        for (uint32_t condition = scopes[index].conditionBegin; condition < scopes[index].conditionEnd; ++condition) {
+            hashes.push_back(hashKey(view(conditions[condition].conditionId), index + 1));
+        }
+    }
+    std::vector<uint64_t> conditionSlots = buildSlots(hashes);
+
+    // Lay the sections out after the header, each 8-byte aligned
+    const std::pair<const void*, size_t> contents[SECTION_COUNT] = {
+        {blob.data(), blob.size()},
+        {metadata, sizeof(metadata)},
+        {scopes.data(), scopes.size() * sizeof(Scope)},
+        {blocks.data(), blocks.size() * sizeof(Block)},
+        {toggles.data(), toggles.size() * sizeof(Toggle)},
+        {fsms.data(), fsms.size() * sizeof(Fsm)},
+        {conditions.data(), conditions.size() * sizeof(Condition)},
+        {toggleOrder.data(), toggleOrder.size() * sizeof(uint32_t)},
+        {scopeSlots.data(), scopeSlots.size() * sizeof(uint64_t)},
+        {blockSlots.data(), blockSlots.size() * sizeof(uint64_t)},
+        {conditionSlots.data(), conditionSlots.size() * sizeof(uint64_t)}
+    };
+
+    ImageHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = FORMAT_VERSION;
+    header.byteOrder = kByteOrderMark;
+    recordSizes(header.recordSizes);
+    uint64_t offset = sizeof(ImageHeader);
+    for (size_t section = 0; section < SECTION_COUNT; ++section) {
+        header.sections[section][0] = offset;
+        header.sections[section][1] = contents[section].second;
+        offset += (contents[section].second + 7) & ~uint64_t(7);
+    }
+    header.imageSize = offset;
+
+    auto words = std::make_shared<uint64_t[]>(offset / 8);
+    char* image = reinterpret_cast<char*>(words.get());
+    for (size_t section = 0; section < SECTION_COUNT; ++section) {
+        if (contents[section].second != 0) {
+            std::memcpy(image + header.sections[section][0], contents[section].first, contents[section].second);
+        }
+    }
+    header.contentChecksum = checksum(std::string_view(image + sizeof(ImageHeader), offset - sizeof(ImageHeader)));
+    header.headerChecksum = checksum(std::string_view(reinterpret_cast<const char*>(&header), offsetof(ImageHeader, headerChecksum)));
+    std::memcpy(image, &header, sizeof(header));
+
+    std::string errorMessage;
+    attach(std::move(words), std::string_view(image, offset), false, errorMessage);
+}
+
+bool FrozenExclusionData::fromImage(std::shared_ptr<const void> storage, std::string_view image,
+                                    FrozenExclusionData& result, std::string& errorMessage, bool verifyContent) {
+    FrozenExclusionData loaded;
+    if (!loaded.attach(std::move(storage), image, verifyContent, errorMessage)) {
+        return false;
+    }
+    result = std::move(loaded);
+    return true;
+}
+
+bool FrozenExclusionData::attach(std::shared_ptr<const void> storage, std::string_view image, bool verifyContent,
+                                 std::string& errorMessage) {
+    if (image.size() < sizeof(ImageHeader)) {
+        errorMessage = "Binary cache is truncated (no header)";
+        return false;
+    }
+    if (reinterpret_cast<uintptr_t>(image.data()) % 8 != 0) {
+        errorMessage = "Binary cache image is not 8-byte aligned";
+        return false;
+    }
+
+    ImageHeader header;
+    std::memcpy(&header, image.data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        errorMessage = "Not a binary exclusion cache (bad magic)";
+        return false;
+    }
+    if (header.headerChecksum != checksum(image.substr(0, offsetof(ImageHeader, headerChecksum)))) {
+        errorMessage = "Binary cache header checksum mismatch";
+        return false;
+    }
+    if (header.byteOrder != kByteOrderMark) {
+        errorMessage = "Binary cache was written with a different byte order";
+        return false;
+    }
+    if (header.version != FORMAT_VERSION) {
+        errorMessage = "Unsupported binary cache version " + std::to_string(header.version) +
+                       " (expected " + std::to_string(FORMAT_VERSION) + ")";
+        return false;
+    }
+    uint32_t expectedSizes[6];
+    recordSizes(expectedSizes);
+    if (std::memcmp(header.recordSizes, expectedSizes, sizeof(expectedSizes)) != 0) {
+        errorMessage = "Binary cache record layout does not match this build";
+        return false;
+    }
+    if (header.imageSize != image.size()) {
+        errorMessage = "Binary cache size mismatch (" + std::to_string(image.size()) + " bytes, header says " +
+                       std::to_string(header.imageSize) + ")";
+        return false;
+    }
+
+    const size_t recordSize[SECTION_COUNT] = {1, sizeof(TextRef), sizeof(Scope), sizeof(Block), sizeof(Toggle),
+                                              sizeof(Fsm), sizeof(Condition), sizeof(uint32_t), 8, 8, 8};
+    for (size_t section = 0; section < SECTION_COUNT; ++section) {
+        uint64_t begin = header.sections[section][0];
+        uint64_t size = header.sections[section][1];
+        if (begin < sizeof(ImageHeader) || begin % 8 != 0 || begin > image.size() || size > image.size() - begin ||
+            size % recordSize[section] != 0) {
+            errorMessage = "Binary cache section " + std::to_string(section) + " is out of bounds";
+            return false;
+        }
+    }
+    if (header.sections[METADATA][1] != kMetadataFields * sizeof(TextRef)) {
+        errorMessage = "Binary cache metadata section is malformed";
+        return false;
+    }
+    if (header.sections[TOGGLE_ORDER][1] / sizeof(uint32_t) != header.sections[TOGGLES][1] / sizeof(Toggle)) {
+        errorMessage = "Binary cache toggle order section is malformed";
+        return false;
+    }
+    for (Section slots : {SCOPE_SLOTS, BLOCK_SLOTS, CONDITION_SLOTS}) {
+        uint64_t count = header.sections[slots][1] / 8;
+        if (count == 0 || (count & (count - 1)) != 0) {
+            errorMessage = "Binary cache index section is malformed";
+            return false;
+        }
+    }
+    if (verifyContent &&
+        header.contentChecksum != checksum(image.substr(sizeof(ImageHeader)))) {
+        errorMessage = "Binary cache content checksum mismatch";
+        return false;
+    }
+
+    auto section = [&](Section id) { return image.data() + header.sections[id][0]; };
+    auto count = [&](Section id, size_t size) { return static_cast<size_t>(header.sections[id][1] / size); };
+    std::string_view blob(section(BLOB), header.sections[BLOB][1]);
+    std::span<const Scope> scopes(reinterpret_cast<const Scope*>(section(SCOPES)), count(SCOPES, sizeof(Scope)));
+    std::span<const Block> blocks(reinterpret_cast<const Block*>(section(BLOCKS)), count(BLOCKS, sizeof(Block)));
+    std::span<const Toggle> toggles(reinterpret_cast<const Toggle*>(section(TOGGLES)), count(TOGGLES, sizeof(Toggle)));
+    std::span<const Fsm> fsms(reinterpret_cast<const Fsm*>(section(FSMS)), count(FSMS, sizeof(Fsm)));
+    std::span<const Condition> conditions(reinterpret_cast<const Condition*>(section(CONDITIONS)),
+                                          count(CONDITIONS, sizeof(Condition)));
+
+    // Lookups trust the scope ranges, so check them (one pass over the scopes only)
+    for (const auto& scope : scopes) {
+        if (scope.blockBegin > scope.blockEnd || scope.blockEnd > blocks.size() ||
+            scope.toggleBegin > scope.toggleEnd || scope.toggleEnd > toggles.size() ||
+            scope.fsmBegin > scope.fsmEnd || scope.fsmEnd > fsms.size() ||
+            scope.conditionBegin > scope.conditionEnd || scope.conditionEnd > conditions.size()) {
+            errorMessage = "Binary cache scope table is malformed";
+            return false;
+        }
+    }
+
+    storage_ = std::move(storage);
+    image_ = image;
+    blob_ = blob;
+    scopes_ = scopes;
+    blocks_ = blocks;
+    toggles_ = toggles;
+    fsms_ = fsms;
+    conditions_ = conditions;
+    toggleOrder_ = std::span<const uint32_t>(reinterpret_cast<const uint32_t*>(section(TOGGLE_ORDER)),
+                                             count(TOGGLE_ORDER, sizeof(uint32_t)));
+    auto index = [&](Section id) {
+        std::span<const uint64_t> slots(reinterpret_cast<const uint64_t*>(section(id)), count(id, 8));
+        return HashIndex{slots, slots.size() - 1};
+    };
+    scopeIndex_ = index(SCOPE_SLOTS);
+    blockIndex_ = index(BLOCK_SLOTS);
+    conditionIndex_ = index(CONDITION_SLOTS);
+
+    const auto* metadata = reinterpret_cast<const TextRef*>(section(METADATA));
+    fileName = text(metadata[0]);
+    generatedBy = text(metadata[1]);
+    formatVersion = text(metadata[2]);
+    generationDate = text(metadata[3]);
+    exclusionMode = text(metadata[4]);
+    return true;
+}
+
+uint64_t FrozenExclusionData::hashKey(std::string_view key, uint64_t scope) {
+    // Mix so the upper half of the hash is usable as a tag as well
+    uint64_t hash = checksum(key) + scope * 0x9e3779b97f4a7c15ULL;
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+template <typename Match>
+const uint64_t* FrozenExclusionData::HashIndex::find(uint64_t hash, Match&& match) const {
+    if (slots.empty()) {
+        return nullptr;
+    }
+    uint64_t tag = hash & 0xffffffff00000000ULL;
+    for (uint64_t slot = hash & mask; slots[slot] != 0; slot = (slot + 1) & mask) {
+        if ((slots[slot] & 0xffffffff00000000ULL) == tag && match((slots[slot] & 0xffffffffULL) - 1)) {
+            return &slots[slot];
+        }
+    }
+    return nullptr;
+}
+
+const FrozenExclusionData::Scope* FrozenExclusionData::findScope(std::string_view scopeName) const {
+    const uint64_t* slot = scopeIndex_.find(hashKey(scopeName), [&](uint64_t index) {
+        return index < scopes_.size() && text(scopes_[index].name) == scopeName;
+    });
+    return slot ? &scopes_[(*slot & 0xffffffffULL) - 1] : nullptr;
+}
+
+const FrozenExclusionData::Block* FrozenExclusionData::findBlock(const Scope& scope, std::string_view blockId) const {
+    const uint64_t* slot = blockIndex_.find(hashKey(blockId, static_cast<uint64_t>(&scope - scopes_.data()) + 1),
+                                            [&](uint64_t index) {
+        return index >= scope.blockBegin && index < scope.blockEnd && text(blocks_[index].blockId) == blockId;
+    });
+    return slot ? &blocks_[(*slot & 0xffffffffULL) - 1] : nullptr;
+}
+
+const FrozenExclusionData::Condition* FrozenExclusionData::findCondition(const Scope& scope,
+                                                                         std::string_view conditionId) const {
+    const uint64_t* slot = conditionIndex_.find(hashKey(conditionId, static_cast<uint64_t>(&scope - scopes_.data()) + 1),
+                                                [&](uint64_t index) {
+        return index >= scope.conditionBegin && index < scope.conditionEnd &&
+               text(conditions_[index].conditionId) == conditionId;
+    });
+    return slot ? &conditions_[(*slot & 0xffffffffULL) - 1] : nullptr;
+}
+
+std::span<const FrozenExclusionData::Toggle> FrozenExclusionData::findToggles(const Scope& scope,
+                                                                              std::string_view signalName) const {
+    std::span<const Toggle> all = toggles(scope);
+    auto [first, last] = std::equal_range(all.begin(), all.end(), signalName, [this](const auto& a, const auto& b) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(a)>, Toggle>) {
+            return text(a.signalName) < b;
+        } else {
+            return a < text(b.signalName);
+        }
+    });
+    return all.subspan(static_cast<size_t>(first - all.begin()), static_cast<size_t>(last - first));
+}
+
+std::span<const FrozenExclusionData::Fsm> FrozenExclusionData::findFsms(const Scope& scope,
+                                                                        std::string_view fsmName) const {
+    std::span<const Fsm> all = fsms(scope);
+    auto [first, last] = std::equal_range(all.begin(), all.end(), fsmName, [this](const auto& a, const auto& b) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(a)>, Fsm>) {
+            return text(a.fsmName) < b;
+        } else {
+            return a < text(b.fsmName);
+        }
+    });
+    return all.subspan(static_cast<size_t>(first - all.begin()), static_cast<size_t>(last - first));
+}
+
+void FrozenExclusionData::accept(ExclusionVisitor& visitor) const {
+    const std::pair<HeaderField, const std::string*> headers[] = {
+        {HeaderField::GENERATED_BY, &generatedBy},
+        {HeaderField::FORMAT_VERSION, &formatVersion},
+        {HeaderField::GENERATION_DATE, &generationDate},
+        {HeaderField::EXCLUSION_MODE, &exclusionMode}
+    };
+    for (const auto& [field, value] : headers) {
+        if (!value->empty()) {
+            visitor.onHeader(field, *value);
+        }
+    }
+
+    for (const auto& scope : scopes_) {
+        ScopeView view{text(scope.name), text(scope.checksum), scope.isModule};
+        if (!view.checksum.empty()) {
+            visitor.onChecksum(view.checksum);
+        }
+        visitor.onScope(view);
+
+        for (const auto& block : blocks(scope)) {
+            visitor.onBlock(BlockView{view, text(block.blockId), text(block.checksum), text(block.sourceCode),
+                                      text(block.annotation)});
+        }
+        // In stored order, so the rebuilt toggle list and table match the source
+        std::span<const Toggle> scopeToggles = toggles(scope);
+        for (uint32_t position : toggleOrder_.subspan(scope.toggleBegin, scopeToggles.size())) {
+            if (position >= scopeToggles.size()) {
+                continue;   // Damaged entry (only possible when loaded without verifyContent)
+            }
+            const Toggle& toggle = scopeToggles[position];
+            visitor.onToggle(ToggleView{view, toggle.direction, text(toggle.signalName), {}, toggle.bitIndex(),
+                                        text(toggle.netDescription), text(toggle.annotation)});
+        }
+        for (const auto& fsm : fsms(scope)) {
+            if (fsm.isTransition) {
+                visitor.onTransition(TransitionView{view, text(fsm.fromState), text(fsm.toState),
+                                                    text(fsm.transitionId), text(fsm.annotation)});
+            } else {
+                visitor.onFsm(FsmView{view, text(fsm.fsmName), text(fsm.checksum), text(fsm.annotation)});
+            }
+        }
+        for (const auto& condition : conditions(scope)) {
+            visitor.onCondition(ConditionView{view, text(condition.conditionId), text(condition.checksum),
+                                              text(condition.expression), text(condition.parameters),
+                                              text(condition.coverage), text(condition.annotation)});
+        }
+    }
+}
+
+std::unordered_map<ExclusionType, size_t> FrozenExclusionData::getExclusionCountsByType() const {
+    return {
+        {ExclusionType::BLOCK, blocks_.size()},
+        {ExclusionType::TOGGLE, toggles_.size()},
+        {ExclusionType::FSM, fsms_.size()},
+        {ExclusionType::CONDITION, conditions_.size()}
+    };
+}
+
+ExclusionStatistics FrozenExclusionData::getStatistics() const {
+    ExclusionStatistics stats;
+    stats.totalScopes = scopes_.size();
+    stats.totalExclusions = getTotalExclusionCount();
+    stats.exclusionsByType = getExclusionCountsByType();
+
+    for (const auto& scope : scopes_) {
+        if (scope.isModule) {
+            stats.moduleScopes++;
+        } else {
+            stats.instanceScopes++;
+        }
+        stats.exclusionsByScope[std::string(text(scope.name))] = scope.getTotalExclusionCount();
+    }
+
+    for (const auto& block : blocks_) {
+        if (!block.annotation.empty()) stats.annotatedExclusions++;
+    }
+    for (const auto& toggle : toggles_) {
+        if (!toggle.annotation.empty()) stats.annotatedExclusions++;
+    }
+    for (const auto& fsm : fsms_) {
+        if (!fsm.annotation.empty()) stats.annotatedExclusions++;
+    }
+    for (const auto& condition : conditions_) {
+        if (!condition.annotation.empty()) stats.annotatedExclusions++;
+    }
+    return stats;
+}
+
+} // namespace ExclusionParser
@@ -0,0 +1,348 @@
+/**
+ * @file ExclusionLookup.cpp
+ * @brief Implementation of the read-optimized exclusion point lookup
+ *
+ * @author AMD Advanced Micro Devices Inc. - Verification Infrastructure Team
+ * @version 2.0.0
+ * @date September 13, 2025
+ * @copyright (c) 2025 Advanced Micro Devices Inc. All rights reserved.
+ */
+
+#include "ExclusionLookup.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace ExclusionParser {
+
+namespace {
+
+/// Item kinds mixed into every key so equal text of different kinds differs
+enum class ItemKind : uint64_t {
+    BLOCK = 1,
+    TOGGLE = 2,
+    FSM_STATE = 3,
+    FSM_TRANSITION = 4,
+    CONDITION = 5
+};
+
+/**
+ * @brief MurmurHash3 64-bit finalizer
+ */
+inline uint64_t finalize(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/**
+ * @brief Two independent 64-bit hash lanes fed with words and strings
+ */
+struct Hasher {
+    uint64_t a;
+    uint64_t b;
+
+    Hasher(uint64_t seedA, uint64_t seedB) : a(seedA), b(seedB) {}
+
+    void add(uint64_t value) {
+        a = finalize(a ^ (value * 0x9e3779b97f4a7c15ULL));
+        b = finalize((b + 0x632be59bd9b4e019ULL) ^ (value * 0x94d049bb133111ebULL));
+    }
+
+    void add(std::string_view text) {
+        size_t position = 0;
+        for (; position + 8 <= text.size(); position += 8) {
+            uint64_t word;
+            std::memcpy(&word, text.data() + position, 8);
+            add(word);
+        }
+        uint64_t tail = 0;
+        if (position < text.size()) {
+            // An empty view may have a null data(), which memcpy must not see
+            std::memcpy(&tail, text.data() + position, text.size() - position);
+        }
+        // The length separates consecutive fields ("ab"+"c" vs "a"+"bc")
+        add(tail ^ (static_cast<uint64_t>(text.size()) << 56));
+    }
+
+    LookupKey key() const {
+        LookupKey key{a, b};
+        if (key.primary == 0 && key.check == 0) {
+            key.check = 1;    // All-zero marks an empty slot
+        }
+        return key;
+    }
+};
+
+inline Hasher itemHasher(ScopeKey scope, ItemKind kind) {
+    Hasher hasher(scope.primary, scope.check);
+    hasher.add(static_cast<uint64_t>(kind));
+    return hasher;
+}
+
+inline uint64_t bitWord(std::optional<int> bitIndex) {
+    return bitIndex.has_value() ? (1ULL << 32) | static_cast<uint32_t>(*bitIndex) : 0;
+}
+
+} // namespace
+
+BloomFilter::BloomFilter(std::span<const LookupKey> keys, double falsePositiveRate) : BloomFilter() {
+    if (keys.empty()) {
+        return;
+    }
+
+    // Optimal bits per key and hash count: m/n = -ln(p) / ln(2)^2, k = (m/n) ln(2)
+    double rate = std::clamp(falsePositiveRate, 1e-6, 0.5);
+    double bitsPerKey = -std::log(rate) / (std::log(2.0) * std::log(2.0));
+    hashCount_ = static_cast<uint32_t>(std::clamp(std::lround(bitsPerKey * std::log(2.0)), 1L, 16L));
+
+    // Blocking skews the load, so round the block count up rather than down
+    double blockCount = std::ceil(bitsPerKey * static_cast<double>(keys.size()) / 512.0);
+    size_t blocks = 1;
+    while (static_cast<double>(blocks) < blockCount) {
+        blocks *= 2;
+    }
+    blocks_.assign(blocks, Block());
+    blockMask_ = blocks - 1;
+
+    for (const auto& key : keys) {
+        Block& block = blocks_[key.check & blockMask_];
+        for (uint32_t i = 0; i < hashCount_; ++i) {
+            uint32_t bit = bitPosition(key, i);
+            block.words[bit >> 6] |= 1ULL << (bit & 63);
+        }
+    }
+}
+
+ExclusionLookup::ExclusionLookup() : slots_(1), mask_(0), size_(0), filterRate_(0.0), countFilter_(false) {
+}
+
+ExclusionLookup::ExclusionLookup(const ExclusionData& data) : ExclusionLookup() {
+    std::vector<LookupKey> keys;
+    keys.reserve(data.getTotalExclusionCount() * 2);
+
+    for (const auto& [scopeName, scope] : data.scopes) {
+        ScopeKey scopeHash = scopeKey(scopeName);
+
+        for (const auto& [blockId, block] : scope.blockExclusions) {
+            keys.push_back(blockKey(scopeHash, blockId));
+        }
+
+        // Collect the excluded directions per signal bit, from both toggle stores
+        struct BitKey {
+            std::string_view signal;
+            std::optional<int> bit;
+            bool operator==(const BitKey& other) const = default;
+        };
+        struct BitKeyHash {
+            size_t operator()(const BitKey& key) const {
+                return std::hash<std::string_view>{}(key.signal) ^ static_cast<size_t>(bitWord(key.bit) * 0x9e3779b97f4a7c15ULL);
+            }
+        };
+        std::unordered_map<BitKey, uint8_t, BitKeyHash> directions;
+        auto addDirection = [&](std::string_view signal, std::optional<int> bit, ToggleDirection direction) {
+            directions[BitKey{signal, bit}] |= ToggleTable::directionBit(direction);
+        };
+        for (const auto& [signalName, toggles] : scope.toggleExclusions) {
+            for (const auto& toggle : toggles) {
+                addDirection(signalName, toggle.bitIndex, toggle.direction);
+            }
+        }
+        for (size_t row = 0; row < scope.toggleTable.getRowCount(); ++row) {
+            scope.toggleTable.forEachDirection(row, [&](ToggleDirection direction) {
+                addDirection(scope.toggleTable.signalName(row), scope.toggleTable.bitIndex(row), direction);
+            });
+        }
+        for (const auto& [bitKey, mask] : directions) {
+            bool rising = (mask & (ToggleTable::ZERO_TO_ONE_BIT | ToggleTable::BOTH_BIT)) != 0;
+            bool falling = (mask & (ToggleTable::ONE_TO_ZERO_BIT | ToggleTable::BOTH_BIT)) != 0;
+            if (rising) keys.push_back(toggleKey(scopeHash, bitKey.signal, bitKey.bit, ToggleDirection::ZERO_TO_ONE));
+            if (falling) keys.push_back(toggleKey(scopeHash, bitKey.signal, bitKey.bit, ToggleDirection::ONE_TO_ZERO));
+            if (rising && falling) keys.push_back(toggleKey(scopeHash, bitKey.signal, bitKey.bit, ToggleDirection::BOTH));
+        }
+
+        for (const auto& [fsmName, fsms] : scope.fsmExclusions) {
+            for (const auto& fsm : fsms) {
+                keys.push_back(fsm.isTransition ? fsmTransitionKey(scopeHash, fsm.fromState, fsm.toState)
+                                                : fsmStateKey(scopeHash, fsm.fsmName));
+            }
+        }
+
+        for (const auto& [condId, condition] : scope.conditionExclusions) {
+            keys.push_back(conditionKey(scopeHash, condId));
+            if (!condition.coverage.empty()) {
+                keys.push_back(conditionKey(scopeHash, condId, condition.coverage));
+            }
+        }
+    }
+
+    // At most half full, so probe sequences stay short
+    size_t capacity = 2;
+    while (capacity < keys.size() * 2) {
+        capacity *= 2;
+    }
+    slots_.assign(capacity, LookupKey{});
+    mask_ = capacity - 1;
+    for (const auto& key : keys) {
+        insert(key);
+    }
+}
+
+void ExclusionLookup::insert(const LookupKey& key) {
+    uint64_t slot = key.primary & mask_;
+    while (true) {
+        LookupKey& stored = slots_[slot];
+        if (stored == key) return;
+        if (stored.primary == 0 && stored.check == 0) {
+            stored = key;
+            size_++;
+            return;
+        }
+        slot = (slot + 1) & mask_;
+    }
+}
+
+ScopeKey ExclusionLookup::scopeKey(std::string_view scopeName) {
+    Hasher hasher(0x2545f4914f6cdd1dULL, 0x5851f42d4c957f2dULL);
+    hasher.add(scopeName);
+    return ScopeKey{hasher.a, hasher.b};
+}
+
+LookupKey ExclusionLookup::blockKey(ScopeKey scope, std::string_view blockId) {
+    Hasher hasher = itemHasher(scope, ItemKind::BLOCK);
+    hasher.add(blockId);
+    return hasher.key();
+}
+
+LookupKey ExclusionLookup::toggleKey(ScopeKey scope, std::string_view signalName, std::optional<int> bitIndex,
+                                     ToggleDirection direction) {
+    Hasher hasher = itemHasher(scope, ItemKind::TOGGLE);
+    hasher.add(signalName);
+    hasher.add(bitWord(bitIndex));
+    hasher.add(static_cast<uint64_t>(direction));
+    return hasher.key();
+}
+
+LookupKey ExclusionLookup::fsmStateKey(ScopeKey scope, std::string_view fsmName) {
+    Hasher hasher = itemHasher(scope, ItemKind::FSM_STATE);
+    hasher.add(fsmName);
+    return hasher.key();
+}
+
+LookupKey ExclusionLookup::fsmTransitionKey(ScopeKey scope, std::string_view fromState, std::string_view toState) {
+    Hasher hasher = itemHasher(scope, ItemKind::FSM_TRANSITION);
+    hasher.add(fromState);
+    hasher.add(toState);
+    return hasher.key();
+}
+
+LookupKey ExclusionLookup::conditionKey(ScopeKey scope, std::string_view conditionId, std::string_view row) {
+    Hasher hasher = itemHasher(scope, ItemKind::CONDITION);
+    hasher.add(conditionId);
+    hasher.add(row);
+    return hasher.key();
+}
+
+size_t ExclusionLookup::containsBatch(std::span<const LookupKey> keys, std::span<bool> results) const {
+    constexpr size_t kGroup = 16;
+    size_t hits = 0;
+
+    if (!filter_.empty()) {
+        uint64_t passed = 0;
+        for (size_t begin = 0; begin < keys.size(); begin += kGroup) {
+            size_t end = std::min(begin + kGroup, keys.size());
+            for (size_t i = begin; i < end; ++i) {
+                filter_.prefetch(keys[i]);
+            }
+            // Filter the group, prefetching table slots for the survivors only
+            uint32_t survivors = 0;
+            for (size_t i = begin; i < end; ++i) {
+                results[i] = false;
+                if (filter_.mayContain(keys[i])) {
+                    survivors |= 1u << (i - begin);
+#if defined(__GNUC__) || defined(__clang__)
+                    __builtin_prefetch(&slots_[keys[i].primary & mask_]);
+#endif
+                }
+            }
+            for (size_t i = begin; i < end; ++i) {
+                if (survivors & (1u << (i - begin))) {
+                    bool hit = probe(keys[i]);
+                    results[i] = hit;
+                    hits += hit;
+                    ++passed;
+                }
+            }
+        }
+        if (countFilter_) {
+            filterMisses_.add(keys.size() - passed);
+            filterHits_.add(passed);
+            falsePositives_.add(passed - hits);
+        }
+        return hits;
+    }
+
+    for (size_t begin = 0; begin < keys.size(); begin += kGroup) {
+        size_t end = std::min(begin + kGroup, keys.size());
+#if defined(__GNUC__) || defined(__clang__)
+        // Start loading every slot of the group before probing the first one
+        for (size_t i = begin; i < end; ++i) {
+            __builtin_prefetch(&slots_[keys[i].primary & mask_]);
+        }
+#endif
+        for (size_t i = begin; i < end; ++i) {
+            bool hit = probe(keys[i]);
+            results[i] = hit;
+            hits += hit;
+        }
+    }
+    return hits;
+}
+
+void ExclusionLookup::buildFilter(double falsePositiveRate) {
+    std::vector<LookupKey> keys;
+    keys.reserve(size_);
+    for (const auto& slot : slots_) {
+        if (slot.primary != 0 || slot.check != 0) {
+            keys.push_back(slot);
+        }
+    }
+    filterRate_ = std::clamp(falsePositiveRate, 1e-6, 0.5);
+    filter_ = BloomFilter(keys, filterRate_);
+    resetFilterStatistics();
+}
+
+void ExclusionLookup::dropFilter() {
+    filter_ = BloomFilter();
+    filterRate_ = 0.0;
+    resetFilterStatistics();
+}
+
+void ExclusionLookup::setFilterCounting(bool enabled) {
+    countFilter_ = enabled;
+}
+
+FilterStatistics ExclusionLookup::getFilterStatistics() const {
+    FilterStatistics stats;
+    stats.enabled = !filter_.empty();
+    stats.falsePositiveRate = filterRate_;
+    stats.hashCount = filter_.getHashCount();
+    stats.memoryBytes = filter_.getMemoryUsage();
+    stats.counting = countFilter_;
+    stats.filterMisses = filterMisses_.load();
+    stats.filterHits = filterHits_.load();
+    stats.falsePositives = falsePositives_.load();
+    return stats;
+}
+
+void ExclusionLookup::resetFilterStatistics() {
+    filterMisses_.reset();
+    filterHits_.reset();
+    falsePositives_.reset();
+}
+
+} // namespace ExclusionParser
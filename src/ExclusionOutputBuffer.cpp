@@ -0,0 +1,42 @@
+/**
+ * @file ExclusionOutputBuffer.cpp
+ * @brief Implementation of the writer's output buffer
+ *
+ * @author AMD Advanced Micro Devices Inc. - Verification Infrastructure Team
+ * @version 2.0.0
+ * @date September 13, 2025
+ * @copyright (c) 2025 Advanced Micro Devices Inc. All rights reserved.
+ */
+
+#include "ExclusionOutputBuffer.h"
+#include <cstring>
+
+namespace ExclusionParser {
+
+void OutputBuffer::appendEscaped(std::string_view text) {
+    const char* position = text.data();
+    const char* end = position + text.size();
+    while (position != end) {
+        const char* quote = static_cast<const char*>(std::memchr(position, '"', static_cast<size_t>(end - position)));
+        if (!quote) {
+            buffer_.append(position, static_cast<size_t>(end - position));
+            return;
+        }
+        buffer_.append(position, static_cast<size_t>(quote - position));
+        buffer_.append("\\\"", 2);
+        position = quote + 1;
+    }
+}
+
+bool OutputBuffer::flush() {
+    if (!sink_) {
+        return true;
+    }
+    if (!buffer_.empty()) {
+        sink_->write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        buffer_.clear();
+    }
+    return static_cast<bool>(*sink_);
+}
+
+} // namespace ExclusionParser
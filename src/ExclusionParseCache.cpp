@@ -0,0 +1,251 @@
+/**
+ * @file ExclusionParseCache.cpp
+ * @brief Implementation of the on-disk parse cache
+ *
+ * @author AMD Advanced Micro Devices Inc. - Verification Infrastructure Team
+ * @version 2.0.0
+ * @date September 13, 2025
+ * @copyright (c) 2025 Advanced Micro Devices Inc. All rights reserved.
+ */
+
+#include "ExclusionParseCache.h"
+#include "ExclusionFrozenData.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+namespace ExclusionParser {
+
+namespace {
+
+constexpr char kEntryMagic[8] = {'E', 'X', 'C', 'L', '.', 'E', 'L', 'C'};
+constexpr uint32_t kEntryVersion = 2;    ///< Bumped whenever parse results change
+constexpr const char* kEntryExtension = ".elc";
+
+constexpr ExclusionType kCountedTypes[4] = {ExclusionType::BLOCK, ExclusionType::TOGGLE, ExclusionType::FSM,
+                                            ExclusionType::CONDITION};
+
+/**
+ * @brief Fixed entry header; warnings follow, then the .elb image at imageOffset
+ */
+struct EntryHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t warningCount;
+    uint64_t contentHash;
+    uint64_t contentSize;
+    uint64_t optionsHash;
+    uint64_t linesProcessed;
+    uint64_t exclusionsParsed;
+    uint64_t exclusionCounts[4];        ///< In kCountedTypes order
+    uint64_t warningBytes;              ///< Warnings, each a uint32_t length and its text
+    uint64_t imageOffset;               ///< 8-byte aligned
+    uint64_t imageSize;
+    uint64_t checksum;                  ///< Over the header bytes before this field and the warnings
+};
+
+static_assert(sizeof(EntryHeader) % 8 == 0, "warnings must start 8-byte aligned");
+
+uint64_t entryChecksum(const EntryHeader& header, std::string_view warnings) {
+    std::string bytes(reinterpret_cast<const char*>(&header), offsetof(EntryHeader, checksum));
+    bytes.append(warnings);
+    return FrozenExclusionData::checksum(bytes);
+}
+
+std::string toHex(uint64_t value) {
+    static const char digits[] = "0123456789abcdef";
+    std::string text(16, '0');
+    for (int i = 15; i >= 0; --i, value >>= 4) {
+        text[static_cast<size_t>(i)] = digits[value & 15];
+    }
+    return text;
+}
+
+} // namespace
+
+ParseCache::ParseCache(const std::string& directory, size_t maxBytes)
+    : directory_(directory), maxBytes_(maxBytes) {}
+
+ParseCache::Key ParseCache::makeKey(std::string_view content, const ParserConfig& config) {
+    Key key;
+    key.contentHash = FrozenExclusionData::checksum(content);
+    key.contentSize = content.size();
+    // Only options that change the parsed data or the warnings; the toggle
+    // store is chosen when the entry is replayed
+    const char options[] = {static_cast<char>(config.strictMode), static_cast<char>(config.validateChecksums)};
+    key.optionsHash = FrozenExclusionData::checksum(std::string_view(options, sizeof(options)));
+    return key;
+}
+
+std::string ParseCache::getEntryPath(const Key& key) const {
+    return (std::filesystem::path(directory_) / (toHex(key.contentHash) + "-" + toHex(key.optionsHash) +
+                                                 kEntryExtension)).string();
+}
+
+bool ParseCache::load(const Key& key, FrozenExclusionData& frozen, ParseResult& result) const {
+    std::string path = getEntryPath(key);
+    auto file = std::make_shared<FileUtils::MappedFile>();
+    if (!file->open(path)) {
+        return false;
+    }
+
+    std::string_view entry = file->view();
+    EntryHeader header;
+    if (entry.size() < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, entry.data(), sizeof(header));
+    if (std::memcmp(header.magic, kEntryMagic, sizeof(kEntryMagic)) != 0 || header.version != kEntryVersion ||
+        header.contentHash != key.contentHash || header.contentSize != key.contentSize ||
+        header.optionsHash != key.optionsHash || header.warningBytes > entry.size() - sizeof(header) ||
+        header.imageOffset % 8 != 0 || header.imageOffset < sizeof(header) + header.warningBytes ||
+        header.imageOffset > entry.size() || header.imageSize != entry.size() - header.imageOffset) {
+        return false;
+    }
+    std::string_view warnings = entry.substr(sizeof(header), header.warningBytes);
+    if (header.checksum != entryChecksum(header, warnings)) {
+        return false;
+    }
+
+    ParseResult cached;
+    for (uint32_t i = 0; i < header.warningCount; ++i) {
+        uint32_t length;
+        if (warnings.size() < sizeof(length)) {
+            return false;
+        }
+        std::memcpy(&length, warnings.data(), sizeof(length));
+        if (warnings.size() - sizeof(length) < length) {
+            return false;
+        }
+        cached.warnings.emplace_back(warnings.substr(sizeof(length), length));
+        warnings.remove_prefix(sizeof(length) + length);
+    }
+
+    cached.inputMode = file->isMapped() ? InputMode::MEMORY_MAPPED : InputMode::BUFFERED;
+    std::string_view image = entry.substr(header.imageOffset);
+    std::string errorMessage;
+    if (!FrozenExclusionData::fromImage(std::move(file), image, frozen, errorMessage)) {
+        return false;
+    }
+
+    cached.success = true;
+    cached.linesProcessed = header.linesProcessed;
+    cached.exclusionsParsed = header.exclusionsParsed;
+    for (size_t i = 0; i < 4; ++i) {
+        if (header.exclusionCounts[i] != 0) {
+            cached.exclusionCounts[kCountedTypes[i]] = header.exclusionCounts[i];
+        }
+    }
+    result = std::move(cached);
+
+    // Mark the entry as recently used
+    std::error_code error;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error);
+    return true;
+}
+
+bool ParseCache::store(const Key& key, const FrozenExclusionData& frozen, const ParseResult& result,
+                       std::string& errorMessage) const {
+    std::string warnings;
+    for (const auto& warning : result.warnings) {
+        uint32_t length = static_cast<uint32_t>(warning.size());
+        warnings.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        warnings.append(warning);
+    }
+
+    EntryHeader header{};
+    std::memcpy(header.magic, kEntryMagic, sizeof(kEntryMagic));
+    header.version = kEntryVersion;
+    header.warningCount = static_cast<uint32_t>(result.warnings.size());
+    header.contentHash = key.contentHash;
+    header.contentSize = key.contentSize;
+    header.optionsHash = key.optionsHash;
+    header.linesProcessed = result.linesProcessed;
+    header.exclusionsParsed = result.exclusionsParsed;
+    for (size_t i = 0; i < 4; ++i) {
+        auto count = result.exclusionCounts.find(kCountedTypes[i]);
+        header.exclusionCounts[i] = count != result.exclusionCounts.end() ? count->second : 0;
+    }
+    header.warningBytes = warnings.size();
+    header.imageOffset = (sizeof(header) + warnings.size() + 7) & ~uint64_t(7);
+    header.imageSize = frozen.getImage().size();
+    header.checksum = entryChecksum(header, warnings);
+
+    std::error_code error;
+    std::filesystem::create_directories(directory_, error);
+
+    // Write beside the entry, then rename over it so readers see all or nothing
+    std::string path = getEntryPath(key);
+    std::random_device random;
+    std::string temporary = path + ".tmp" + toHex((uint64_t(random()) << 32) | random());
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            errorMessage = "Cannot create file: " + temporary;
+            return false;
+        }
+        warnings.resize(header.imageOffset - sizeof(header), '\0');
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(warnings.data(), static_cast<std::streamsize>(warnings.size()));
+        file.write(frozen.getImage().data(), static_cast<std::streamsize>(header.imageSize));
+        file.close();
+        if (!file) {
+            std::filesystem::remove(temporary, error);
+            errorMessage = "Cannot write file: " + temporary;
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::filesystem::remove(temporary, error);
+        errorMessage = "Cannot rename " + temporary + " to " + path;
+        return false;
+    }
+    return true;
+}
+
+size_t ParseCache::evict() const {
+    struct Entry {
+        std::filesystem::path path;
+        uintmax_t size;
+        std::filesystem::file_time_type lastUsed;
+    };
+
+    std::vector<Entry> entries;
+    uintmax_t totalBytes = 0;
+    std::error_code error;
+    for (const auto& item : std::filesystem::directory_iterator(directory_, error)) {
+        if (item.path().extension() != kEntryExtension) {
+            continue;
+        }
+        Entry entry{item.path(), item.file_size(error), item.last_write_time(error)};
+        if (!error) {
+            totalBytes += entry.size;
+            entries.push_back(std::move(entry));
+        }
+    }
+    if (totalBytes <= maxBytes_) {
+        return 0;
+    }
+
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) { return a.lastUsed < b.lastUsed; });
+    size_t removed = 0;
+    for (const auto& entry : entries) {
+        if (totalBytes <= maxBytes_) {
+            break;
+        }
+        if (std::filesystem::remove(entry.path, error)) {
+            totalBytes -= entry.size;
+            removed++;
+        }
+    }
+    return removed;
+}
+
+} // namespace ExclusionParser
@@ -20,11 +20,23 @@
  */
 
 #include "ExclusionParser.h"
+#include "ExclusionFrozenData.h"
+#include "ExclusionParseCache.h"
+#include "ExclusionThreadPool.h"
+#include "ExclusionTokenizer.h"
 #include <iostream>
 #include <algorithm>
+#include <charconv>
 #include <regex>
 #include <filesystem>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace ExclusionParser {
 
 // ParseResult implementation
@@ -34,6 +46,10 @@ std::string ParseResult::getSummary() const {
     oss << "Lines processed: " << linesProcessed << "\n";
     oss << "Exclusions parsed: " << exclusionsParsed << "\n";
     
+    if (cacheHits != 0 || cacheMisses != 0) {
+        oss << "Cache hits: " << cacheHits << ", misses: " << cacheMisses << "\n";
+    }
+    
     if (!warnings.empty()) {
         oss << "Warnings (" << warnings.size() << "):\n";
         for (const auto& warning : warnings) {
@@ -50,13 +66,153 @@ std::string ParseResult::getSummary() const {
 
 // ExclusionParser implementation
 ExclusionParser::ExclusionParser() 
-    : data_(std::make_shared<ExclusionData>()), debugMode_(false) {
+    : data_(std::make_shared<ExclusionData>()), visitor_(nullptr), debugMode_(false) {
     dataManager_.setData(data_);
     resetState();
 }
 
 ExclusionParser::~ExclusionParser() = default;
 
+struct ExclusionParser::LoadedInput {
+    std::string filename;           ///< Path as given by the caller
+    FileUtils::MappedFile file;     ///< File contents
+    bool opened = false;            ///< False if the file could not be opened
+    std::string errorMessage;       ///< Open error, if any
+    ParseCache::Key cacheKey;       ///< Key of the file's cache entry (cache enabled only)
+    bool cacheHit = false;          ///< True if cached below, so the file is replayed rather than parsed
+    FrozenExclusionData cached;     ///< Cached data of the file
+    ParseResult cachedResult;       ///< Cached counters and warnings of the file
+};
+
+namespace {
+
+/**
+ * @brief Return the trimmed text after the first ':' of a line
+ * @param line Line to split
+ * @param value Receives the trimmed value
+ * @return False if the line has nothing after the colon
+ */
+bool valueAfterColon(std::string_view line, std::string_view& value) {
+    size_t pos = line.find(':');
+    if (pos == std::string_view::npos || pos + 1 >= line.length()) {
+        return false;
+    }
+    value = Tokenizer::trim(line.substr(pos + 1));
+    return true;
+}
+
+/**
+ * @brief Piece of a file that can be parsed independently
+ * 
+ * The scope fields hold the parser state in effect at the chunk's first
+ * line, so a chunk may start in the middle of an INSTANCE/MODULE record.
+ */
+struct BufferChunk {
+    std::string_view text;          ///< Chunk contents
+    size_t firstLine;               ///< 1-based line number of the first line
+    std::string_view scope;         ///< Current INSTANCE/MODULE at the first line
+    std::string_view checksum;      ///< Current CHECKSUM at the first line
+    bool isModule;                  ///< Whether the current scope is a MODULE
+};
+
+/**
+ * @brief Check whether a Transition line is well formed (i.e. it consumes the pending annotation)
+ * @param line Trimmed Transition line
+ * @return True if parseTransition would accept it
+ */
+bool isCompleteTransition(std::string_view line) {
+    std::string_view remaining = line.substr(11); // Skip "Transition "
+    size_t arrowPos = remaining.find("->");
+    return arrowPos != std::string_view::npos && 
+           remaining.find(' ', arrowPos) != std::string_view::npos;
+}
+
+/**
+ * @brief Split a buffer at line boundaries that are safe to parse independently
+ * 
+ * A pre-scan classifies every line and tracks the scope, checksum and
+ * annotation state the parser would have. A chunk may start before any line
+ * at which no annotation can be pending (the last annotation, if any, was
+ * consumed by an exclusion) and no ANNOTATION_BEGIN run is open; it is
+ * seeded with the tracked scope state.
+ * Chunks are at least targetBytes long, except possibly the last.
+ * 
+ * @param buffer Complete file contents
+ * @param targetBytes Minimum chunk size
+ * @return Chunks covering the buffer in order
+ */
+std::vector<BufferChunk> splitAtSafeBoundaries(std::string_view buffer, size_t targetBytes) {
+    std::vector<BufferChunk> chunks;
+    BufferChunk current{{}, 1, {}, {}, false};
+    size_t chunkStart = 0;
+    
+    std::string_view scope;         // Mirrors currentScope_
+    std::string_view checksum;      // Mirrors currentChecksum_
+    bool isModule = false;          // Mirrors currentIsModule_
+    bool pendingClear = true;       // pendingAnnotation_ is known to be empty
+    bool runOpen = false;           // Mirrors !runAnnotation_.empty() (conservatively)
+    
+    Tokenizer::LineReader reader(buffer);
+    std::string_view rawLine;
+    size_t lineStart = 0;
+    
+    while (reader.next(rawLine)) {
+        if (pendingClear && !runOpen && lineStart - chunkStart >= targetBytes && 
+            buffer.size() - lineStart >= targetBytes) {
+            current.text = buffer.substr(chunkStart, lineStart - chunkStart);
+            chunks.push_back(current);
+            current = {{}, reader.lineNumber(), scope, checksum, isModule};
+            chunkStart = lineStart;
+        }
+        
+        std::string_view line = Tokenizer::trim(rawLine);
+        std::string_view value;
+        
+        switch (Tokenizer::classifyLine(line)) {
+            case Tokenizer::LineKind::CHECKSUM:
+                if (valueAfterColon(line, value)) {
+                    checksum = Tokenizer::unquote(value);
+                }
+                break;
+            case Tokenizer::LineKind::INSTANCE:
+            case Tokenizer::LineKind::MODULE:
+                if (valueAfterColon(line, value)) {
+                    scope = value;
+                    isModule = line[0] == 'M';
+                }
+                break;
+            case Tokenizer::LineKind::ANNOTATION:
+                pendingClear = false;
+                break;
+            case Tokenizer::LineKind::ANNOTATION_BEGIN:
+                runOpen = true;
+                break;
+            case Tokenizer::LineKind::ANNOTATION_END:
+                runOpen = false;
+                break;
+            case Tokenizer::LineKind::BLOCK:
+            case Tokenizer::LineKind::TOGGLE:
+            case Tokenizer::LineKind::FSM:
+            case Tokenizer::LineKind::CONDITION:
+                pendingClear = pendingClear || !scope.empty();
+                break;
+            case Tokenizer::LineKind::TRANSITION:
+                pendingClear = pendingClear || (!scope.empty() && isCompleteTransition(line));
+                break;
+            default:
+                break;
+        }
+        
+        lineStart = reader.position();
+    }
+    
+    current.text = buffer.substr(chunkStart);
+    chunks.push_back(current);
+    return chunks;
+}
+
+} // anonymous namespace
+
 void ExclusionParser::setConfig(const ParserConfig& config) {
     config_ = config;
 }
@@ -71,35 +227,99 @@ ParseResult ExclusionParser::parseFile(const std::string& filename) {
     ParseResult result;
     resetState();
     
-    // Check if file exists
-    if (!FileUtils::fileExists(filename)) {
-        result.errorMessage = "File does not exist: " + filename;
+    FileUtils::MappedFile file;
+    if (!openInput(filename, file, result.errorMessage)) {
         return result;
     }
     
-    // Check file size
-    size_t fileSize = FileUtils::getFileSize(filename);
-    if (fileSize > config_.maxFileSize) {
-        result.errorMessage = "File too large: " + std::to_string(fileSize) + 
-                             " bytes (max: " + std::to_string(config_.maxFileSize) + ")";
+    // Update filename in data
+    if (!config_.mergeOnLoad || !data_) {
+        data_ = std::make_shared<ExclusionData>(filename);
+        dataManager_.setData(data_);
+    }
+    
+    data_->fileName = filename;
+    
+    if (!config_.cacheDirectory.empty() ||
+        (config_.splitLargeFiles && file.size() >= 2 * config_.splitChunkSize)) {
+        std::vector<LoadedInput> inputs(1);
+        inputs[0].filename = filename;
+        inputs[0].file = std::move(file);
+        inputs[0].opened = true;
+        return parseInputs(inputs, false);
+    }
+    
+    ExclusionDataBuilder builder(*data_, config_.columnarToggles);
+    return parseBuffer(file.view(), filename, 
+                       file.isMapped() ? InputMode::MEMORY_MAPPED : InputMode::BUFFERED, builder);
+}
+
+ParseResult ExclusionParser::parseFile(const std::string& filename, ExclusionVisitor& visitor) {
+    debugLog("Starting to visit file: " + filename);
+    
+    ParseResult result;
+    resetState();
+    
+    FileUtils::MappedFile file;
+    if (!openInput(filename, file, result.errorMessage)) {
         return result;
     }
     
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        result.errorMessage = "Cannot open file: " + filename;
+    return parseBuffer(file.view(), filename, 
+                       file.isMapped() ? InputMode::MEMORY_MAPPED : InputMode::BUFFERED, visitor);
+}
+
+ParseResult ExclusionParser::loadBinaryFile(const std::string& filename, FrozenExclusionData& frozen,
+                                            bool verifyContent) const {
+    debugLog("Loading binary cache: " + filename);
+    
+    ParseResult result;
+    auto file = std::make_shared<FileUtils::MappedFile>();
+    if (!openInput(filename, *file, result.errorMessage)) {
         return result;
     }
     
-    // Update filename in data
-    if (!config_.mergeOnLoad || !data_) {
-        data_ = std::make_shared<ExclusionData>(filename);
-        dataManager_.setData(data_);
+    result.inputMode = file->isMapped() ? InputMode::MEMORY_MAPPED : InputMode::BUFFERED;
+    std::string_view image = file->view();
+    if (!FrozenExclusionData::fromImage(std::move(file), image, frozen, result.errorMessage, verifyContent)) {
+        result.errorMessage = filename + ": " + result.errorMessage;
+        return result;
     }
     
-    data_->fileName = filename;
+    result.success = true;
+    result.exclusionsParsed = frozen.getTotalExclusionCount();
+    result.exclusionCounts = frozen.getExclusionCountsByType();
+    return result;
+}
+
+bool ExclusionParser::openInput(const std::string& filename, FileUtils::MappedFile& file, 
+                                std::string& errorMessage) const {
+    // Check if file exists
+    if (!FileUtils::fileExists(filename)) {
+        errorMessage = "File does not exist: " + filename;
+        return false;
+    }
     
-    return parseStream(file, filename);
+    // Map the file if allowed; maxFileSize only limits the heap-buffered path
+    if (config_.useMemoryMap) {
+        file.open(filename, true);
+    }
+    
+    if (!file.isMapped()) {
+        size_t fileSize = FileUtils::getFileSize(filename);
+        if (fileSize > config_.maxFileSize) {
+            errorMessage = "File too large: " + std::to_string(fileSize) + 
+                           " bytes (max: " + std::to_string(config_.maxFileSize) + ")";
+            return false;
+        }
+        
+        if (!file.isOpen() && !file.open(filename, false)) {
+            errorMessage = "Cannot open file: " + filename;
+            return false;
+        }
+    }
+    
+    return true;
 }
 
 ParseResult ExclusionParser::parseString(const std::string& content, 
@@ -107,82 +327,80 @@ ParseResult ExclusionParser::parseString(const std::string& content,
     debugLog("Starting to parse string content");
     
     resetState();
-    std::istringstream stream(content);
-    return parseStream(stream, sourceIdentifier);
+    ExclusionDataBuilder builder(*data_, config_.columnarToggles);
+    return parseBuffer(content, sourceIdentifier, InputMode::STRING, builder);
+}
+
+ParseResult ExclusionParser::parseString(const std::string& content, ExclusionVisitor& visitor,
+                                        const std::string& sourceIdentifier) {
+    debugLog("Starting to visit string content");
+    
+    resetState();
+    return parseBuffer(content, sourceIdentifier, InputMode::STRING, visitor);
 }
 
 ParseResult ExclusionParser::parseStream(std::istream& stream, 
                                         const std::string& sourceIdentifier) {
     debugLog("Starting to parse stream: " + sourceIdentifier);
     
+    // Slurp the stream once so the tokenizer can work on views of a single buffer
+    std::string buffer;
+    char chunk[64 * 1024];
+    while (stream.read(chunk, sizeof(chunk)) || stream.gcount() > 0) {
+        buffer.append(chunk, static_cast<size_t>(stream.gcount()));
+    }
+    
+    ExclusionDataBuilder builder(*data_, config_.columnarToggles);
+    return parseBuffer(buffer, sourceIdentifier, InputMode::STREAM, builder);
+}
+
+ParseResult ExclusionParser::parseStream(std::istream& stream, ExclusionVisitor& visitor,
+                                        const std::string& sourceIdentifier) {
+    debugLog("Starting to visit stream: " + sourceIdentifier);
+    
     ParseResult result;
-    std::string line;
+    result.inputMode = InputMode::STREAM;
+    resetState();
+    visitor_ = &visitor;
     
+    // Only the current line is kept; the parser's own state is copied into strings
+    std::string line;
     try {
         while (std::getline(stream, line)) {
-            currentLineNumber_++;
-            result.linesProcessed++;
-            
-            // Trim the line
-            line = trim(line);
-            
-            // Skip empty lines
-            if (line.empty()) {
-                continue;
-            }
-            
-            // Skip comments (unless we want to preserve them)
-            if (isComment(line)) {
-                if (config_.preserveComments) {
-                    // Could store comments if needed
-                }
-                continue;
+            if (!parseLine(line, result)) {
+                visitor_ = nullptr;
+                lastResult_ = result;
+                return result;
             }
-            
-            // Parse the line based on its content
-            bool parsed = false;
-            
-            // Try different parsing methods
-            if (parseHeader(line)) {
-                parsed = true;
-            } else if (parseChecksum(line)) {
-                parsed = true;
-            } else if (parseScope(line)) {
-                parsed = true;
-            } else if (parseAnnotation(line)) {
-                parsed = true;
-            } else if (parseBlockExclusion(line)) {
-                parsed = true;
-                result.exclusionsParsed++;
-                result.exclusionCounts[ExclusionType::BLOCK]++;
-            } else if (parseToggleExclusion(line)) {
-                parsed = true;
-                result.exclusionsParsed++;
-                result.exclusionCounts[ExclusionType::TOGGLE]++;
-            } else if (parseFsmExclusion(line)) {
-                parsed = true;
-                result.exclusionsParsed++;
-                result.exclusionCounts[ExclusionType::FSM]++;
-            } else if (parseConditionExclusion(line)) {
-                parsed = true;
-                result.exclusionsParsed++;
-                result.exclusionCounts[ExclusionType::CONDITION]++;
-            } else if (parseTransition(line)) {
-                parsed = true;
-                result.exclusionsParsed++;
-                result.exclusionCounts[ExclusionType::FSM]++;
-            }
-            
-            if (!parsed) {
-                std::string warning = "Unrecognized line format at line " + 
-                                    std::to_string(currentLineNumber_) + ": " + line;
-                result.warnings.push_back(warning);
-                debugLog(warning);
-                
-                if (config_.strictMode) {
-                    result.errorMessage = createError("Unrecognized line format: " + line);
-                    return result;
-                }
+        }
+        result.success = true;
+    } catch (const std::exception& e) {
+        result.errorMessage = createError("Exception during parsing: " + std::string(e.what()));
+        result.success = false;
+    }
+    
+    visitor_ = nullptr;
+    lastResult_ = result;
+    return result;
+}
+
+ParseResult ExclusionParser::parseBuffer(std::string_view buffer, 
+                                        const std::string& sourceIdentifier,
+                                        InputMode inputMode, ExclusionVisitor& visitor) {
+    debugLog("Tokenizing " + std::to_string(buffer.size()) + " bytes from: " + sourceIdentifier);
+    
+    ParseResult result;
+    result.inputMode = inputMode;
+    visitor_ = &visitor;
+    Tokenizer::LineReader reader(buffer);
+    std::string_view rawLine;
+    
+    try {
+        while (reader.next(rawLine)) {
+            if (!parseLine(rawLine, result)) {
+                visitor_ = nullptr;
+                lastResult_ = result;
+                return result;
             }
         }
         
@@ -194,22 +412,283 @@ ParseResult ExclusionParser::parseStream(std::istream& stream,
         result.success = false;
     }
     
+    visitor_ = nullptr;
     lastResult_ = result;
     return result;
 }
 
+bool ExclusionParser::parseLine(std::string_view rawLine, ParseResult& result) {
+    currentLineNumber_++;
+    result.linesProcessed++;
+    
+    // Trim the line
+    std::string_view line = Tokenizer::trim(rawLine);
+    
+    // Identify the line once and hand it to exactly one handler
+    bool parsed = true;
+    ExclusionType counted = ExclusionType::BLOCK;
+    bool isExclusion = false;
+    
+    switch (Tokenizer::classifyLine(line)) {
+        case Tokenizer::LineKind::EMPTY:
+            return true;
+        case Tokenizer::LineKind::COMMENT:
+            // Header fields only ever appear in comments
+            parseHeader(line);
+            return true;
+        case Tokenizer::LineKind::CHECKSUM:
+            parsed = parseChecksum(line);
+            break;
+        case Tokenizer::LineKind::INSTANCE:
+            parsed = parseScope(line, false);
+            break;
+        case Tokenizer::LineKind::MODULE:
+            parsed = parseScope(line, true);
+            break;
+        case Tokenizer::LineKind::ANNOTATION:
+            parsed = parseAnnotation(line);
+            break;
+        case Tokenizer::LineKind::ANNOTATION_BEGIN:
+            parsed = parseAnnotation(line, true);
+            break;
+        case Tokenizer::LineKind::ANNOTATION_END:
+            // End of multi-line annotation
+            runAnnotation_.clear();
+            visitor_->onAnnotationEnd();
+            break;
+        case Tokenizer::LineKind::BLOCK:
+            parsed = isExclusion = parseBlockExclusion(line);
+            counted = ExclusionType::BLOCK;
+            break;
+        case Tokenizer::LineKind::TOGGLE:
+            parsed = isExclusion = parseToggleExclusion(line);
+            counted = ExclusionType::TOGGLE;
+            break;
+        case Tokenizer::LineKind::FSM:
+            parsed = isExclusion = parseFsmExclusion(line);
+            counted = ExclusionType::FSM;
+            break;
+        case Tokenizer::LineKind::TRANSITION:
+            parsed = isExclusion = parseTransition(line);
+            counted = ExclusionType::FSM;
+            break;
+        case Tokenizer::LineKind::CONDITION:
+            parsed = isExclusion = parseConditionExclusion(line);
+            counted = ExclusionType::CONDITION;
+            break;
+        case Tokenizer::LineKind::UNKNOWN:
+            parsed = false;
+            break;
+    }
+    
+    if (isExclusion) {
+        result.exclusionsParsed++;
+        result.exclusionCounts[counted]++;
+    }
+    
+    if (!parsed) {
+        visitor_->onUnrecognized(line, currentLineNumber_);
+        
+        std::string warning = "Unrecognized line format at line " + 
+                            std::to_string(currentLineNumber_) + ": " + std::string(line);
+        result.warnings.push_back(warning);
+        debugLog(warning);
+        
+        if (config_.strictMode) {
+            result.errorMessage = createError("Unrecognized line format: " + std::string(line));
+            return false;
+        }
+    }
+    
+    return true;
+}
+
 ParseResult ExclusionParser::parseFiles(const std::vector<std::string>& filenames, 
                                        bool continueOnError) {
     debugLog("Starting to parse " + std::to_string(filenames.size()) + " files");
     
+    std::vector<LoadedInput> inputs(filenames.size());
+    for (size_t i = 0; i < filenames.size(); ++i) {
+        inputs[i].filename = filenames[i];
+        inputs[i].opened = openInput(filenames[i], inputs[i].file, inputs[i].errorMessage);
+    }
+    
+    if (!config_.mergeOnLoad || !data_) {
+        data_ = std::make_shared<ExclusionData>();
+        dataManager_.setData(data_);
+    }
+    
+    return parseInputs(inputs, continueOnError);
+}
+
+ParseResult ExclusionParser::parseChunk(std::string_view text, size_t firstLine, 
+                                        const std::string& sourceIdentifier, InputMode inputMode) {
+    // Scope state has been seeded by the caller; annotations never carry into a chunk
+    pendingAnnotation_.clear();
+    runAnnotation_.clear();
+    data_ = std::make_shared<ExclusionData>(sourceIdentifier);
+    dataManager_.setData(data_);
+    currentLineNumber_ = firstLine - 1;
+    ExclusionDataBuilder builder(*data_, config_.columnarToggles);
+    return parseBuffer(text, sourceIdentifier, inputMode, builder);
+}
+
+ParseResult ExclusionParser::parseInputs(std::vector<LoadedInput>& inputs, bool continueOnError) {
+    // Work items: whole files, or chunks of files when splitting is enabled
+    struct Piece {
+        size_t input;
+        BufferChunk chunk;
+        ParseResult result;
+        std::shared_ptr<ExclusionData> data;
+    };
+    
+    // Files parsed before (same content and options) are replayed from the cache
+    std::unique_ptr<ParseCache> cache;
+    if (!config_.cacheDirectory.empty()) {
+        cache = std::make_unique<ParseCache>(config_.cacheDirectory, config_.cacheMaxBytes);
+        for (auto& input : inputs) {
+            if (input.opened) {
+                input.cacheKey = ParseCache::makeKey(input.file.view(), config_);
+                input.cacheHit = cache->load(input.cacheKey, input.cached, input.cachedResult);
+            }
+        }
+    }
+    
+    std::vector<Piece> pieces;
+    std::vector<size_t> firstPiece(inputs.size() + 1, 0);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        firstPiece[i] = pieces.size();
+        if (!inputs[i].opened) {
+            continue;
+        }
+        std::string_view buffer = inputs[i].file.view();
+        if (config_.splitLargeFiles && buffer.size() >= 2 * config_.splitChunkSize && !inputs[i].cacheHit) {
+            for (const auto& chunk : splitAtSafeBoundaries(buffer, config_.splitChunkSize)) {
+                pieces.push_back({i, chunk, {}, nullptr});
+            }
+        } else {
+            pieces.push_back({i, {buffer, 1, {}, {}, false}, {}, nullptr});
+        }
+    }
+    firstPiece[inputs.size()] = pieces.size();
+    
+    // Every piece is parsed by its own parser into private data
+    ParserConfig pieceConfig = config_;
+    pieceConfig.mergeOnLoad = false;
+    bool debug = debugMode_;
+    
+    auto parsePiece = [&pieceConfig, debug, &inputs](Piece& piece) {
+        const LoadedInput& input = inputs[piece.input];
+        if (input.cacheHit) {
+            piece.data = std::make_shared<ExclusionData>(input.filename);
+            ExclusionDataBuilder builder(*piece.data, pieceConfig.columnarToggles);
+            input.cached.accept(builder);
+            piece.result = input.cachedResult;
+            return;
+        }
+        ExclusionParser pieceParser;
+        pieceParser.setConfig(pieceConfig);
+        pieceParser.setDebugMode(debug);
+        pieceParser.resetState();
+        pieceParser.currentScope_ = piece.chunk.scope;
+        pieceParser.currentChecksum_ = piece.chunk.checksum;
+        pieceParser.currentIsModule_ = piece.chunk.isModule;
+        piece.result = pieceParser.parseChunk(
+            piece.chunk.text, piece.chunk.firstLine, input.filename,
+            input.file.isMapped() ? InputMode::MEMORY_MAPPED : InputMode::BUFFERED);
+        piece.data = pieceParser.getData();
+    };
+    
+    size_t threadCount = std::min(ThreadPool::resolveThreadCount(config_.threadCount), pieces.size());
+    
+    if (threadCount <= 1) {
+        for (auto& piece : pieces) {
+            parsePiece(piece);
+            if (!piece.result.success && !continueOnError) {
+                break;
+            }
+        }
+    } else {
+        // Largest pieces first so a big file never starts last and stalls the batch
+        std::vector<size_t> schedule(pieces.size());
+        for (size_t i = 0; i < schedule.size(); ++i) {
+            schedule[i] = i;
+        }
+        std::stable_sort(schedule.begin(), schedule.end(), [&pieces](size_t a, size_t b) {
+            return pieces[a].chunk.text.size() > pieces[b].chunk.text.size();
+        });
+        
+        ThreadPool pool(threadCount);
+        std::vector<std::future<void>> futures;
+        futures.reserve(pieces.size());
+        for (size_t index : schedule) {
+            Piece& piece = pieces[index];
+            futures.push_back(pool.submit([&parsePiece, &piece] { parsePiece(piece); }));
+        }
+        for (auto& future : futures) {
+            future.get();
+        }
+    }
+    
+    // Merge in input order so the result does not depend on scheduling
     ParseResult combinedResult;
+    bool cacheStored = false;
     
-    for (const auto& filename : filenames) {
-        auto result = parseFile(filename);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        const std::string& filename = inputs[i].filename;
+        ParseResult result;
+        result.errorMessage = inputs[i].errorMessage;
+        result.success = inputs[i].opened;
+        
+        // A parsed file is collected on its own first so it can be frozen into the cache
+        bool storeInCache = cache && inputs[i].opened && !inputs[i].cacheHit;
+        std::shared_ptr<ExclusionData> fileData;
+        
+        for (size_t p = firstPiece[i]; p < firstPiece[i + 1] && result.success; ++p) {
+            auto& piece = pieces[p];
+            result.success = piece.result.success;
+            result.errorMessage = piece.result.errorMessage;
+            result.inputMode = piece.result.inputMode;
+            result.linesProcessed += piece.result.linesProcessed;
+            result.exclusionsParsed += piece.result.exclusionsParsed;
+            for (const auto& [type, count] : piece.result.exclusionCounts) {
+                result.exclusionCounts[type] += count;
+            }
+            result.warnings.insert(result.warnings.end(),
+                                   std::make_move_iterator(piece.result.warnings.begin()),
+                                   std::make_move_iterator(piece.result.warnings.end()));
+            if (!piece.data) {
+                continue;
+            }
+            if (!storeInCache) {
+                data_->append(std::move(*piece.data));
+            } else if (!fileData) {
+                fileData = std::move(piece.data);
+            } else {
+                fileData->append(std::move(*piece.data));
+            }
+        }
+        
+        if (cache && inputs[i].opened) {
+            result.cacheHits = inputs[i].cacheHit ? 1 : 0;
+            result.cacheMisses = inputs[i].cacheHit ? 0 : 1;
+        }
+        if (fileData) {
+            std::string cacheError;
+            if (result.success && cache->store(inputs[i].cacheKey, fileData->freeze(), result, cacheError)) {
+                cacheStored = true;
+            } else if (!cacheError.empty()) {
+                debugLog("Parse cache not updated: " + cacheError);
+            }
+            data_->append(std::move(*fileData));
+        }
         
         // Combine results
         combinedResult.linesProcessed += result.linesProcessed;
         combinedResult.exclusionsParsed += result.exclusionsParsed;
+        combinedResult.inputMode = result.inputMode;
+        combinedResult.cacheHits += result.cacheHits;
+        combinedResult.cacheMisses += result.cacheMisses;
         
         for (const auto& [type, count] : result.exclusionCounts) {
             combinedResult.exclusionCounts[type] += count;
@@ -218,19 +697,32 @@ ParseResult ExclusionParser::parseFiles(const std::vector<std::string>& filename
         // Combine warnings
         combinedResult.warnings.insert(combinedResult.warnings.end(),
                                       result.warnings.begin(), result.warnings.end());
+        combinedResult.fileWarnings.emplace_back(filename, std::move(result.warnings));
         
         if (!result.success) {
             if (!continueOnError) {
                 combinedResult.success = false;
-                combinedResult.errorMessage = "Failed to parse " + filename + ": " + result.errorMessage;
+                combinedResult.errorMessage = inputs.size() == 1 ? result.errorMessage :
+                    "Failed to parse " + filename + ": " + result.errorMessage;
+                if (cacheStored) {
+                    cache->evict();
+                }
+                lastResult_ = combinedResult;
                 return combinedResult;
             } else {
-                combinedResult.warnings.push_back("Failed to parse " + filename + ": " + result.errorMessage);
+                std::string warning = "Failed to parse " + filename + ": " + result.errorMessage;
+                combinedResult.warnings.push_back(warning);
+                combinedResult.fileWarnings.back().second.push_back(warning);
             }
         }
     }
     
+    if (cacheStored) {
+        cache->evict();
+    }
+    
     combinedResult.success = true;
+    lastResult_ = combinedResult;
     return combinedResult;
 }
 
@@ -280,9 +772,9 @@ bool ExclusionParser::validateFile(const std::string& filename) const {
     
     // Check first few lines for header markers
     for (int i = 0; i < 20 && std::getline(file, line); ++i) {
-        line = trim(line);
-        if (line.find("This file contains the Excluded objects") != std::string::npos ||
-            line.find("Format Version:") != std::string::npos) {
+        std::string_view trimmed = Tokenizer::trim(line);
+        if (trimmed.find("This file contains the Excluded objects") != std::string_view::npos ||
+            trimmed.find("Format Version:") != std::string_view::npos) {
             foundHeader = true;
             break;
         }
@@ -304,379 +796,234 @@ bool ExclusionParser::isDebugMode() const {
 }
 
 // Private helper methods
-bool ExclusionParser::parseHeader(const std::string& line) {
-    // Parse header information like "Generated By User:", "Format Version:", etc.
-    if (line.find("Generated By User:") != std::string::npos) {
-        size_t pos = line.find(':');
-        if (pos != std::string::npos && pos + 1 < line.length()) {
-            data_->generatedBy = trim(line.substr(pos + 1));
-        }
-        return true;
-    }
+
+bool ExclusionParser::parseHeader(std::string_view line) {
+    // Parse header comments like "// Generated By User: name", "// Format Version: 2", etc.
+    std::string_view text = Tokenizer::trim(line.substr(2));
+    std::string_view value;
+    HeaderField field;
     
-    if (line.find("Format Version:") != std::string::npos) {
-        size_t pos = line.find(':');
-        if (pos != std::string::npos && pos + 1 < line.length()) {
-            data_->formatVersion = trim(line.substr(pos + 1));
-        }
-        return true;
+    if (Tokenizer::startsWith(text, "Generated By User:")) {
+        field = HeaderField::GENERATED_BY;
+    } else if (Tokenizer::startsWith(text, "Format Version:")) {
+        field = HeaderField::FORMAT_VERSION;
+    } else if (Tokenizer::startsWith(text, "Date:")) {
+        field = HeaderField::GENERATION_DATE;
+    } else if (Tokenizer::startsWith(text, "ExclMode:")) {
+        field = HeaderField::EXCLUSION_MODE;
+    } else {
+        return false;
     }
     
-    if (line.find("Date:") != std::string::npos) {
-        size_t pos = line.find(':');
-        if (pos != std::string::npos && pos + 1 < line.length()) {
-            data_->generationDate = trim(line.substr(pos + 1));
-        }
-        return true;
+    if (valueAfterColon(text, value)) {
+        visitor_->onHeader(field, value);
     }
-    
-    if (line.find("ExclMode:") != std::string::npos) {
-        size_t pos = line.find(':');
-        if (pos != std::string::npos && pos + 1 < line.length()) {
-            data_->exclusionMode = trim(line.substr(pos + 1));
+    return true;
+}
+
+bool ExclusionParser::parseChecksum(std::string_view line) {
+    std::string_view value;
+    if (valueAfterColon(line, value)) {
+        // Remove quotes if present
+        currentChecksum_ = Tokenizer::unquote(value);
+        visitor_->onChecksum(currentChecksum_);
+        
+        if (config_.validateChecksums && !validateChecksum(currentChecksum_)) {
+            addWarning("Invalid checksum format: " + currentChecksum_);
         }
-        return true;
     }
-    
-    return false;
+    return true;
 }
 
-bool ExclusionParser::parseChecksum(const std::string& line) {
-    if (line.find("CHECKSUM:") == 0) {
-        size_t pos = line.find(':');
-        if (pos != std::string::npos && pos + 1 < line.length()) {
-            currentChecksum_ = trim(line.substr(pos + 1));
-            // Remove quotes if present
-            if (currentChecksum_.front() == '"' && currentChecksum_.back() == '"') {
-                currentChecksum_ = currentChecksum_.substr(1, currentChecksum_.length() - 2);
-            }
-            
-            if (config_.validateChecksums && !validateChecksum(currentChecksum_)) {
-                addWarning("Invalid checksum format: " + currentChecksum_);
-            }
-        }
-        return true;
+bool ExclusionParser::parseScope(std::string_view line, bool isModule) {
+    std::string_view value;
+    if (valueAfterColon(line, value)) {
+        currentScope_ = value;
+        currentIsModule_ = isModule;
+        
+        // Announce the scope even if it turns out to hold no exclusions
+        visitor_->onScope(currentScopeView());
     }
-    return false;
+    return true;
 }
 
-bool ExclusionParser::parseScope(const std::string& line) {
-    if (line.find("INSTANCE:") == 0) {
-        size_t pos = line.find(':');
-        if (pos != std::string::npos && pos + 1 < line.length()) {
-            currentScope_ = trim(line.substr(pos + 1));
-            currentIsModule_ = false;
-            
-            // Create or get the scope
-            data_->getOrCreateScope(currentScope_, currentChecksum_, false);
+bool ExclusionParser::parseAnnotation(std::string_view line, bool beginsRun) {
+    std::string_view value;
+    if (valueAfterColon(line, value)) {
+        // Remove quotes if present
+        std::string& annotation = beginsRun ? runAnnotation_ : pendingAnnotation_;
+        annotation = Tokenizer::unquote(value);
+        if (beginsRun) {
+            pendingAnnotation_.clear();
         }
-        return true;
+        visitor_->onAnnotation(annotation);
     }
+    return true;
+}
+
+bool ExclusionParser::parseBlockExclusion(std::string_view line) {
+    // Parse: Block 161 "1104666086" "do_db_reg_update = 1'b0;"
+    Tokenizer::Cursor cursor(line, 6);
+    BlockView block;
+    block.blockId = cursor.word();
+    block.checksum = cursor.quoted();
+    block.sourceCode = cursor.quoted();
     
-    if (line.find("MODULE:") == 0) {
-        size_t pos = line.find(':');
-        if (pos != std::string::npos && pos + 1 < line.length()) {
-            currentScope_ = trim(line.substr(pos + 1));
-            currentIsModule_ = true;
-            
-            // Create or get the scope
-            data_->getOrCreateScope(currentScope_, currentChecksum_, true);
-        }
-        return true;
+    if (!currentScope_.empty()) {
+        block.scope = currentScopeView();
+        block.annotation = currentAnnotation();
+        visitor_->onBlock(block);
+        
+        pendingAnnotation_.clear(); // Clear after use
     }
     
-    return false;
+    return true;
 }
 
-bool ExclusionParser::parseAnnotation(const std::string& line) {
-    if (line.find("ANNOTATION:") == 0) {
-        size_t pos = line.find(':');
-        if (pos != std::string::npos && pos + 1 < line.length()) {
-            std::string annotation = trim(line.substr(pos + 1));
-            // Remove quotes if present
-            if (annotation.front() == '"' && annotation.back() == '"') {
-                annotation = annotation.substr(1, annotation.length() - 2);
-            }
-            pendingAnnotation_ = annotation;
-        }
-        return true;
+bool ExclusionParser::parseToggleExclusion(std::string_view line) {
+    // Parse different toggle formats:
+    // Toggle 1to0 next_active_duty_cycle_cnt_frac_carry "net next_active_duty_cycle_cnt_frac_carry"
+    // Toggle next_active_duty_cycle_cnt_frac [0] "net next_active_duty_cycle_cnt_frac[16:0]"
+    Tokenizer::Cursor cursor(line, 7);
+    cursor.skipSpace();
+    
+    ToggleView toggle;
+    
+    // Check if line starts with direction (0to1 or 1to0)
+    if (cursor.consume("0to1 ")) {
+        toggle.direction = ToggleDirection::ZERO_TO_ONE;
+    } else if (cursor.consume("1to0 ")) {
+        toggle.direction = ToggleDirection::ONE_TO_ZERO;
     }
     
-    if (line.find("ANNOTATION_BEGIN:") == 0) {
-        size_t pos = line.find(':');
-        if (pos != std::string::npos && pos + 1 < line.length()) {
-            std::string annotation = trim(line.substr(pos + 1));
-            // Remove quotes if present
-            if (annotation.front() == '"' && annotation.back() == '"') {
-                annotation = annotation.substr(1, annotation.length() - 2);
+    // Extract signal name (up to whitespace or '[')
+    toggle.signalName = cursor.until(" \t[");
+    
+    // Check for bit index "[N]" or "name[N]"
+    cursor.skipSpace();
+    if (cursor.peek() == '[') {
+        size_t openBracket = cursor.position();
+        std::string_view bracketed = cursor.until("]");
+        if (cursor.consume("]")) {
+            std::string_view bitStr = Tokenizer::trim(bracketed.substr(1));
+            int bit = 0;
+            auto [end, ec] = std::from_chars(bitStr.data(), bitStr.data() + bitStr.size(), bit);
+            if (ec == std::errc() && end == bitStr.data() + bitStr.size()) {
+                toggle.bitIndex = bit;
+            } else {
+                // Part-select such as [37:34]: keep it with the signal name so it round-trips
+                toggle.range = line.substr(openBracket, cursor.position() - openBracket);
             }
-            pendingAnnotation_ = annotation;
         }
-        return true;
     }
     
-    if (line.find("ANNOTATION_END") == 0) {
-        // End of multi-line annotation
-        return true;
-    }
+    // Extract quoted net description
+    toggle.netDescription = cursor.quoted();
     
-    return false;
-}
-
-bool ExclusionParser::parseBlockExclusion(const std::string& line) {
-    if (line.find("Block ") == 0) {
-        std::istringstream iss(line);
-        std::string keyword, blockId, checksum, sourceCode;
-        
-        // Parse: Block 161 "1104666086" "do_db_reg_update = 1'b0;"
-        iss >> keyword >> blockId;
-        
-        // Extract quoted checksum
-        auto [cs, pos1] = extractQuotedString(line, line.find(blockId) + blockId.length());
-        checksum = cs;
-        
-        // Extract quoted source code
-        auto [sc, pos2] = extractQuotedString(line, pos1);
-        sourceCode = sc;
-        
-        if (!currentScope_.empty()) {
-            auto& scope = data_->getOrCreateScope(currentScope_, currentChecksum_, currentIsModule_);
-            BlockExclusion block(blockId, checksum, sourceCode, pendingAnnotation_);
-            scope.addBlockExclusion(block);
-            
-            pendingAnnotation_.clear(); // Clear after use
-        }
+    if (!currentScope_.empty()) {
+        toggle.scope = currentScopeView();
+        toggle.annotation = currentAnnotation();
+        visitor_->onToggle(toggle);
         
-        return true;
+        pendingAnnotation_.clear(); // Clear after use
     }
-    return false;
+    
+    return true;
 }
 
-bool ExclusionParser::parseToggleExclusion(const std::string& line) {
-    if (line.find("Toggle ") == 0) {
-        std::istringstream iss(line);
-        std::string keyword;
-        iss >> keyword;
-        
-        // Parse different toggle formats:
-        // Toggle 1to0 next_active_duty_cycle_cnt_frac_carry "net next_active_duty_cycle_cnt_frac_carry"
-        // Toggle next_active_duty_cycle_cnt_frac [0] "net next_active_duty_cycle_cnt_frac[16:0]"
-        
-        std::string remaining = line.substr(7); // Skip "Toggle "
-        remaining = trim(remaining);
-        
-        ToggleDirection direction = ToggleDirection::BOTH;
-        std::string signalName;
-        std::optional<int> bitIndex;
-        std::string netDescription;
-        
-        // Check if line starts with direction (0to1 or 1to0)
-        if (remaining.find("0to1 ") == 0) {
-            direction = ToggleDirection::ZERO_TO_ONE;
-            remaining = remaining.substr(5);
-        } else if (remaining.find("1to0 ") == 0) {
-            direction = ToggleDirection::ONE_TO_ZERO;
-            remaining = remaining.substr(5);
-        }
-        
-        // Extract signal name (up to space or [)
-        size_t spacePos = remaining.find(' ');
-        size_t bracketPos = remaining.find('[');
-        size_t endPos = std::min(spacePos, bracketPos);
-        if (endPos == std::string::npos) endPos = remaining.length();
-        
-        signalName = remaining.substr(0, endPos);
-        
-        // Check for bit index [N]
-        if (bracketPos != std::string::npos && bracketPos < spacePos) {
-            size_t closeBracket = remaining.find(']', bracketPos);
-            if (closeBracket != std::string::npos) {
-                std::string bitStr = remaining.substr(bracketPos + 1, closeBracket - bracketPos - 1);
-                try {
-                    bitIndex = std::stoi(bitStr);
-                } catch (...) {
-                    // Invalid bit index, ignore
-                }
-                remaining = remaining.substr(closeBracket + 1);
-            }
-        } else {
-            remaining = remaining.substr(endPos);
-        }
-        
-        // Extract quoted net description
-        auto [desc, pos] = extractQuotedString(remaining, 0);
-        netDescription = desc;
-        
-        if (!currentScope_.empty()) {
-            auto& scope = data_->getOrCreateScope(currentScope_, currentChecksum_, currentIsModule_);
-            ToggleExclusion toggle(direction, signalName, bitIndex, netDescription, pendingAnnotation_);
-            scope.addToggleExclusion(toggle);
-            
-            pendingAnnotation_.clear(); // Clear after use
-        }
+bool ExclusionParser::parseFsmExclusion(std::string_view line) {
+    // Parse: Fsm state "85815111"
+    Tokenizer::Cursor cursor(line, 4);
+    FsmView fsm;
+    fsm.fsmName = cursor.word();
+    fsm.checksum = cursor.quoted();
+    
+    if (!currentScope_.empty()) {
+        fsm.scope = currentScopeView();
+        fsm.annotation = currentAnnotation();
+        visitor_->onFsm(fsm);
         
-        return true;
+        pendingAnnotation_.clear(); // Clear after use
     }
-    return false;
+    
+    return true;
 }
 
-bool ExclusionParser::parseFsmExclusion(const std::string& line) {
-    if (line.find("Fsm ") == 0) {
-        std::istringstream iss(line);
-        std::string keyword, fsmName, checksum;
-        
-        // Parse: Fsm state "85815111"
-        iss >> keyword >> fsmName;
-        
-        // Extract quoted checksum
-        auto [cs, pos] = extractQuotedString(line, line.find(fsmName) + fsmName.length());
-        checksum = cs;
-        
-        if (!currentScope_.empty()) {
-            auto& scope = data_->getOrCreateScope(currentScope_, currentChecksum_, currentIsModule_);
-            FsmExclusion fsm(fsmName, checksum, pendingAnnotation_);
-            scope.addFsmExclusion(fsm);
-            
-            pendingAnnotation_.clear(); // Clear after use
-        }
-        
-        return true;
+bool ExclusionParser::parseConditionExclusion(std::string_view line) {
+    // Parse: Condition 2 "2940925445" "(rdpcs_debug_en_RDPCS_test_debug_clock && (RDPCS_DCIO_TEST_CLK_DIV_RDPCS_test_debug_clock != 2'b0)) 1 -1" (1 "01")
+    Tokenizer::Cursor cursor(line, 10);
+    ConditionView condition;
+    condition.conditionId = cursor.word();
+    condition.checksum = cursor.quoted();
+    
+    // Extract quoted expression with parameters
+    std::string_view expr = cursor.quoted();
+    
+    // Split expression and parameters
+    condition.expression = expr;
+    size_t lastSpace = expr.rfind(' ');
+    if (lastSpace != std::string_view::npos) {
+        condition.expression = expr.substr(0, lastSpace);
+        condition.parameters = expr.substr(lastSpace + 1);
     }
-    return false;
-}
-
-bool ExclusionParser::parseConditionExclusion(const std::string& line) {
-    if (line.find("Condition ") == 0) {
-        std::istringstream iss(line);
-        std::string keyword, conditionId, checksum, expression, parameters, coverage;
-        
-        // Parse: Condition 2 "2940925445" "(rdpcs_debug_en_RDPCS_test_debug_clock && (RDPCS_DCIO_TEST_CLK_DIV_RDPCS_test_debug_clock != 2'b0)) 1 -1" (1 "01")
-        iss >> keyword >> conditionId;
-        
-        size_t pos = line.find(conditionId) + conditionId.length();
-        
-        // Extract quoted checksum
-        auto [cs, pos1] = extractQuotedString(line, pos);
-        checksum = cs;
-        
-        // Extract quoted expression with parameters
-        auto [expr, pos2] = extractQuotedString(line, pos1);
-        
-        // Split expression and parameters
-        size_t lastSpace = expr.rfind(' ');
-        if (lastSpace != std::string::npos) {
-            expression = expr.substr(0, lastSpace);
-            parameters = expr.substr(lastSpace + 1);
-        } else {
-            expression = expr;
-        }
-        
-        // Extract coverage part (1 "01")
-        std::string remaining = trim(line.substr(pos2));
-        if (remaining.front() == '(' && remaining.back() == ')') {
-            coverage = remaining.substr(1, remaining.length() - 2);
-        }
-        
-        if (!currentScope_.empty()) {
-            auto& scope = data_->getOrCreateScope(currentScope_, currentChecksum_, currentIsModule_);
-            ConditionExclusion condition(conditionId, checksum, expression, parameters, coverage, pendingAnnotation_);
-            scope.addConditionExclusion(condition);
-            
-            pendingAnnotation_.clear(); // Clear after use
-        }
-        
-        return true;
+    
+    // Extract coverage part (1 "01")
+    std::string_view remaining = Tokenizer::trim(cursor.rest());
+    if (remaining.size() >= 2 && remaining.front() == '(' && remaining.back() == ')') {
+        condition.coverage = remaining.substr(1, remaining.length() - 2);
     }
-    return false;
-}
-
-bool ExclusionParser::parseTransition(const std::string& line) {
-    if (line.find("Transition ") == 0) {
-        // Parse: Transition SND_RD_ADDR1->IDLE "11->0"
-        std::string remaining = line.substr(11); // Skip "Transition "
-        
-        size_t arrowPos = remaining.find("->");
-        if (arrowPos == std::string::npos) return false;
-        
-        std::string fromState = trim(remaining.substr(0, arrowPos));
-        
-        size_t spacePos = remaining.find(' ', arrowPos);
-        if (spacePos == std::string::npos) return false;
-        
-        std::string toState = trim(remaining.substr(arrowPos + 2, spacePos - arrowPos - 2));
-        
-        // Extract quoted transition ID
-        auto [transId, pos] = extractQuotedString(remaining, spacePos);
-        
-        if (!currentScope_.empty()) {
-            auto& scope = data_->getOrCreateScope(currentScope_, currentChecksum_, currentIsModule_);
-            FsmExclusion fsm("transition", fromState, toState, transId, pendingAnnotation_);
-            scope.addFsmExclusion(fsm);
-            
-            pendingAnnotation_.clear(); // Clear after use
-        }
+    
+    if (!currentScope_.empty()) {
+        condition.scope = currentScopeView();
+        condition.annotation = currentAnnotation();
+        visitor_->onCondition(condition);
         
-        return true;
+        pendingAnnotation_.clear(); // Clear after use
     }
-    return false;
+    
+    return true;
 }
 
-std::pair<std::string, size_t> ExclusionParser::extractQuotedString(const std::string& line, 
-                                                                    size_t startPos) const {
-    // Find the opening quote
-    size_t quoteStart = line.find('"', startPos);
-    if (quoteStart == std::string::npos) {
-        return {"", line.length()};
-    }
+bool ExclusionParser::parseTransition(std::string_view line) {
+    // Parse: Transition SND_RD_ADDR1->IDLE "11->0"
+    std::string_view remaining = line.substr(11); // Skip "Transition "
     
-    // Find the closing quote
-    size_t quoteEnd = line.find('"', quoteStart + 1);
-    if (quoteEnd == std::string::npos) {
-        return {"", line.length()};
-    }
+    size_t arrowPos = remaining.find("->");
+    if (arrowPos == std::string_view::npos) return false;
     
-    std::string result = line.substr(quoteStart + 1, quoteEnd - quoteStart - 1);
-    return {result, quoteEnd + 1};
-}
-
-std::pair<std::string, size_t> ExclusionParser::extractWord(const std::string& line, 
-                                                           size_t startPos) const {
-    // Skip whitespace
-    while (startPos < line.length() && std::isspace(line[startPos])) {
-        startPos++;
-    }
+    TransitionView transition;
+    transition.fromState = Tokenizer::trim(remaining.substr(0, arrowPos));
     
-    if (startPos >= line.length()) {
-        return {"", line.length()};
-    }
+    size_t spacePos = remaining.find(' ', arrowPos);
+    if (spacePos == std::string_view::npos) return false;
     
-    size_t endPos = startPos;
-    while (endPos < line.length() && !std::isspace(line[endPos])) {
-        endPos++;
-    }
+    transition.toState = Tokenizer::trim(remaining.substr(arrowPos + 2, spacePos - arrowPos - 2));
     
-    std::string result = line.substr(startPos, endPos - startPos);
-    return {result, endPos};
-}
-
-std::string ExclusionParser::trim(const std::string& str) const {
-    size_t start = str.find_first_not_of(" \t\r\n");
-    if (start == std::string::npos) return "";
+    // Extract quoted transition ID
+    Tokenizer::Cursor cursor(remaining, spacePos);
+    transition.transitionId = cursor.quoted();
+    
+    if (!currentScope_.empty()) {
+        transition.scope = currentScopeView();
+        transition.annotation = currentAnnotation();
+        visitor_->onTransition(transition);
+        
+        pendingAnnotation_.clear(); // Clear after use
+    }
     
-    size_t end = str.find_last_not_of(" \t\r\n");
-    return str.substr(start, end - start + 1);
+    return true;
 }
 
-bool ExclusionParser::isComment(const std::string& line) const {
-    return line.find("//") == 0 || line.find("==================================================") == 0;
+ScopeView ExclusionParser::currentScopeView() const {
+    return ScopeView{currentScope_, currentChecksum_, currentIsModule_};
 }
 
-bool ExclusionParser::validateChecksum(const std::string& checksum) const {
+bool ExclusionParser::validateChecksum(std::string_view checksum) const {
     if (checksum.empty()) return false;
     
     // Simple validation - checksum should contain only digits and spaces
     for (char c : checksum) {
-        if (!std::isdigit(c) && c != ' ') {
+        if (!std::isdigit(static_cast<unsigned char>(c)) && c != ' ') {
             return false;
         }
     }
@@ -689,6 +1036,7 @@ void ExclusionParser::resetState() {
     currentChecksum_.clear();
     currentIsModule_ = false;
     pendingAnnotation_.clear();
+    runAnnotation_.clear();
     currentLineNumber_ = 0;
 }
 
@@ -722,13 +1070,132 @@ size_t getFileSize(const std::string& filename) {
     }
 }
 
+namespace {
+
+/**
+ * @brief Read a whole file into a pre-sized string
+ * @param filename Path to file
+ * @param contents Receives the file contents
+ * @return True on success
+ */
+bool readWholeFile(const std::string& filename, std::string& contents) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) return false;
+    
+    file.seekg(0, std::ios::end);
+    std::streamoff length = file.tellg();
+    if (length < 0) return false;
+    file.seekg(0, std::ios::beg);
+    
+    contents.resize(static_cast<size_t>(length));
+    if (length > 0 && !file.read(contents.data(), length)) {
+        contents.clear();
+        return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
 std::string readFile(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) return "";
+    std::string contents;
+    readWholeFile(filename, contents);
+    return contents;
+}
+
+MappedFile::MappedFile() 
+    : data_(nullptr), size_(0), mapped_(false), open_(false) {}
+
+MappedFile::MappedFile(const std::string& filename, bool allowMapping) 
+    : MappedFile() {
+    open(filename, allowMapping);
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept 
+    : MappedFile() {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        buffer_ = std::move(other.buffer_);
+        data_ = other.mapped_ ? other.data_ : buffer_.data();
+        size_ = other.size_;
+        mapped_ = other.mapped_;
+        open_ = other.open_;
+        
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.mapped_ = false;
+        other.open_ = false;
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string& filename, bool allowMapping) {
+    close();
     
-    std::ostringstream oss;
-    oss << file.rdbuf();
-    return oss.str();
+#ifndef _WIN32
+    if (allowMapping) {
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            struct stat info;
+            if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+                size_t length = static_cast<size_t>(info.st_size);
+                if (length == 0) {
+                    // mmap rejects empty ranges; an empty file is trivially "mapped"
+                    ::close(fd);
+                    mapped_ = true;
+                    open_ = true;
+                    return true;
+                }
+                
+                void* address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (address != MAP_FAILED) {
+                    ::madvise(address, length, MADV_SEQUENTIAL);
+                    ::close(fd);
+                    data_ = static_cast<const char*>(address);
+                    size_ = length;
+                    mapped_ = true;
+                    open_ = true;
+                    return true;
+                }
+            }
+            ::close(fd);
+        }
+    }
+#else
+    (void)allowMapping;
+#endif
+    
+    // Buffered fallback
+    if (!readWholeFile(filename, buffer_)) {
+        buffer_.clear();
+        return false;
+    }
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+    open_ = true;
+    return true;
+}
+
+void MappedFile::close() {
+#ifndef _WIN32
+    if (mapped_ && data_ != nullptr) {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+    buffer_.clear();
+    buffer_.shrink_to_fit();
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+    open_ = false;
 }
 
 std::string getFileExtension(const std::string& filename) {
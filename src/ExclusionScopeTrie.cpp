@@ -0,0 +1,265 @@
+/**
+ * @file ExclusionScopeTrie.cpp
+ * @brief Implementation of the path-segment trie over scope names
+ *
+ * @author AMD Advanced Micro Devices Inc. - Verification Infrastructure Team
+ * @version 2.0.0
+ * @date September 13, 2025
+ * @copyright (c) 2025 Advanced Micro Devices Inc. All rights reserved.
+ */
+
+#include "ExclusionScopeTrie.h"
+
+namespace ExclusionParser {
+
+namespace {
+
+/**
+ * @brief Split a dotted path into its segments (views into path)
+ */
+std::vector<std::string_view> splitPath(std::string_view path) {
+    std::vector<std::string_view> segments;
+    size_t start = 0;
+    while (true) {
+        size_t dot = path.find('.', start);
+        if (dot == std::string_view::npos) {
+            segments.push_back(path.substr(start));
+            return segments;
+        }
+        segments.push_back(path.substr(start, dot - start));
+        start = dot + 1;
+    }
+}
+
+/**
+ * @brief Match one segment against a glob with '*' and '?'
+ */
+bool matchSegment(std::string_view pattern, std::string_view segment) {
+    size_t p = 0;
+    size_t s = 0;
+    size_t starPattern = std::string_view::npos;
+    size_t starSegment = 0;
+
+    while (s < segment.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == segment[s])) {
+            ++p;
+            ++s;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            // Remember the star and first try letting it match nothing
+            starPattern = p++;
+            starSegment = s;
+        } else if (starPattern != std::string_view::npos) {
+            // Let the last star absorb one more character
+            p = starPattern + 1;
+            s = ++starSegment;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') {
+        ++p;
+    }
+    return p == pattern.size();
+}
+
+bool hasWildcard(std::string_view segment) {
+    return segment.find_first_of("*?") != std::string_view::npos;
+}
+
+} // namespace
+
+ScopeTrie::ScopeTrie() : nodes_(1) {
+}
+
+bool ScopeTrie::insert(const std::string& scopeName) {
+    uint32_t node = 0;
+    for (std::string_view segment : splitPath(scopeName)) {
+        node = addChild(node, segment);
+    }
+
+    Node& target = nodes_[node];
+    if (target.scopeName) {
+        return false;
+    }
+    target.scopeName = &scopeName;
+    ++size_;
+    return true;
+}
+
+bool ScopeTrie::erase(std::string_view scopeName) {
+    std::vector<std::string_view> segments = splitPath(scopeName);
+    std::vector<uint32_t> path{0};
+    for (std::string_view segment : segments) {
+        const ChildMap& children = nodes_[path.back()].children;
+        auto it = children.find(segment);
+        if (it == children.end()) {
+            return false;
+        }
+        path.push_back(it->second);
+    }
+
+    Node& target = nodes_[path.back()];
+    if (!target.scopeName) {
+        return false;
+    }
+    target.scopeName = nullptr;
+    --size_;
+
+    // Unlink the nodes that now lead nowhere, deepest first
+    for (size_t i = path.size() - 1; i > 0; --i) {
+        Node& node = nodes_[path[i]];
+        if (node.scopeName || !node.children.empty()) {
+            break;
+        }
+        ChildMap& siblings = nodes_[path[i - 1]].children;
+        siblings.erase(siblings.find(segments[i - 1]));
+        freeNodes_.push_back(path[i]);
+    }
+    return true;
+}
+
+bool ScopeTrie::contains(std::string_view scopeName) const {
+    int64_t node = findNode(scopeName);
+    return node >= 0 && nodes_[static_cast<size_t>(node)].scopeName;
+}
+
+void ScopeTrie::clear() {
+    nodes_.assign(1, Node());
+    freeNodes_.clear();
+    size_ = 0;
+}
+
+std::vector<std::string> ScopeTrie::findUnder(std::string_view path) const {
+    std::vector<std::string> results;
+    forEachUnder(path, [&results](const std::string& scopeName) {
+        results.push_back(scopeName);
+    });
+    return results;
+}
+
+void ScopeTrie::forEachUnder(std::string_view path,
+                             const std::function<void(const std::string&)>& func) const {
+    int64_t node = path.empty() ? 0 : findNode(path);
+    if (node >= 0) {
+        collect(static_cast<uint32_t>(node), func);
+    }
+}
+
+void ScopeTrie::forEachWithPrefix(std::string_view prefix,
+                                 const std::function<void(const std::string&)>& func) const {
+    if (prefix.empty()) {
+        collect(0, func);
+        return;
+    }
+
+    // Whole segments select one node; the partial last segment filters its children
+    size_t lastDot = prefix.rfind('.');
+    int64_t node = 0;
+    std::string_view partial = prefix;
+    if (lastDot != std::string_view::npos) {
+        node = findNode(prefix.substr(0, lastDot));
+        partial = prefix.substr(lastDot + 1);
+    }
+    if (node < 0) {
+        return;
+    }
+    for (const auto& [segment, child] : nodes_[static_cast<size_t>(node)].children) {
+        if (segment.starts_with(partial)) {
+            collect(child, func);
+        }
+    }
+}
+
+std::vector<std::string> ScopeTrie::findMatching(std::string_view pattern) const {
+    std::vector<std::string> results;
+    std::vector<std::string_view> segments = splitPath(pattern);
+
+    // "**" can reach a node along several routes; only then track visited states
+    bool anyDepth = false;
+    for (std::string_view segment : segments) {
+        anyDepth = anyDepth || segment == "**";
+    }
+    std::unordered_set<uint64_t> visited;
+    match(0, segments, 0, results, anyDepth ? &visited : nullptr);
+    return results;
+}
+
+int64_t ScopeTrie::findNode(std::string_view path) const {
+    uint32_t node = 0;
+    for (std::string_view segment : splitPath(path)) {
+        const ChildMap& children = nodes_[node].children;
+        auto it = children.find(segment);
+        if (it == children.end()) {
+            return -1;
+        }
+        node = it->second;
+    }
+    return node;
+}
+
+uint32_t ScopeTrie::addChild(uint32_t parent, std::string_view segment) {
+    auto it = nodes_[parent].children.find(segment);
+    if (it != nodes_[parent].children.end()) {
+        return it->second;
+    }
+
+    uint32_t child;
+    if (!freeNodes_.empty()) {
+        child = freeNodes_.back();
+        freeNodes_.pop_back();
+        nodes_[child] = Node();
+    } else {
+        child = static_cast<uint32_t>(nodes_.size());
+        nodes_.emplace_back();
+    }
+    // nodes_ may have reallocated; look the parent up again
+    nodes_[parent].children.emplace(std::string(segment), child);
+    return child;
+}
+
+void ScopeTrie::collect(uint32_t node, const std::function<void(const std::string&)>& func) const {
+    const Node& current = nodes_[node];
+    if (current.scopeName) {
+        func(*current.scopeName);
+    }
+    for (const auto& [segment, child] : current.children) {
+        collect(child, func);
+    }
+}
+
+void ScopeTrie::match(uint32_t node, const std::vector<std::string_view>& segments, size_t segment,
+                      std::vector<std::string>& results, std::unordered_set<uint64_t>* visited) const {
+    if (visited && !visited->insert((static_cast<uint64_t>(node) << 32) | segment).second) {
+        return;
+    }
+
+    const Node& current = nodes_[node];
+    if (segment == segments.size()) {
+        if (current.scopeName) {
+            results.push_back(*current.scopeName);
+        }
+        return;
+    }
+
+    std::string_view glob = segments[segment];
+    if (glob == "**") {
+        // Match nothing here, or consume one more segment and stay on "**"
+        match(node, segments, segment + 1, results, visited);
+        for (const auto& [name, child] : current.children) {
+            match(child, segments, segment, results, visited);
+        }
+    } else if (!hasWildcard(glob)) {
+        auto it = current.children.find(glob);
+        if (it != current.children.end()) {
+            match(it->second, segments, segment + 1, results, visited);
+        }
+    } else {
+        for (const auto& [name, child] : current.children) {
+            if (matchSegment(glob, name)) {
+                match(child, segments, segment + 1, results, visited);
+            }
+        }
+    }
+}
+
+} // namespace ExclusionParser
@@ -0,0 +1,216 @@
+/**
+ * @file ExclusionStreamWriter.cpp
+ * @brief Implementation of the incremental .el writer
+ *
+ * @author AMD Advanced Micro Devices Inc. - Verification Infrastructure Team
+ * @version 2.0.0
+ * @date September 13, 2025
+ * @copyright (c) 2025 Advanced Micro Devices Inc. All rights reserved.
+ */
+
+#include "ExclusionStreamWriter.h"
+
+namespace ExclusionParser {
+
+ExclusionStreamWriter::ExclusionStreamWriter(const WriterConfig& config)
+    : sink_(nullptr), inScope_(false), skippedRecords_(0) {
+    writer_.setConfig(config);
+}
+
+ExclusionStreamWriter::~ExclusionStreamWriter() {
+    if (isOpen()) {
+        close();
+    }
+}
+
+bool ExclusionStreamWriter::open(const std::string& filename) {
+    if (isOpen()) {
+        close();
+    }
+
+    file_.open(filename);
+    if (!file_.is_open()) {
+        file_.clear();
+        return false;
+    }
+
+    return start(file_);
+}
+
+bool ExclusionStreamWriter::open(std::ostream& stream) {
+    if (isOpen()) {
+        close();
+    }
+
+    return start(stream);
+}
+
+bool ExclusionStreamWriter::start(std::ostream& stream) {
+    if (!stream) {
+        return false;
+    }
+
+    sink_ = &stream;
+    buffer_ = std::make_unique<OutputBuffer>(sink_);
+    result_ = WriteResult();
+    inScope_ = false;
+    skippedRecords_ = 0;
+    heldLine_.clear();
+    heldAnnotation_.clear();
+    runAnnotation_.clear();
+    return true;
+}
+
+void ExclusionStreamWriter::writeHeader(const std::string& generatedBy, const std::string& generationDate,
+                                        const std::string& exclusionMode) {
+    if (!isOpen() || !writer_.getConfig().includeComments) {
+        return;
+    }
+
+    ExclusionData header;
+    header.generatedBy = generatedBy;
+    header.generationDate = generationDate;
+    header.exclusionMode = exclusionMode;
+    result_.linesWritten += writer_.writeHeader(*buffer_, header);
+}
+
+void ExclusionStreamWriter::beginScope(const std::string& name, const std::string& checksum, bool isModule) {
+    if (!isOpen()) {
+        return;
+    }
+
+    // Annotation runs never span scopes
+    flushAnnotation();
+
+    if (!checksum.empty()) {
+        result_.linesWritten += writer_.writeChecksum(*buffer_, checksum);
+    }
+
+    writer_.beginLine(*buffer_);
+    buffer_->append(isModule ? "MODULE:" : "INSTANCE:");
+    buffer_->append(name);
+    result_.linesWritten += writer_.endLine(*buffer_);
+
+    result_.scopesWritten++;
+    inScope_ = true;
+}
+
+void ExclusionStreamWriter::add(const BlockExclusion& block) {
+    addRecord(ExclusionType::BLOCK, block.annotation, [&](OutputBuffer& buffer) {
+        return writer_.writeBlockLine(buffer, block.blockId, block);
+    });
+}
+
+void ExclusionStreamWriter::add(const ToggleExclusion& toggle) {
+    addRecord(ExclusionType::TOGGLE, toggle.annotation, [&](OutputBuffer& buffer) {
+        return writer_.writeToggleLine(buffer, toggle.direction, toggle.signalName, toggle.bitIndex,
+                                       toggle.netDescription);
+    });
+}
+
+void ExclusionStreamWriter::add(const FsmExclusion& fsm) {
+    addRecord(ExclusionType::FSM, fsm.annotation, [&](OutputBuffer& buffer) {
+        return writer_.writeFsmLine(buffer, fsm);
+    });
+}
+
+void ExclusionStreamWriter::add(const ConditionExclusion& condition) {
+    addRecord(ExclusionType::CONDITION, condition.annotation, [&](OutputBuffer& buffer) {
+        return writer_.writeConditionLine(buffer, condition.conditionId, condition);
+    });
+}
+
+template <typename FormatLine>
+void ExclusionStreamWriter::addRecord(ExclusionType type, std::string_view annotation, FormatLine&& formatLine) {
+    if (!isOpen()) {
+        return;
+    }
+    if (!inScope_) {
+        skippedRecords_++;
+        return;
+    }
+
+    result_.exclusionsWritten++;
+    result_.exclusionCounts[type]++;
+
+    if (!writer_.getConfig().includeAnnotations || annotation.empty()) {
+        flushAnnotation();
+        result_.linesWritten += formatLine(*buffer_);
+        return;
+    }
+
+    if (!runAnnotation_.empty() && annotation == runAnnotation_) {
+        // Continues the open run
+        result_.linesWritten += formatLine(*buffer_);
+        return;
+    }
+
+    if (!heldAnnotation_.empty() && annotation == heldAnnotation_) {
+        // Second record with this annotation: open a run with the held one
+        result_.linesWritten += writer_.writeAnnotation(*buffer_, heldAnnotation_, "ANNOTATION_BEGIN");
+        buffer_->append(heldLine_.view());
+        heldLine_.clear();
+        runAnnotation_.swap(heldAnnotation_);
+        heldAnnotation_.clear();
+        result_.linesWritten += formatLine(*buffer_);
+        return;
+    }
+
+    // New annotation: hold the record until the next one shows whether it starts a run
+    flushAnnotation();
+    result_.linesWritten += formatLine(heldLine_);
+    heldAnnotation_.assign(annotation);
+}
+
+void ExclusionStreamWriter::flushAnnotation() {
+    if (!runAnnotation_.empty()) {
+        writer_.beginLine(*buffer_);
+        buffer_->append("ANNOTATION_END");
+        result_.linesWritten += writer_.endLine(*buffer_);
+        runAnnotation_.clear();
+    }
+
+    if (!heldAnnotation_.empty()) {
+        // Lines of the held record were counted when it was formatted
+        result_.linesWritten += writer_.writeAnnotation(*buffer_, heldAnnotation_);
+        buffer_->append(heldLine_.view());
+        buffer_->flushIfFull();
+        heldLine_.clear();
+        heldAnnotation_.clear();
+    }
+}
+
+WriteResult ExclusionStreamWriter::close() {
+    if (!isOpen()) {
+        WriteResult result;
+        result.errorMessage = "Stream writer is not open";
+        return result;
+    }
+
+    flushAnnotation();
+
+    bool written = buffer_->flush();
+    sink_->flush();
+    written = written && static_cast<bool>(*sink_);
+    if (sink_ == &file_) {
+        file_.close();
+        written = written && !file_.fail();
+        file_.clear();
+    }
+
+    if (skippedRecords_ > 0) {
+        result_.warnings.push_back(std::to_string(skippedRecords_) +
+                                   " exclusions added outside of a scope were skipped");
+    }
+
+    result_.success = written;
+    if (!written) {
+        result_.errorMessage = "Failed to write to output stream";
+    }
+
+    buffer_.reset();
+    sink_ = nullptr;
+    return std::move(result_);
+}
+
+} // namespace ExclusionParser
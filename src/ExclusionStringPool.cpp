@@ -0,0 +1,152 @@
+/**
+ * @file ExclusionStringPool.cpp
+ * @brief Implementation of shared strings and the string interning pool
+ *
+ * @author AMD Advanced Micro Devices Inc. - Verification Infrastructure Team
+ * @version 2.0.0
+ * @date September 13, 2025
+ * @copyright (c) 2025 Advanced Micro Devices Inc. All rights reserved.
+ */
+
+#include "ExclusionStringPool.h"
+#include <cstring>
+#include <new>
+
+namespace ExclusionParser {
+
+// InternedString implementation
+InternedString::Rep* InternedString::allocate(std::string_view text) {
+    // Header and text share one allocation
+    void* memory = ::operator new(sizeof(Rep) + text.size() + 1);
+    Rep* rep = new (memory) Rep{{1}, text.size()};
+    char* storage = reinterpret_cast<char*>(rep + 1);
+    std::memcpy(storage, text.data(), text.size());
+    storage[text.size()] = '\0';
+    return rep;
+}
+
+void InternedString::deallocate(Rep* rep) {
+    rep->~Rep();
+    ::operator delete(rep);
+}
+
+// StringPool implementation
+StringPool::StringPool(const StringPool& other) : slots_(other.slots_), count_(other.count_) {
+    for (const Slot& slot : slots_) {
+        InternedString::retain(slot.rep);
+    }
+}
+
+StringPool::StringPool(StringPool&& other) noexcept 
+    : slots_(std::move(other.slots_)), count_(other.count_) {
+    other.slots_.clear();
+    other.count_ = 0;
+}
+
+StringPool& StringPool::operator=(const StringPool& other) {
+    if (this != &other) {
+        StringPool copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+StringPool& StringPool::operator=(StringPool&& other) noexcept {
+    if (this != &other) {
+        clear();
+        slots_ = std::move(other.slots_);
+        count_ = other.count_;
+        other.slots_.clear();
+        other.count_ = 0;
+    }
+    return *this;
+}
+
+StringPool::~StringPool() {
+    clear();
+}
+
+StringPool::Slot& StringPool::findSlot(std::string_view text, size_t hash) {
+    size_t mask = slots_.size() - 1;
+    for (size_t index = hash & mask;; index = (index + 1) & mask) {
+        Slot& slot = slots_[index];
+        if (!slot.rep || (slot.hash == hash && slot.rep->view() == text)) {
+            return slot;
+        }
+    }
+}
+
+void StringPool::reserveOne() {
+    if (2 * (count_ + 1) <= slots_.size()) {
+        return;
+    }
+    
+    std::vector<Slot> previous(slots_.empty() ? 64 : 2 * slots_.size(), Slot{0, nullptr});
+    previous.swap(slots_);
+    size_t mask = slots_.size() - 1;
+    for (const Slot& slot : previous) {
+        if (slot.rep) {
+            size_t index = slot.hash & mask;
+            while (slots_[index].rep) {
+                index = (index + 1) & mask;
+            }
+            slots_[index] = slot;
+        }
+    }
+}
+
+InternedString StringPool::intern(std::string_view text) {
+    if (text.empty()) {
+        return InternedString();
+    }
+    
+    reserveOne();
+    size_t hash = hashText(text);
+    Slot& slot = findSlot(text, hash);
+    if (!slot.rep) {
+        // The pool keeps the allocation's initial reference
+        slot = Slot{hash, InternedString::allocate(text)};
+        count_++;
+    }
+    return InternedString(slot.rep);
+}
+
+void StringPool::absorb(const StringPool& other, Remap& remap) {
+    if (this == &other) {
+        return;
+    }
+    
+    for (const Slot& source : other.slots_) {
+        if (!source.rep) {
+            continue;
+        }
+        reserveOne();
+        Slot& slot = findSlot(source.rep->view(), source.hash);
+        if (!slot.rep) {
+            slot = Slot{source.hash, InternedString::retain(source.rep)};
+            count_++;
+        } else if (slot.rep != source.rep) {
+            remap.emplace(source.rep, slot.rep);
+        }
+    }
+}
+
+size_t StringPool::getTextBytes() const {
+    size_t bytes = 0;
+    for (const Slot& slot : slots_) {
+        if (slot.rep) {
+            bytes += slot.rep->size;
+        }
+    }
+    return bytes;
+}
+
+void StringPool::clear() {
+    for (const Slot& slot : slots_) {
+        InternedString::release(slot.rep);
+    }
+    slots_.clear();
+    count_ = 0;
+}
+
+} // namespace ExclusionParser
@@ -0,0 +1,54 @@
+/**
+ * @file ExclusionThreadPool.cpp
+ * @brief Implementation of the bounded worker thread pool
+ * 
+ * @author AMD Advanced Micro Devices Inc. - Verification Infrastructure Team
+ * @version 2.0.0
+ * @date September 13, 2025
+ * @copyright (c) 2025 Advanced Micro Devices Inc. All rights reserved.
+ */
+
+#include "ExclusionThreadPool.h"
+
+namespace ExclusionParser {
+
+ThreadPool::ThreadPool(size_t threadCount) : available_(0) {
+    size_t count = resolveThreadCount(threadCount);
+    workers_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        workers_.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    // One extra permit per worker: each exits once it finds the queue empty
+    available_.release(static_cast<std::ptrdiff_t>(workers_.size()));
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+size_t ThreadPool::resolveThreadCount(size_t requested) {
+    if (requested == 0) {
+        requested = std::thread::hardware_concurrency();
+    }
+    return requested == 0 ? 1 : requested;
+}
+
+void ThreadPool::workerLoop() {
+    for (;;) {
+        available_.acquire();
+        std::function<void()> task;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (tasks_.empty()) {
+                return; // Shutdown permit and nothing left to run
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+} // namespace ExclusionParser
@@ -0,0 +1,131 @@
+/**
+ * @file ExclusionVisitor.cpp
+ * @brief Implementation of the ExclusionData-building visitor
+ *
+ * @author AMD Advanced Micro Devices Inc. - Verification Infrastructure Team
+ * @version 2.0.0
+ * @date September 13, 2025
+ * @copyright (c) 2025 Advanced Micro Devices Inc. All rights reserved.
+ */
+
+#include "ExclusionVisitor.h"
+
+namespace ExclusionParser {
+
+ExclusionDataBuilder::ExclusionDataBuilder(ExclusionData& data, bool columnarToggles) 
+    : data_(data), columnarToggles_(columnarToggles), cachedScope_(nullptr), lastToggleScope_(nullptr), lastToggles_(nullptr) {}
+
+ExclusionScope& ExclusionDataBuilder::resolveScope(const ScopeView& scope) {
+    // Every record goes through here, so the data's generation follows each one
+    data_.markModified();
+    
+    if (cachedScope_ && scope.name == scopeKey_) {
+        return *cachedScope_;
+    }
+    
+    scopeKey_.assign(scope.name);
+    checksumKey_.assign(scope.checksum);
+    cachedScope_ = &data_.getOrCreateScope(scopeKey_, checksumKey_, scope.isModule);
+    return *cachedScope_;
+}
+
+const InternedString& ExclusionDataBuilder::intern(InternedString& last, std::string_view text) {
+    // Consecutive records usually repeat the previous text; skip the pool lookup then
+    if (last.view() != text) {
+        last = data_.stringPool.intern(text);
+    }
+    return last;
+}
+
+void ExclusionDataBuilder::onHeader(HeaderField field, std::string_view value) {
+    switch (field) {
+        case HeaderField::GENERATED_BY:
+            data_.generatedBy = value;
+            break;
+        case HeaderField::FORMAT_VERSION:
+            data_.formatVersion = value;
+            break;
+        case HeaderField::GENERATION_DATE:
+            data_.generationDate = value;
+            break;
+        case HeaderField::EXCLUSION_MODE:
+            data_.exclusionMode = value;
+            break;
+    }
+}
+
+void ExclusionDataBuilder::onScope(const ScopeView& scope) {
+    resolveScope(scope);
+}
+
+void ExclusionDataBuilder::onBlock(const BlockView& view) {
+    BlockExclusion block;
+    block.blockId = view.blockId;
+    block.checksum = view.checksum;
+    block.sourceCode = view.sourceCode;
+    block.annotation = intern(lastAnnotation_, view.annotation);
+    resolveScope(view.scope).addBlockExclusion(std::move(block));
+}
+
+void ExclusionDataBuilder::onToggle(const ToggleView& view) {
+    ExclusionScope& scope = resolveScope(view.scope);
+    
+    std::string_view signalName = view.signalName;
+    if (!view.range.empty()) {
+        // Part-selects stay with the signal name so they are written back unchanged
+        signalKey_.assign(view.signalName);
+        signalKey_ += ' ';
+        signalKey_ += view.range;
+        signalName = signalKey_;
+    }
+    
+    if (columnarToggles_) {
+        scope.toggleTable.add(view.direction, intern(lastSignal_, signalName), view.bitIndex,
+                              intern(lastNetDescription_, view.netDescription),
+                              intern(lastAnnotation_, view.annotation));
+        return;
+    }
+    
+    // Bits of one bus arrive back to back: reuse the signal's list while the name repeats
+    if (lastToggles_ == nullptr || lastToggleScope_ != &scope || lastSignal_.view() != signalName) {
+        lastSignal_ = data_.stringPool.intern(signalName);
+        lastToggles_ = &scope.toggleExclusions[lastSignal_];
+        lastToggleScope_ = &scope;
+    }
+    
+    ToggleExclusion toggle;
+    toggle.direction = view.direction;
+    toggle.signalName = lastSignal_;
+    toggle.bitIndex = view.bitIndex;
+    toggle.netDescription = intern(lastNetDescription_, view.netDescription);
+    toggle.annotation = intern(lastAnnotation_, view.annotation);
+    lastToggles_->push_back(std::move(toggle));
+}
+
+void ExclusionDataBuilder::onFsm(const FsmView& view) {
+    FsmExclusion fsm;
+    fsm.fsmName = view.fsmName;
+    fsm.checksum = view.checksum;
+    fsm.annotation = intern(lastAnnotation_, view.annotation);
+    resolveScope(view.scope).addFsmExclusion(std::move(fsm));
+}
+
+void ExclusionDataBuilder::onTransition(const TransitionView& view) {
+    FsmExclusion fsm("transition", std::string(view.fromState), std::string(view.toState),
+                     std::string(view.transitionId));
+    fsm.annotation = intern(lastAnnotation_, view.annotation);
+    resolveScope(view.scope).addFsmExclusion(std::move(fsm));
+}
+
+void ExclusionDataBuilder::onCondition(const ConditionView& view) {
+    ConditionExclusion condition;
+    condition.conditionId = view.conditionId;
+    condition.checksum = view.checksum;
+    condition.expression = view.expression;
+    condition.parameters = view.parameters;
+    condition.coverage = view.coverage;
+    condition.annotation = intern(lastAnnotation_, view.annotation);
+    resolveScope(view.scope).addConditionExclusion(std::move(condition));
+}
+
+} // namespace ExclusionParser
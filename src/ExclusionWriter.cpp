@@ -21,14 +21,372 @@
  */
 
 #include "ExclusionWriter.h"
+#include "ExclusionFrozenData.h"
+#include "ExclusionThreadPool.h"
+#include <deque>
+#include <filesystem>
+#include <future>
+#include <random>
 #include <iostream>
 #include <algorithm>
+#include <charconv>
+#include <cstdint>
 #include <iomanip>
 #include <chrono>
+#include <ctime>
 #include <sstream>
+#include <stdexcept>
+#include <unordered_set>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace ExclusionParser {
 
+namespace {
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+/**
+ * @brief Compare two names in natural order
+ *
+ * Runs of digits compare by numeric value ("2" < "161", "sig_9" < "sig_10"),
+ * equal values with fewer leading zeros first; all other bytes compare as
+ * unsigned chars, and a name sorts before any longer name it starts.
+ *
+ * @return Negative, zero or positive like std::string_view::compare
+ */
+int naturalCompare(std::string_view a, std::string_view b) {
+    // Skip the common prefix, backing up to the start of a digit run it ends in
+    size_t common = static_cast<size_t>(
+        std::mismatch(a.begin(), a.begin() + std::min(a.size(), b.size()), b.begin()).first - a.begin());
+    while (common > 0 && isDigit(a[common - 1])) --common;
+    
+    size_t i = common;
+    size_t j = common;
+    while (i < a.size() && j < b.size()) {
+        if (isDigit(a[i]) && isDigit(b[j])) {
+            size_t zerosA = i;
+            size_t zerosB = j;
+            while (i < a.size() && a[i] == '0') ++i;
+            while (j < b.size() && b[j] == '0') ++j;
+            size_t endA = i;
+            size_t endB = j;
+            while (endA < a.size() && isDigit(a[endA])) ++endA;
+            while (endB < b.size() && isDigit(b[endB])) ++endB;
+            
+            // Without leading zeros, the longer run is the larger number
+            if (endA - i != endB - j) {
+                return endA - i < endB - j ? -1 : 1;
+            }
+            int digits = a.substr(i, endA - i).compare(b.substr(j, endB - j));
+            if (digits != 0) {
+                return digits;
+            }
+            if (i - zerosA != j - zerosB) {
+                return i - zerosA < j - zerosB ? -1 : 1;
+            }
+            i = endA;
+            j = endB;
+            continue;
+        }
+        if (a[i] != b[j]) {
+            return static_cast<unsigned char>(a[i]) < static_cast<unsigned char>(b[j]) ? -1 : 1;
+        }
+        ++i;
+        ++j;
+    }
+    if (i == a.size()) {
+        return j == b.size() ? 0 : -1;
+    }
+    return 1;
+}
+
+/**
+ * @brief Compact natural-order sort key of a name
+ *
+ * Orders names the way naturalCompare() does as far as two integers can:
+ * prefix holds the leading non-digit bytes (big-endian, zero padded), then
+ * a '0' byte where the first digit run starts, and number holds that run's
+ * value. A digit run compares against any other byte like its first digit
+ * would, and the padding like the end of the name, so keys that differ are
+ * already in order; names whose keys tie are keyed again further along.
+ */
+struct NaturalKey {
+    uint64_t prefix;
+    uint64_t number;
+    std::string_view name;  ///< Full name
+    size_t index;           ///< Position of the name in the sorted sequence
+    
+    NaturalKey(std::string_view fullName, size_t position) : prefix(0), number(0), name(fullName), index(position) {}
+    
+    /**
+     * @brief Compute the key of the name from an offset on
+     * @param offset Length of a prefix shared by all names being sorted
+     */
+    void assign(size_t offset) {
+        std::string_view rest = name.substr(offset);
+        prefix = 0;
+        number = 0;
+        size_t length = 0;
+        size_t i = 0;
+        for (; length < sizeof(prefix) && i < rest.size() && !isDigit(rest[i]); ++i, ++length) {
+            prefix = (prefix << 8) | static_cast<unsigned char>(rest[i]);
+        }
+        if (length < sizeof(prefix) && i < rest.size()) {
+            prefix = (prefix << 8) | '0';
+            ++length;
+            while (i < rest.size() && rest[i] == '0') ++i;
+            
+            // Runs too long for 19 digits saturate and are told apart by naturalCompare()
+            size_t digits = 0;
+            for (; i < rest.size() && isDigit(rest[i]); ++i, ++digits) {
+                if (digits < 19) {
+                    number = number * 10 + static_cast<uint64_t>(rest[i] - '0');
+                }
+            }
+            if (digits > 19) {
+                number = UINT64_MAX;
+            }
+        }
+        for (; length < sizeof(prefix); ++length) {
+            prefix <<= 8;
+        }
+    }
+    
+    bool sameKey(const NaturalKey& other) const { return prefix == other.prefix && number == other.number; }
+    
+    bool lessKey(const NaturalKey& other) const {
+        return prefix != other.prefix ? prefix < other.prefix : number < other.number;
+    }
+};
+
+using NaturalKeyIterator = std::vector<NaturalKey>::iterator;
+
+/**
+ * @brief Sort keys by the natural order of their names
+ *
+ * Keys are (re)computed from where the names in the range stop sharing a
+ * prefix, sorted, and each run of tied keys is sorted again the same way
+ * further along its names. Tied runs that share nothing more (only leading
+ * zeros tell them apart) or are tiny compare full names instead.
+ *
+ * @param begin First key
+ * @param end Past the last key
+ * @param minimumCommon Shared prefix length needed to key again (shorter shares
+ *        show that keying made no progress)
+ */
+void sortKeys(NaturalKeyIterator begin, NaturalKeyIterator end, size_t minimumCommon) {
+    auto lessName = [](const NaturalKey& a, const NaturalKey& b) { return naturalCompare(a.name, b.name) < 0; };
+    if (end - begin <= 8) {
+        std::sort(begin, end, lessName);
+        return;
+    }
+    
+    // Keys start after the prefix the names share (hierarchy paths, signal
+    // name stems), so their bytes go to where the names actually differ
+    std::string_view first = begin->name;
+    size_t common = first.size();
+    for (auto key = begin + 1; key != end; ++key) {
+        size_t limit = std::min(common, key->name.size());
+        common = static_cast<size_t>(std::mismatch(first.begin(), first.begin() + limit, key->name.begin()).first -
+                                     first.begin());
+    }
+    bool splitsDigitRun = common > 0 && isDigit(first[common - 1]) &&
+                          std::any_of(begin, end, [common](const NaturalKey& key) {
+                              return key.name.size() > common && isDigit(key.name[common]);
+                          });
+    if (splitsDigitRun) {
+        while (common > 0 && isDigit(first[common - 1])) --common;
+    }
+    if (common < minimumCommon) {
+        std::sort(begin, end, lessName);
+        return;
+    }
+    
+    for (auto key = begin; key != end; ++key) {
+        key->assign(common);
+    }
+    std::sort(begin, end, [](const NaturalKey& a, const NaturalKey& b) { return a.lessKey(b); });
+    
+    for (auto run = begin; run != end;) {
+        auto runEnd = std::find_if(run + 1, end, [&](const NaturalKey& key) { return !key.sameKey(*run); });
+        if (runEnd - run > 1) {
+            sortKeys(run, runEnd, common + 1);
+        }
+        run = runEnd;
+    }
+}
+
+/**
+ * @brief Sort items by name in natural order (see naturalCompare())
+ *
+ * Names are reduced to NaturalKeys, so sorting compares integers rather
+ * than strings; the names themselves are only read to key them and to
+ * order the few that tie.
+ *
+ * @param items Items to reorder
+ * @param nameOf Returns an item's name as a std::string_view
+ */
+template <typename Item, typename NameOf>
+void sortNatural(std::vector<Item>& items, NameOf nameOf) {
+    if (items.size() < 2) {
+        return;
+    }
+    
+    std::vector<NaturalKey> keys;
+    keys.reserve(items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        keys.emplace_back(nameOf(items[i]), i);
+    }
+    sortKeys(keys.begin(), keys.end(), 0);
+    
+    std::vector<Item> sorted;
+    sorted.reserve(items.size());
+    for (const auto& key : keys) {
+        sorted.push_back(std::move(items[key.index]));
+    }
+    items.swap(sorted);
+}
+
+/**
+ * @brief Get pointers to a map's entries, in natural key order if requested
+ *
+ * Points into the map rather than copying keys, so ordering costs no
+ * string copies.
+ */
+template <typename Map>
+std::vector<const typename Map::value_type*> orderedEntries(const Map& map, bool sorted) {
+    std::vector<const typename Map::value_type*> entries;
+    entries.reserve(map.size());
+    for (const auto& entry : map) {
+        entries.push_back(&entry);
+    }
+    if (sorted) {
+        sortNatural(entries, [](const auto* entry) { return std::string_view(entry->first); });
+    }
+    return entries;
+}
+
+/**
+ * @brief Flush a file's data, or a directory's entries, to disk
+ * @param path File or directory path
+ * @param directory True if path is a directory
+ * @return False if the flush failed (always true where unsupported)
+ */
+bool syncToDisk(const std::string& path, bool directory) {
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), directory ? (O_RDONLY | O_DIRECTORY) : O_WRONLY);
+    if (fd < 0) {
+        return false;
+    }
+#ifdef __APPLE__
+    bool synced = ::fsync(fd) == 0;
+#else
+    bool synced = (directory ? ::fsync(fd) : ::fdatasync(fd)) == 0;
+#endif
+    ::close(fd);
+    return synced;
+#else
+    (void)path;
+    (void)directory;
+    return true;
+#endif
+}
+
+/**
+ * @brief Output file of writeFile() and writeBinaryFile()
+ *
+ * With atomicWrite the stream writes to a uniquely named temporary file
+ * beside the target, and commit() renames it over the target; a file that
+ * is never committed is removed again. With syncToDisk the data is on disk
+ * before the rename, and the rename itself before commit() returns.
+ */
+class OutputFile {
+public:
+    OutputFile(const std::string& path, const WriterConfig& config, std::ios::openmode mode)
+        : path_(path), atomic_(config.atomicWrite), sync_(config.syncToDisk), created_(false), committed_(false) {
+        writePath_ = path_;
+        if (atomic_) {
+            std::random_device random;
+            char suffix[17];
+            auto [end, error] = std::to_chars(suffix, suffix + sizeof(suffix),
+                                              (uint64_t(random()) << 32) | random(), 16);
+            (void)error;
+            writePath_ += ".tmp";
+            writePath_.append(suffix, end);
+        }
+        stream_.open(writePath_, mode | std::ios::trunc);
+        created_ = stream_.is_open();
+    }
+    
+    ~OutputFile() {
+        if (atomic_ && created_ && !committed_) {
+            stream_.close();
+            std::error_code error;
+            std::filesystem::remove(writePath_, error);
+        }
+    }
+    
+    OutputFile(const OutputFile&) = delete;
+    OutputFile& operator=(const OutputFile&) = delete;
+    
+    bool isOpen() const { return stream_.is_open(); }
+    std::ofstream& stream() { return stream_; }
+    
+    /**
+     * @brief Close the file and put it in place
+     * @param errorMessage Set on failure
+     * @return True if the complete file is at the target path
+     */
+    bool commit(std::string& errorMessage) {
+        stream_.close();
+        if (!stream_) {
+            errorMessage = "Cannot write file: " + writePath_;
+            return false;
+        }
+        if (sync_ && !syncToDisk(writePath_, false)) {
+            errorMessage = "Cannot sync file to disk: " + writePath_;
+            return false;
+        }
+        committed_ = true;
+        if (!atomic_) {
+            return true;
+        }
+        
+        std::error_code error;
+        std::filesystem::rename(writePath_, path_, error);
+        if (error) {
+            committed_ = false;
+            errorMessage = "Cannot rename " + writePath_ + " to " + path_;
+            return false;
+        }
+        if (sync_) {
+            std::string directory = std::filesystem::path(path_).parent_path().string();
+            if (!syncToDisk(directory.empty() ? "." : directory, true)) {
+                errorMessage = "Cannot sync directory to disk: " + directory;
+                return false;
+            }
+        }
+        return true;
+    }
+    
+private:
+    std::string path_;          ///< Target path
+    std::string writePath_;     ///< Path being written (temporary file with atomic_)
+    bool atomic_;               ///< Write beside the target and rename
+    bool sync_;                 ///< Flush to disk before completing
+    bool created_;              ///< Whether writePath_ was created
+    bool committed_;            ///< Whether commit() moved the file into place
+    std::ofstream stream_;      ///< Output stream of writePath_
+};
+
+} // namespace
+
 // WriteResult implementation
 std::string WriteResult::getSummary() const {
     std::ostringstream oss;
@@ -65,17 +423,24 @@ const WriterConfig& ExclusionWriter::getConfig() const {
 }
 
 WriteResult ExclusionWriter::writeFile(const std::string& filename, const ExclusionData& data) const {
+    return writeFile(filename, ExclusionDataView(data));
+}
+
+WriteResult ExclusionWriter::writeFile(const std::string& filename, const ExclusionDataView& view) const {
     debugLog("Starting to write file: " + filename);
     
     WriteResult result;
     
-    std::ofstream file(filename);
-    if (!file.is_open()) {
+    OutputFile file(filename, config_, std::ios::out);
+    if (!file.isOpen()) {
         result.errorMessage = "Cannot create file: " + filename;
         return result;
     }
     
-    result = writeToStream(file, data);
+    result = writeToStream(file.stream(), view);
+    if (result.success && !file.commit(result.errorMessage)) {
+        result.success = false;
+    }
     
     if (result.success) {
         debugLog("Successfully wrote " + std::to_string(result.exclusionsWritten) + " exclusions to file");
@@ -84,50 +449,134 @@ WriteResult ExclusionWriter::writeFile(const std::string& filename, const Exclus
     return result;
 }
 
+std::future<WriteResult> ExclusionWriter::writeFileAsync(const std::string& filename,
+                                                         std::shared_ptr<const ExclusionData> data) const {
+    return startFileWrite(filename, std::move(data), config_);
+}
+
+std::future<WriteResult> ExclusionWriter::startFileWrite(const std::string& filename,
+                                                         std::shared_ptr<const ExclusionData> data,
+                                                         const WriterConfig& config) const {
+    // The background writer has its own result state, so concurrent writes never share one
+    return std::async(std::launch::async, [filename, data = std::move(data), config, debug = debugMode_] {
+        ExclusionWriter writer;
+        writer.setConfig(config);
+        writer.setDebugMode(debug);
+        return writer.writeFile(filename, *data);
+    });
+}
+
+WriteResult ExclusionWriter::writeBinaryFile(const std::string& filename, const ExclusionData& data) const {
+    FrozenExclusionData frozen;
+    try {
+        frozen = data.freeze();
+    } catch (const std::length_error& e) {
+        WriteResult result;
+        result.errorMessage = e.what();
+        return result;
+    }
+    return writeBinaryFile(filename, frozen);
+}
+
+WriteResult ExclusionWriter::writeBinaryFile(const std::string& filename, const FrozenExclusionData& frozen) const {
+    debugLog("Starting to write binary cache: " + filename);
+    
+    WriteResult result;
+    
+    OutputFile file(filename, config_, std::ios::out | std::ios::binary);
+    if (!file.isOpen()) {
+        result.errorMessage = "Cannot create file: " + filename;
+        return result;
+    }
+    
+    std::string_view image = frozen.getImage();
+    file.stream().write(image.data(), static_cast<std::streamsize>(image.size()));
+    if (!file.commit(result.errorMessage)) {
+        return result;
+    }
+    
+    result.success = true;
+    result.scopesWritten = frozen.getScopeCount();
+    result.exclusionsWritten = frozen.getTotalExclusionCount();
+    result.exclusionCounts = frozen.getExclusionCountsByType();
+    debugLog("Successfully wrote " + std::to_string(image.size()) + " bytes to binary cache");
+    return result;
+}
+
 std::string ExclusionWriter::writeToString(const ExclusionData& data) const {
-    std::ostringstream oss;
-    auto result = writeToStream(oss, data);
-    return oss.str();
+    return writeToString(ExclusionDataView(data));
+}
+
+std::string ExclusionWriter::writeToString(const ExclusionDataView& view) const {
+    // Format straight into the result, presized so it rarely has to grow
+    auto scopeOrder = selectScopes(view);
+    OutputBuffer buffer;
+    buffer.reserve(estimateOutputSize(view, scopeOrder));
+    writeToBuffer(buffer, view, scopeOrder);
+    return buffer.take();
 }
 
 WriteResult ExclusionWriter::writeToStream(std::ostream& stream, const ExclusionData& data) const {
+    return writeToStream(stream, ExclusionDataView(data));
+}
+
+WriteResult ExclusionWriter::writeToStream(std::ostream& stream, const ExclusionDataView& view) const {
     debugLog("Starting to write to stream");
     
+    // Text reaches the stream in large writes as the buffer fills; the
+    // buffer never holds much more than one flush, so no size estimate
+    OutputBuffer buffer(&stream);
+    buffer.reserve(OutputBuffer::DEFAULT_FLUSH_THRESHOLD);
+    WriteResult result = writeToBuffer(buffer, view, selectScopes(view));
+    
+    if (!buffer.flush() && result.success) {
+        result.success = false;
+        result.errorMessage = "Failed to write to output stream";
+        lastResult_ = result;
+    }
+    
+    return result;
+}
+
+WriteResult ExclusionWriter::writeToBuffer(OutputBuffer& buffer, const ExclusionDataView& view,
+                                          const std::vector<const ScopeEntry*>& scopeOrder) const {
     WriteResult result;
     
     try {
         // Write header
         if (config_.includeComments) {
-            result.linesWritten += writeHeader(stream, data);
+            result.linesWritten += writeHeader(buffer, *view.data);
         }
         
-        // Get sorted scope order if needed
-        std::vector<std::string> scopeOrder;
-        for (const auto& [scopeName, scope] : data.scopes) {
-            scopeOrder.push_back(scopeName);
-        }
+        // Write each selected scope
+        size_t threadCount = std::min(ThreadPool::resolveThreadCount(config_.threadCount), scopeOrder.size());
         
-        if (config_.sortExclusions) {
-            std::sort(scopeOrder.begin(), scopeOrder.end());
+        if (threadCount <= 1) {
+            for (const auto* entry : scopeOrder) {
+                result.linesWritten += writeScope(buffer, entry->first, entry->second, view.typeMask);
+            }
+        } else {
+            result.linesWritten += writeScopesParallel(buffer, scopeOrder, view.typeMask, threadCount);
         }
         
-        // Write each scope
-        for (const auto& scopeName : scopeOrder) {
-            const auto& scope = data.scopes.at(scopeName);
-            result.linesWritten += writeScope(stream, scopeName, scope);
+        for (const auto* entry : scopeOrder) {
+            const auto& scope = entry->second;
             result.scopesWritten++;
-            result.exclusionsWritten += scope.getTotalExclusionCount();
-            
-            // Update counts by type
-            result.exclusionCounts[ExclusionType::BLOCK] += scope.blockExclusions.size();
-            result.exclusionCounts[ExclusionType::CONDITION] += scope.conditionExclusions.size();
-            
-            for (const auto& [signalName, toggles] : scope.toggleExclusions) {
-                result.exclusionCounts[ExclusionType::TOGGLE] += toggles.size();
-            }
             
+            // Update counts by type (types outside the view count as 0)
+            std::pair<ExclusionType, size_t> counts[] = {
+                {ExclusionType::BLOCK, scope.blockExclusions.size()},
+                {ExclusionType::TOGGLE, scope.getToggleExclusionCount()},
+                {ExclusionType::FSM, 0},
+                {ExclusionType::CONDITION, scope.conditionExclusions.size()}
+            };
             for (const auto& [fsmName, fsms] : scope.fsmExclusions) {
-                result.exclusionCounts[ExclusionType::FSM] += fsms.size();
+                counts[2].second += fsms.size();
+            }
+            for (const auto& [type, count] : counts) {
+                size_t written = view.includesType(type) ? count : 0;
+                result.exclusionCounts[type] += written;
+                result.exclusionsWritten += written;
             }
         }
         
@@ -146,41 +595,21 @@ WriteResult ExclusionWriter::writeScopes(const std::string& filename, const Excl
                                         const std::vector<std::string>& scopeNames) const {
     debugLog("Writing specific scopes to file: " + filename);
     
-    // Create filtered data
-    ExclusionData filteredData = data;
-    filteredData.scopes.clear();
-    
-    for (const auto& scopeName : scopeNames) {
-        auto it = data.scopes.find(scopeName);
-        if (it != data.scopes.end()) {
-            filteredData.scopes[scopeName] = it->second;
-        }
-    }
-    
-    return writeFile(filename, filteredData);
+    ExclusionDataView view(data);
+    view.scopeNames = scopeNames;
+    return writeFile(filename, view);
 }
 
 WriteResult ExclusionWriter::writeFilteredByType(const std::string& filename, const ExclusionData& data,
                                                 const std::vector<ExclusionType>& types) const {
     debugLog("Writing filtered exclusions by type to file: " + filename);
     
-    // Create filtered data
-    ExclusionData filteredData = data;
-    
-    // Filter out unwanted exclusion types from each scope
-    for (auto& [scopeName, scope] : filteredData.scopes) {
-        bool includeBlock = std::find(types.begin(), types.end(), ExclusionType::BLOCK) != types.end();
-        bool includeToggle = std::find(types.begin(), types.end(), ExclusionType::TOGGLE) != types.end();
-        bool includeFsm = std::find(types.begin(), types.end(), ExclusionType::FSM) != types.end();
-        bool includeCondition = std::find(types.begin(), types.end(), ExclusionType::CONDITION) != types.end();
-        
-        if (!includeBlock) scope.blockExclusions.clear();
-        if (!includeToggle) scope.toggleExclusions.clear();
-        if (!includeFsm) scope.fsmExclusions.clear();
-        if (!includeCondition) scope.conditionExclusions.clear();
+    ExclusionDataView view(data);
+    view.typeMask = 0;
+    for (ExclusionType type : types) {
+        view.typeMask |= ExclusionDataView::typeBit(type);
     }
-    
-    return writeFile(filename, filteredData);
+    return writeFile(filename, view);
 }
 
 WriteResult ExclusionWriter::appendToFile(const std::string& filename, const ExclusionData& data) const {
@@ -211,19 +640,18 @@ WriteResult ExclusionWriter::writeMultipleFiles(const std::string& baseFilename,
     debugLog("Writing multiple files with base: " + baseFilename);
     
     WriteResult combinedResult;
+    combinedResult.success = true;
     
-    for (size_t i = 0; i < dataList.size(); ++i) {
-        std::string filename = baseFilename;
-        
-        // Insert index before extension
-        size_t dotPos = filename.rfind('.');
-        if (dotPos != std::string::npos) {
-            filename.insert(dotPos, "_" + std::to_string(i));
-        } else {
-            filename += "_" + std::to_string(i);
-        }
-        
-        auto result = writeFile(filename, *dataList[i]);
+    // Files are the unit of parallelism here, so each one is formatted serially
+    WriterConfig fileConfig = config_;
+    fileConfig.threadCount = 1;
+    size_t inFlight = std::max<size_t>(2, ThreadPool::resolveThreadCount(config_.threadCount));
+    
+    std::deque<std::pair<std::string, std::future<WriteResult>>> pending;
+    auto collect = [&] {
+        auto [filename, future] = std::move(pending.front());
+        pending.pop_front();
+        auto result = future.get();
         
         // Combine results
         combinedResult.linesWritten += result.linesWritten;
@@ -237,14 +665,32 @@ WriteResult ExclusionWriter::writeMultipleFiles(const std::string& baseFilename,
         combinedResult.warnings.insert(combinedResult.warnings.end(),
                                       result.warnings.begin(), result.warnings.end());
         
-        if (!result.success) {
+        if (!result.success && combinedResult.success) {
             combinedResult.success = false;
             combinedResult.errorMessage = "Failed to write " + filename + ": " + result.errorMessage;
-            return combinedResult;
         }
+    };
+    
+    for (size_t i = 0; i < dataList.size() && combinedResult.success; ++i) {
+        std::string filename = baseFilename;
+        
+        // Insert index before extension
+        size_t dotPos = filename.rfind('.');
+        if (dotPos != std::string::npos) {
+            filename.insert(dotPos, "_" + std::to_string(i));
+        } else {
+            filename += "_" + std::to_string(i);
+        }
+        
+        pending.emplace_back(filename, startFileWrite(filename, dataList[i], fileConfig));
+        if (pending.size() >= inFlight) {
+            collect();
+        }
+    }
+    while (!pending.empty()) {
+        collect();
     }
     
-    combinedResult.success = true;
     return combinedResult;
 }
 
@@ -269,6 +715,11 @@ std::vector<std::string> ExclusionWriter::validateForWriting(const ExclusionData
                 issues.push_back("Toggle exclusion with empty signal name in scope: " + scopeName);
             }
         }
+        for (size_t row = 0; row < scope.toggleTable.getRowCount(); ++row) {
+            if (scope.toggleTable.signalName(row).empty()) {
+                issues.push_back("Toggle exclusion with empty signal name in scope: " + scopeName);
+            }
+        }
         
         for (const auto& [fsmName, fsms] : scope.fsmExclusions) {
             if (fsmName.empty()) {
@@ -312,6 +763,15 @@ std::string ExclusionWriter::preview(const ExclusionData& data, size_t maxLines)
 }
 
 size_t ExclusionWriter::estimateOutputSize(const ExclusionData& data) const {
+    return estimateOutputSize(ExclusionDataView(data));
+}
+
+size_t ExclusionWriter::estimateOutputSize(const ExclusionDataView& view) const {
+    return estimateOutputSize(view, selectScopes(view));
+}
+
+size_t ExclusionWriter::estimateOutputSize(const ExclusionDataView& view,
+                                          const std::vector<const ScopeEntry*>& scopeOrder) const {
     size_t estimatedSize = 0;
     
     // Header estimate
@@ -319,38 +779,46 @@ size_t ExclusionWriter::estimateOutputSize(const ExclusionData& data) const {
         estimatedSize += 500; // Rough header size
     }
     
-    for (const auto& [scopeName, scope] : data.scopes) {
+    for (const auto* entry : scopeOrder) {
+        const auto& [scopeName, scope] = *entry;
+        
         // Scope header
         estimatedSize += 100 + scopeName.length();
         
         // Block exclusions
-        for (const auto& [blockId, block] : scope.blockExclusions) {
-            estimatedSize += 50 + blockId.length() + block.checksum.length() + 
-                           block.sourceCode.length() + block.annotation.length();
+        if (view.includesType(ExclusionType::BLOCK)) {
+            for (const auto& [blockId, block] : scope.blockExclusions) {
+                estimatedSize += 50 + blockId.length() + block.checksum.length() + 
+                               block.sourceCode.length() + block.annotation.length();
+            }
         }
         
         // Toggle exclusions
-        for (const auto& [signalName, toggles] : scope.toggleExclusions) {
-            for (const auto& toggle : toggles) {
-                estimatedSize += 50 + signalName.length() + toggle.netDescription.length() + 
+        if (view.includesType(ExclusionType::TOGGLE)) {
+            scope.forEachToggle([&estimatedSize](const ToggleExclusion& toggle) {
+                estimatedSize += 50 + toggle.signalName.length() + toggle.netDescription.length() + 
                                toggle.annotation.length();
-            }
+            });
         }
         
         // FSM exclusions
-        for (const auto& [fsmName, fsms] : scope.fsmExclusions) {
-            for (const auto& fsm : fsms) {
-                estimatedSize += 50 + fsmName.length() + fsm.checksum.length() + 
-                               fsm.fromState.length() + fsm.toState.length() + 
-                               fsm.transitionId.length() + fsm.annotation.length();
+        if (view.includesType(ExclusionType::FSM)) {
+            for (const auto& [fsmName, fsms] : scope.fsmExclusions) {
+                for (const auto& fsm : fsms) {
+                    estimatedSize += 50 + fsmName.length() + fsm.checksum.length() + 
+                                   fsm.fromState.length() + fsm.toState.length() + 
+                                   fsm.transitionId.length() + fsm.annotation.length();
+                }
             }
         }
         
         // Condition exclusions
-        for (const auto& [condId, condition] : scope.conditionExclusions) {
-            estimatedSize += 100 + condId.length() + condition.checksum.length() + 
-                           condition.expression.length() + condition.parameters.length() + 
-                           condition.coverage.length() + condition.annotation.length();
+        if (view.includesType(ExclusionType::CONDITION)) {
+            for (const auto& [condId, condition] : scope.conditionExclusions) {
+                estimatedSize += 100 + condId.length() + condition.checksum.length() + 
+                               condition.expression.length() + condition.parameters.length() + 
+                               condition.coverage.length() + condition.annotation.length();
+            }
         }
     }
     
@@ -366,310 +834,412 @@ bool ExclusionWriter::isDebugMode() const {
 }
 
 // Private helper methods
-size_t ExclusionWriter::writeHeader(std::ostream& stream, const ExclusionData& data) const {
-    size_t linesWritten = 0;
+std::vector<const ExclusionWriter::ScopeEntry*> ExclusionWriter::selectScopes(const ExclusionDataView& view) const {
+    std::vector<const ScopeEntry*> scopes;
+    if (!view.scopeNames) {
+        scopes = orderedEntries(view.data->scopes, false);
+    } else {
+        std::unordered_set<const ScopeEntry*> seen;
+        scopes.reserve(view.scopeNames->size());
+        for (const auto& scopeName : *view.scopeNames) {
+            auto it = view.data->scopes.find(scopeName);
+            if (it != view.data->scopes.end() && seen.insert(&*it).second) {
+                scopes.push_back(&*it);
+            }
+        }
+    }
     
-    writeLine(stream, "//==================================================");
-    linesWritten++;
+    if (view.scopeFilter) {
+        std::erase_if(scopes, [&view](const ScopeEntry* entry) { return !view.scopeFilter(entry->first, entry->second); });
+    }
+    if (config_.sortExclusions) {
+        sortNatural(scopes, [](const ScopeEntry* entry) { return std::string_view(entry->first); });
+    }
+    return scopes;
+}
+
+size_t ExclusionWriter::writeScopesParallel(OutputBuffer& buffer, const std::vector<const ScopeEntry*>& scopeOrder,
+                                           unsigned typeMask, size_t threadCount) const {
+    struct Formatted {
+        std::string text;
+        size_t lines = 0;
+    };
+    
+    // About eight tasks per worker, each a run of consecutive scopes, so
+    // one large scope does not leave the other workers idle for long
+    size_t totalExclusions = 0;
+    for (const auto* entry : scopeOrder) {
+        totalExclusions += entry->second.getTotalExclusionCount() + 1;
+    }
+    size_t taskExclusions = std::max<size_t>(1, totalExclusions / (threadCount * 8));
+    
+    std::vector<std::pair<size_t, size_t>> tasks;
+    for (size_t begin = 0; begin < scopeOrder.size();) {
+        size_t end = begin;
+        size_t exclusions = 0;
+        while (end < scopeOrder.size() && exclusions < taskExclusions) {
+            exclusions += scopeOrder[end++]->second.getTotalExclusionCount() + 1;
+        }
+        tasks.emplace_back(begin, end);
+        begin = end;
+    }
     
-    writeLine(stream, "// This file contains the Excluded objects");
-    linesWritten++;
+    auto formatTask = [this, &scopeOrder, typeMask](size_t begin, size_t end) {
+        Formatted formatted;
+        OutputBuffer taskBuffer;
+        for (size_t i = begin; i < end; ++i) {
+            formatted.lines += writeScope(taskBuffer, scopeOrder[i]->first, scopeOrder[i]->second, typeMask);
+        }
+        formatted.text = taskBuffer.take();
+        return formatted;
+    };
     
-    if (!data.generatedBy.empty()) {
-        writeLine(stream, "// Generated By User: " + data.generatedBy);
-    } else {
-        writeLine(stream, "// Generated By User: ExclusionCoverageParser");
+    // Append in scope order while a bounded window of later tasks is formatted
+    size_t linesWritten = 0;
+    size_t window = threadCount * 2;
+    ThreadPool pool(threadCount);
+    std::deque<std::future<Formatted>> pending;
+    size_t next = 0;
+    while (next < tasks.size() || !pending.empty()) {
+        while (next < tasks.size() && pending.size() < window) {
+            auto [begin, end] = tasks[next++];
+            pending.push_back(pool.submit([&formatTask, begin, end] { return formatTask(begin, end); }));
+        }
+        Formatted formatted = pending.front().get();
+        pending.pop_front();
+        buffer.append(formatted.text);
+        buffer.flushIfFull();
+        linesWritten += formatted.lines;
     }
-    linesWritten++;
     
-    if (!data.formatVersion.empty()) {
-        writeLine(stream, "// Format Version: " + data.formatVersion);
-    } else {
-        writeLine(stream, "// Format Version: 2");
-    }
-    linesWritten++;
+    return linesWritten;
+}
+
+size_t ExclusionWriter::writeHeader(OutputBuffer& buffer, const ExclusionData& data) const {
+    size_t linesWritten = 0;
+    
+    // Each field falls back to a default when the data does not carry it
+    auto writeField = [&](std::string_view label, std::string_view value, std::string_view fallback) {
+        beginLine(buffer);
+        buffer.append(label);
+        buffer.append(value.empty() ? fallback : value);
+        linesWritten += endLine(buffer);
+    };
+    
+    beginLine(buffer);
+    buffer.append("//==================================================");
+    linesWritten += endLine(buffer);
+    
+    beginLine(buffer);
+    buffer.append("// This file contains the Excluded objects");
+    linesWritten += endLine(buffer);
+    
+    writeField("// Generated By User: ", data.generatedBy, "ExclusionCoverageParser");
+    writeField("// Format Version: ", data.formatVersion, "2");
     
     // Generate current date if not provided
     std::string dateStr = data.generationDate;
     if (dateStr.empty()) {
         auto now = std::chrono::system_clock::now();
         auto time_t = std::chrono::system_clock::to_time_t(now);
+        // Files may be written on several threads; std::localtime shares one buffer
+        std::tm local{};
+#ifdef _WIN32
+        localtime_s(&local, &time_t);
+#else
+        localtime_r(&time_t, &local);
+#endif
         std::ostringstream oss;
-        oss << std::put_time(std::localtime(&time_t), "%a %b %d %H:%M:%S %Y");
+        oss << std::put_time(&local, "%a %b %d %H:%M:%S %Y");
         dateStr = oss.str();
     }
-    writeLine(stream, "// Date: " + dateStr);
-    linesWritten++;
-    
-    if (!data.exclusionMode.empty()) {
-        writeLine(stream, "// ExclMode: " + data.exclusionMode);
-    } else {
-        writeLine(stream, "// ExclMode: default");
-    }
-    linesWritten++;
+    writeField("// Date: ", dateStr, "");
+    writeField("// ExclMode: ", data.exclusionMode, "default");
     
-    writeLine(stream, "//==================================================");
-    linesWritten++;
+    beginLine(buffer);
+    buffer.append("//==================================================");
+    linesWritten += endLine(buffer);
     
     return linesWritten;
 }
 
-size_t ExclusionWriter::writeScope(std::ostream& stream, const std::string& scopeName, 
-                                  const ExclusionScope& scope) const {
+size_t ExclusionWriter::writeScope(OutputBuffer& buffer, const std::string& scopeName, 
+                                  const ExclusionScope& scope, unsigned typeMask) const {
     size_t linesWritten = 0;
     
     // Write checksum if present
     if (!scope.checksum.empty()) {
-        linesWritten += writeChecksum(stream, scope.checksum);
+        linesWritten += writeChecksum(buffer, scope.checksum);
     } else if (config_.generateChecksums) {
-        std::string checksum = generateScopeChecksum(scope);
-        linesWritten += writeChecksum(stream, checksum);
+        std::string checksum = generateScopeChecksum(scope, typeMask);
+        linesWritten += writeChecksum(buffer, checksum);
     }
     
     // Write scope declaration
-    std::string scopeType = scope.isModule ? "MODULE:" : "INSTANCE:";
-    writeLine(stream, scopeType + scopeName);
-    linesWritten++;
-    
-    // Get sorted order if needed
-    auto [blockOrder, toggleOrder, fsmOrder, conditionOrder] = getSortedOrder(scope);
+    beginLine(buffer);
+    buffer.append(scope.isModule ? "MODULE:" : "INSTANCE:");
+    buffer.append(scopeName);
+    linesWritten += endLine(buffer);
     
     // Write exclusions in order
-    linesWritten += writeBlockExclusions(stream, scope);
-    linesWritten += writeToggleExclusions(stream, scope);
-    linesWritten += writeFsmExclusions(stream, scope);
-    linesWritten += writeConditionExclusions(stream, scope);
+    if (typeMask & ExclusionDataView::typeBit(ExclusionType::BLOCK)) {
+        linesWritten += writeBlockExclusions(buffer, scope);
+    }
+    if (typeMask & ExclusionDataView::typeBit(ExclusionType::TOGGLE)) {
+        linesWritten += writeToggleExclusions(buffer, scope);
+    }
+    if (typeMask & ExclusionDataView::typeBit(ExclusionType::FSM)) {
+        linesWritten += writeFsmExclusions(buffer, scope);
+    }
+    if (typeMask & ExclusionDataView::typeBit(ExclusionType::CONDITION)) {
+        linesWritten += writeConditionExclusions(buffer, scope);
+    }
     
     return linesWritten;
 }
 
-size_t ExclusionWriter::writeBlockExclusions(std::ostream& stream, const ExclusionScope& scope) const {
+size_t ExclusionWriter::writeBlockExclusions(OutputBuffer& buffer, const ExclusionScope& scope) const {
     size_t linesWritten = 0;
     
-    std::vector<std::string> blockOrder;
-    for (const auto& [blockId, block] : scope.blockExclusions) {
-        blockOrder.push_back(blockId);
-    }
-    
-    if (config_.sortExclusions) {
-        std::sort(blockOrder.begin(), blockOrder.end());
-    }
-    
-    for (const auto& blockId : blockOrder) {
-        const auto& block = scope.blockExclusions.at(blockId);
+    for (const auto* entry : orderedEntries(scope.blockExclusions, config_.sortExclusions)) {
+        const auto& [blockId, block] = *entry;
         
         if (config_.includeAnnotations && !block.annotation.empty()) {
-            linesWritten += writeAnnotation(stream, block.annotation);
+            linesWritten += writeAnnotation(buffer, block.annotation);
         }
         
-        std::string line = "Block " + blockId + " \"" + block.checksum + "\" \"" + 
-                          escapeString(block.sourceCode) + "\"";
-        writeLine(stream, line);
-        linesWritten++;
+        linesWritten += writeBlockLine(buffer, blockId, block);
     }
     
     return linesWritten;
 }
 
-size_t ExclusionWriter::writeToggleExclusions(std::ostream& stream, const ExclusionScope& scope) const {
+size_t ExclusionWriter::writeBlockLine(OutputBuffer& buffer, std::string_view blockId,
+                                      const BlockExclusion& block) const {
+    beginLine(buffer);
+    buffer.append("Block ");
+    buffer.append(blockId);
+    buffer.append(" \"");
+    buffer.append(block.checksum);
+    buffer.append("\" \"");
+    buffer.appendEscaped(block.sourceCode);
+    buffer.append('"');
+    return endLine(buffer);
+}
+
+size_t ExclusionWriter::writeToggleExclusions(OutputBuffer& buffer, const ExclusionScope& scope) const {
     size_t linesWritten = 0;
     
-    std::vector<std::string> signalOrder;
+    // One group per signal: its list in toggleExclusions and its rows in toggleTable
+    struct SignalGroup {
+        std::string_view signalName;
+        const ExclusionVector<ToggleExclusion>* toggles;
+        std::vector<size_t> rows;
+    };
+    
+    std::vector<SignalGroup> signalOrder;
+    signalOrder.reserve(scope.toggleExclusions.size());
     for (const auto& [signalName, toggles] : scope.toggleExclusions) {
-        signalOrder.push_back(signalName);
+        signalOrder.push_back({signalName, &toggles, {}});
+    }
+    
+    const ToggleTable& table = scope.toggleTable;
+    if (!table.empty()) {
+        // Rows of a signal are written together, in table order, as if they were one list
+        std::unordered_map<std::string_view, size_t> groupIndex;
+        for (size_t i = 0; i < signalOrder.size(); ++i) {
+            groupIndex.emplace(signalOrder[i].signalName, i);
+        }
+        for (size_t row = 0; row < table.getRowCount(); ++row) {
+            auto [it, inserted] = groupIndex.try_emplace(table.signalName(row).view(), signalOrder.size());
+            if (inserted) {
+                signalOrder.push_back({table.signalName(row).view(), nullptr, {}});
+            }
+            signalOrder[it->second].rows.push_back(row);
+        }
     }
     
     if (config_.sortExclusions) {
-        std::sort(signalOrder.begin(), signalOrder.end());
+        sortNatural(signalOrder, [](const SignalGroup& group) { return group.signalName; });
     }
     
-    for (const auto& signalName : signalOrder) {
-        const auto& toggles = scope.toggleExclusions.at(signalName);
-        
-        for (const auto& toggle : toggles) {
-            if (config_.includeAnnotations && !toggle.annotation.empty()) {
-                linesWritten += writeAnnotation(stream, toggle.annotation);
-            }
-            
-            std::string line = "Toggle ";
-            
-            // Add direction if specified
-            std::string direction = formatToggleDirection(toggle.direction);
-            if (!direction.empty()) {
-                line += direction + " ";
-            }
-            
-            line += toggle.signalName;
-            
-            // Add bit index if specified
-            if (toggle.bitIndex.has_value()) {
-                line += " [" + std::to_string(toggle.bitIndex.value()) + "]";
+    auto writeToggle = [&](ToggleDirection direction, std::string_view signalName, std::optional<int> bitIndex,
+                           std::string_view netDescription, std::string_view annotation) {
+        if (config_.includeAnnotations && !annotation.empty()) {
+            linesWritten += writeAnnotation(buffer, annotation);
+        }
+        linesWritten += writeToggleLine(buffer, direction, signalName, bitIndex, netDescription);
+    };
+    
+    for (const auto& group : signalOrder) {
+        if (group.toggles) {
+            for (const auto& toggle : *group.toggles) {
+                writeToggle(toggle.direction, toggle.signalName, toggle.bitIndex, toggle.netDescription,
+                            toggle.annotation);
             }
-            
-            line += " \"" + escapeString(toggle.netDescription) + "\"";
-            
-            writeLine(stream, line);
-            linesWritten++;
+        }
+        for (size_t row : group.rows) {
+            // Folded 1to0/0to1 pairs are written back as their two original lines
+            table.forEachDirection(row, [&](ToggleDirection direction) {
+                writeToggle(direction, group.signalName, table.bitIndex(row), table.netDescription(row),
+                            table.annotation(row));
+            });
         }
     }
     
     return linesWritten;
 }
 
-size_t ExclusionWriter::writeFsmExclusions(std::ostream& stream, const ExclusionScope& scope) const {
-    size_t linesWritten = 0;
-    
-    std::vector<std::string> fsmOrder;
-    for (const auto& [fsmName, fsms] : scope.fsmExclusions) {
-        fsmOrder.push_back(fsmName);
+size_t ExclusionWriter::writeToggleLine(OutputBuffer& buffer, ToggleDirection direction, std::string_view signalName,
+                                       std::optional<int> bitIndex, std::string_view netDescription) const {
+    beginLine(buffer);
+    buffer.append("Toggle ");
+    
+    // Add direction if specified
+    if (direction == ToggleDirection::ZERO_TO_ONE) {
+        buffer.append("0to1 ");
+    } else if (direction == ToggleDirection::ONE_TO_ZERO) {
+        buffer.append("1to0 ");
     }
     
-    if (config_.sortExclusions) {
-        std::sort(fsmOrder.begin(), fsmOrder.end());
+    buffer.append(signalName);
+    
+    // Add bit index if specified
+    if (bitIndex.has_value()) {
+        buffer.append(" [");
+        buffer.appendNumber(*bitIndex);
+        buffer.append(']');
     }
     
-    for (const auto& fsmName : fsmOrder) {
-        const auto& fsms = scope.fsmExclusions.at(fsmName);
+    buffer.append(" \"");
+    buffer.appendEscaped(netDescription);
+    buffer.append('"');
+    return endLine(buffer);
+}
+
+size_t ExclusionWriter::writeFsmExclusions(OutputBuffer& buffer, const ExclusionScope& scope) const {
+    size_t linesWritten = 0;
+    
+    for (const auto* entry : orderedEntries(scope.fsmExclusions, config_.sortExclusions)) {
+        const auto& fsms = entry->second;
         
         for (const auto& fsm : fsms) {
             if (config_.includeAnnotations && !fsm.annotation.empty()) {
-                linesWritten += writeAnnotation(stream, fsm.annotation);
+                linesWritten += writeAnnotation(buffer, fsm.annotation);
             }
             
-            if (fsm.isTransition) {
-                std::string line = "Transition " + fsm.fromState + "->" + fsm.toState + 
-                                 " \"" + fsm.transitionId + "\"";
-                writeLine(stream, line);
-            } else {
-                std::string line = "Fsm " + fsm.fsmName + " \"" + fsm.checksum + "\"";
-                writeLine(stream, line);
-            }
-            linesWritten++;
+            linesWritten += writeFsmLine(buffer, fsm);
         }
     }
     
     return linesWritten;
 }
 
-size_t ExclusionWriter::writeConditionExclusions(std::ostream& stream, const ExclusionScope& scope) const {
-    size_t linesWritten = 0;
-    
-    std::vector<std::string> conditionOrder;
-    for (const auto& [condId, condition] : scope.conditionExclusions) {
-        conditionOrder.push_back(condId);
-    }
-    
-    if (config_.sortExclusions) {
-        std::sort(conditionOrder.begin(), conditionOrder.end());
+size_t ExclusionWriter::writeFsmLine(OutputBuffer& buffer, const FsmExclusion& fsm) const {
+    beginLine(buffer);
+    if (fsm.isTransition) {
+        buffer.append("Transition ");
+        buffer.append(fsm.fromState);
+        buffer.append("->");
+        buffer.append(fsm.toState);
+        buffer.append(" \"");
+        buffer.append(fsm.transitionId);
+    } else {
+        buffer.append("Fsm ");
+        buffer.append(fsm.fsmName);
+        buffer.append(" \"");
+        buffer.append(fsm.checksum);
     }
+    buffer.append('"');
+    return endLine(buffer);
+}
+
+size_t ExclusionWriter::writeConditionExclusions(OutputBuffer& buffer, const ExclusionScope& scope) const {
+    size_t linesWritten = 0;
     
-    for (const auto& condId : conditionOrder) {
-        const auto& condition = scope.conditionExclusions.at(condId);
+    for (const auto* entry : orderedEntries(scope.conditionExclusions, config_.sortExclusions)) {
+        const auto& [condId, condition] = *entry;
         
         if (config_.includeAnnotations && !condition.annotation.empty()) {
-            linesWritten += writeAnnotation(stream, condition.annotation);
-        }
-        
-        std::string line = "Condition " + condId + " \"" + condition.checksum + "\" \"" + 
-                          escapeString(condition.expression);
-        
-        if (!condition.parameters.empty()) {
-            line += " " + condition.parameters;
-        }
-        
-        line += "\"";
-        
-        if (!condition.coverage.empty()) {
-            line += " (" + condition.coverage + ")";
+            linesWritten += writeAnnotation(buffer, condition.annotation);
         }
         
-        writeLine(stream, line);
-        linesWritten++;
+        linesWritten += writeConditionLine(buffer, condId, condition);
     }
     
     return linesWritten;
 }
 
-size_t ExclusionWriter::writeAnnotation(std::ostream& stream, const std::string& annotation) const {
-    if (annotation.empty()) return 0;
+size_t ExclusionWriter::writeConditionLine(OutputBuffer& buffer, std::string_view conditionId,
+                                          const ConditionExclusion& condition) const {
+    beginLine(buffer);
+    buffer.append("Condition ");
+    buffer.append(conditionId);
+    buffer.append(" \"");
+    buffer.append(condition.checksum);
+    buffer.append("\" \"");
+    buffer.appendEscaped(condition.expression);
     
-    writeLine(stream, "ANNOTATION: \"" + escapeString(annotation) + "\"");
-    return 1;
-}
-
-size_t ExclusionWriter::writeChecksum(std::ostream& stream, const std::string& checksum) const {
-    writeLine(stream, "CHECKSUM: \"" + checksum + "\"");
-    return 1;
-}
-
-std::string ExclusionWriter::escapeString(const std::string& str) const {
-    std::string escaped = str;
+    if (!condition.parameters.empty()) {
+        buffer.append(' ');
+        buffer.append(condition.parameters);
+    }
+    
+    buffer.append('"');
     
-    // Escape quotes
-    size_t pos = 0;
-    while ((pos = escaped.find('"', pos)) != std::string::npos) {
-        escaped.replace(pos, 1, "\\\"");
-        pos += 2;
+    if (!condition.coverage.empty()) {
+        buffer.append(" (");
+        buffer.append(condition.coverage);
+        buffer.append(')');
     }
     
-    return escaped;
+    return endLine(buffer);
 }
 
-std::string ExclusionWriter::formatToggleDirection(ToggleDirection direction) const {
-    return toggleDirectionToString(direction);
+size_t ExclusionWriter::writeAnnotation(OutputBuffer& buffer, std::string_view annotation,
+                                       std::string_view keyword) const {
+    if (annotation.empty()) return 0;
+    
+    beginLine(buffer);
+    buffer.append(keyword);
+    buffer.append(": \"");
+    buffer.appendEscaped(annotation);
+    buffer.append('"');
+    return endLine(buffer);
 }
 
-std::string ExclusionWriter::generateScopeChecksum(const ExclusionScope& scope) const {
+size_t ExclusionWriter::writeChecksum(OutputBuffer& buffer, std::string_view checksum) const {
+    beginLine(buffer);
+    buffer.append("CHECKSUM: \"");
+    buffer.append(checksum);
+    buffer.append('"');
+    return endLine(buffer);
+}
+
+std::string ExclusionWriter::generateScopeChecksum(const ExclusionScope& scope, unsigned typeMask) const {
     // Simple checksum generation based on scope content
     // In practice, you might want a more sophisticated algorithm
     size_t hash = 0;
     
-    for (const auto& [blockId, block] : scope.blockExclusions) {
-        hash ^= std::hash<std::string>{}(blockId) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    if (typeMask & ExclusionDataView::typeBit(ExclusionType::BLOCK)) {
+        for (const auto& [blockId, block] : scope.blockExclusions) {
+            hash ^= std::hash<std::string>{}(blockId) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        }
     }
     
-    for (const auto& [signalName, toggles] : scope.toggleExclusions) {
-        hash ^= std::hash<std::string>{}(signalName) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    if (typeMask & ExclusionDataView::typeBit(ExclusionType::TOGGLE)) {
+        for (const auto& [signalName, toggles] : scope.toggleExclusions) {
+            hash ^= std::hash<std::string>{}(signalName) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        }
+        
+        for (size_t row = 0; row < scope.toggleTable.getRowCount(); ++row) {
+            hash ^= std::hash<std::string_view>{}(scope.toggleTable.signalName(row)) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        }
     }
     
     return std::to_string(hash);
 }
 
-std::tuple<std::vector<std::string>, std::vector<std::string>, 
-           std::vector<std::string>, std::vector<std::string>> 
-ExclusionWriter::getSortedOrder(const ExclusionScope& scope) const {
-    std::vector<std::string> blockOrder, toggleOrder, fsmOrder, conditionOrder;
-    
-    // Get all keys
-    for (const auto& [key, value] : scope.blockExclusions) {
-        blockOrder.push_back(key);
-    }
-    for (const auto& [key, value] : scope.toggleExclusions) {
-        toggleOrder.push_back(key);
-    }
-    for (const auto& [key, value] : scope.fsmExclusions) {
-        fsmOrder.push_back(key);
-    }
-    for (const auto& [key, value] : scope.conditionExclusions) {
-        conditionOrder.push_back(key);
-    }
-    
-    // Sort if requested
-    if (config_.sortExclusions) {
-        std::sort(blockOrder.begin(), blockOrder.end());
-        std::sort(toggleOrder.begin(), toggleOrder.end());
-        std::sort(fsmOrder.begin(), fsmOrder.end());
-        std::sort(conditionOrder.begin(), conditionOrder.end());
-    }
-    
-    return {blockOrder, toggleOrder, fsmOrder, conditionOrder};
-}
-
-size_t ExclusionWriter::writeLine(std::ostream& stream, const std::string& line) const {
-    stream << config_.indentation << line << config_.lineEnding;
-    return 1;
-}
-
 void ExclusionWriter::addWarning(const std::string& warning) const {
     lastResult_.warnings.push_back(warning);
 }
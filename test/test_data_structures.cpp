@@ -13,6 +13,9 @@
 #include <gtest/gtest.h>
 #include "ExclusionTypes.h"
 #include "ExclusionData.h"
+#include "ExclusionFrozenData.h"
+#include "ExclusionVisitor.h"
+#include "ExclusionLookup.h"
 
 using namespace ExclusionParser;
 
@@ -198,6 +201,79 @@ TEST_F(DataStructureTest, ExclusionDataMerge) {
     EXPECT_TRUE(mergedScope1.blockExclusions.find("3") != mergedScope1.blockExclusions.end());
 }
 
+/**
+ * @brief Test string interning and sharing of text between merged data
+ */
+TEST_F(DataStructureTest, StringPoolInterning) {
+    StringPool pool;
+    InternedString first = pool.intern("unused");
+    InternedString second = pool.intern(std::string("unused"));
+    EXPECT_EQ(first.storage(), second.storage());
+    EXPECT_EQ(first, "unused");
+    EXPECT_EQ(pool.size(), 1);
+    EXPECT_TRUE(pool.intern("").empty());
+
+    // Handles outlive the pool that created them
+    pool.clear();
+    EXPECT_EQ(second, "unused");
+
+    // Text from another data is shared after merge and append
+    ExclusionData target;
+    ExclusionData source;
+    InternedString note = target.stringPool.intern("Legacy code");
+    source.getOrCreateScope("tb.a").addBlockExclusion(
+        BlockExclusion("1", "1", "a = 1;", source.stringPool.intern("Legacy code")));
+    source.getOrCreateScope("tb.a").addToggleExclusion(
+        ToggleExclusion(ToggleDirection::BOTH, "sig", std::nullopt, "net sig", "Legacy code"));
+
+    target.merge(source);
+    EXPECT_EQ(target.scopes["tb.a"].blockExclusions["1"].annotation.storage(), note.storage());
+
+    ExclusionData appended;
+    appended.stringPool.intern("Legacy code");
+    appended.append(std::move(source));
+    EXPECT_EQ(appended.scopes["tb.a"].blockExclusions["1"].annotation.storage(),
+              appended.stringPool.intern("Legacy code").storage());
+
+    // Text assigned outside a pool keeps its own copy
+    EXPECT_EQ(appended.scopes["tb.a"].toggleExclusions["sig"][0].annotation, "Legacy code");
+}
+
+/**
+ * @brief Test that copies, moves and clear() keep data independent of its source
+ */
+TEST_F(DataStructureTest, ExclusionDataOwnership) {
+    auto source = std::make_unique<ExclusionData>("owned.el");
+    ExclusionScope& scope = source->getOrCreateScope("tb.dut", "1", false);
+    scope.addBlockExclusion(BlockExclusion("10", "2", "assign a = b;"));
+    scope.addToggleExclusion(ToggleExclusion(ToggleDirection::BOTH, "bus", 3));
+
+    ExclusionData copied(*source);
+    ExclusionData assigned;
+    assigned = *source;
+    ExclusionData moved(std::move(*source));
+    source.reset();
+
+    for (const ExclusionData* data : {&copied, &assigned, &moved}) {
+        ASSERT_EQ(data->getTotalExclusionCount(), 2u);
+        EXPECT_EQ(data->scopes.at("tb.dut").toggleExclusions.at("bus")[0].bitIndex, 3);
+    }
+    EXPECT_EQ(copied, moved);
+
+#ifdef EXCLUSION_USE_PMR
+    // Containers allocate from the arena of the object that holds them
+    EXPECT_EQ(moved.scopes.get_allocator().resource(), moved.getMemoryResource());
+    EXPECT_EQ(moved.scopes.at("tb.dut").toggleExclusions.at("bus").get_allocator().resource(),
+              moved.getMemoryResource());
+#endif
+
+    // Cleared data is reusable
+    moved.clear();
+    EXPECT_EQ(moved.getScopeCount(), 0u);
+    moved.getOrCreateScope("tb.other").addBlockExclusion(BlockExclusion("1", "1"));
+    EXPECT_EQ(moved.getTotalExclusionCount(), 1u);
+}
+
 /**
  * @brief Test utility functions
  */
@@ -255,6 +331,93 @@ TEST_F(DataStructureTest, ExclusionDataManagerBasic) {
     EXPECT_TRUE(manager.isEmpty());
 }
 
+/**
+ * @brief Test hierarchical scope queries through the scope trie
+ */
+TEST_F(DataStructureTest, ScopeTrieQueries) {
+    // The trie references the names, so they must outlive it
+    const std::vector<std::string> names = {"tb.gpu0.chip0.dcio", "tb.gpu0.chip0.dcio.pwrseq", "tb.gpu0.chip1.dcio",
+                                            "tb.gpu0.chip0.dciox", "dcio_module"};
+    ScopeTrie trie;
+    EXPECT_TRUE(trie.insert(names[0]));
+    EXPECT_FALSE(trie.insert(names[0]));
+    for (size_t i = 1; i < names.size(); ++i) {
+        trie.insert(names[i]);
+    }
+    EXPECT_EQ(trie.size(), 5u);
+    
+    auto under = trie.findUnder("tb.gpu0.chip0.dcio");
+    std::sort(under.begin(), under.end());
+    EXPECT_EQ(under, (std::vector<std::string>{"tb.gpu0.chip0.dcio", "tb.gpu0.chip0.dcio.pwrseq"}));
+    EXPECT_EQ(trie.findUnder("").size(), 5u);
+    EXPECT_TRUE(trie.findUnder("tb.gpu0.chip2").empty());
+    
+    auto matched = trie.findMatching("tb.*.chip?.dcio");
+    std::sort(matched.begin(), matched.end());
+    EXPECT_EQ(matched, (std::vector<std::string>{"tb.gpu0.chip0.dcio", "tb.gpu0.chip1.dcio"}));
+    EXPECT_EQ(trie.findMatching("tb.**.dcio").size(), 2u);
+    EXPECT_EQ(trie.findMatching("**.pwrseq"), std::vector<std::string>{"tb.gpu0.chip0.dcio.pwrseq"});
+    EXPECT_EQ(trie.findMatching("**").size(), 5u);
+    
+    EXPECT_TRUE(trie.erase("tb.gpu0.chip0.dcio.pwrseq"));
+    EXPECT_FALSE(trie.erase("tb.gpu0.chip0.dcio.pwrseq"));
+    EXPECT_FALSE(trie.contains("tb.gpu0.chip0.dcio.pwrseq"));
+    EXPECT_TRUE(trie.contains("tb.gpu0.chip0.dcio"));
+    EXPECT_EQ(trie.findUnder("tb.gpu0.chip0.dcio").size(), 1u);
+    
+    // The data keeps its index current through getOrCreateScope, merge and append
+    data->getOrCreateScope("tb.gpu0.chip0.dcio").addBlockExclusion(BlockExclusion("1", "1"));
+    ExclusionData other;
+    other.getOrCreateScope("tb.gpu0.chip0.dcio.pwrseq").addBlockExclusion(BlockExclusion("2", "2"));
+    other.getOrCreateScope("tb.gpu1.chip0.dcio").addBlockExclusion(BlockExclusion("3", "3"));
+    data->merge(other);
+    ExclusionData appended;
+    appended.getOrCreateScope("tb.gpu0.chip0.dcio.rdpcs").addBlockExclusion(BlockExclusion("4", "4"));
+    data->append(std::move(appended));
+    EXPECT_TRUE(data->isScopeIndexCurrent());
+    
+    ExclusionDataManager manager;
+    manager.setData(data);
+    EXPECT_EQ(manager.findScopesUnder("tb.gpu0.chip0.dcio").size(), 3u);
+    EXPECT_EQ(manager.findScopesMatchingPath("tb.*.chip0.dcio").size(), 2u);
+    
+    SearchCriteria criteria;
+    criteria.scopePath = "tb.gpu0";
+    EXPECT_EQ(manager.search(criteria).size(), 3u);
+    
+    // Direct edits to the map fall back to scanning until the index is rebuilt
+    data->scopes["tb.gpu0.chip9"];
+    EXPECT_FALSE(data->isScopeIndexCurrent());
+    EXPECT_EQ(manager.findScopesUnder("tb.gpu0").size(), 4u);
+    data->rebuildScopeIndex();
+    EXPECT_EQ(data->getScopeIndex().findUnder("tb.gpu0").size(), 4u);
+    
+    // An erase plus an insert keeps the count but is still detected
+    data->scopes.erase("tb.gpu0.chip9");
+    data->scopes["tb.gpu7.chip0"];
+    EXPECT_FALSE(data->isScopeIndexCurrent());
+    EXPECT_EQ(manager.findScopesUnder("tb.gpu0").size(), 3u);
+    EXPECT_EQ(manager.findScopesMatchingPath("tb.*.chip9").size(), 0u);
+    data->rebuildScopeIndex();
+    
+    // eraseScope() keeps the index current
+    EXPECT_TRUE(data->eraseScope("tb.gpu7.chip0"));
+    EXPECT_FALSE(data->eraseScope("tb.gpu7.chip0"));
+    EXPECT_TRUE(data->isScopeIndexCurrent());
+    EXPECT_FALSE(data->getScopeIndex().contains("tb.gpu7.chip0"));
+    EXPECT_EQ(manager.findScopesUnder("tb").size(), data->scopes.size());
+    
+    // Copies and moves index their own keys
+    ExclusionData copy = *data;
+    ExclusionData moved = std::move(copy);
+    EXPECT_TRUE(moved.isScopeIndexCurrent());
+    EXPECT_EQ(moved.getScopeIndex().findUnder("tb.gpu0.chip0.dcio").size(), 3u);
+    EXPECT_TRUE(copy.scopes.empty());
+    
+    data->clear();
+    EXPECT_TRUE(data->getScopeIndex().empty());
+}
+
 /**
  * @brief Test PatternMatcher functionality
  */
@@ -275,4 +438,381 @@ TEST_F(DataStructureTest, PatternMatcher) {
     // Test pattern escaping
     std::string escaped = PatternMatcher::escape("test.*[abc]");
     EXPECT_TRUE(escaped.find("\\") != std::string::npos); // Should contain escape characters
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Test CompiledPattern matching, case folding and batch filtering
+ */
+TEST_F(DataStructureTest, CompiledPattern) {
+    CompiledPattern pattern("tb.*.chip?.dcio*");
+    EXPECT_TRUE(pattern.matches("tb.gpu0.chip0.dcio"));
+    EXPECT_TRUE(pattern.matches("tb.gpu0.core.chip1.dcio_wrapper"));
+    EXPECT_FALSE(pattern.matches("tb.gpu0.chip10.dcio"));
+    EXPECT_FALSE(pattern.matches("TB.gpu0.chip0.dcio"));
+    EXPECT_EQ(pattern.getLiteralPrefix(), "tb.");
+    EXPECT_FALSE(pattern.isLiteral());
+    
+    CompiledPattern folded("TB.*.DCIO", false);
+    EXPECT_TRUE(folded.matches("tb.gpu0.dcio"));
+    EXPECT_FALSE(folded.matches("tb.gpu0.dcio.x"));
+    EXPECT_EQ(folded.getLiteralPrefix(), "");
+    
+    // Stars may match nothing, and pieces must not overlap
+    EXPECT_TRUE(CompiledPattern("a*a").matches("aa"));
+    EXPECT_FALSE(CompiledPattern("a*a").matches("a"));
+    EXPECT_TRUE(CompiledPattern("**").matches(""));
+    EXPECT_TRUE(CompiledPattern("*ab*ab*").matches("xabyab"));
+    
+    // Escaped wildcards are literal
+    CompiledPattern escaped(PatternMatcher::escape("bus[*]"));
+    EXPECT_TRUE(escaped.isLiteral());
+    EXPECT_TRUE(escaped.matches("bus[*]"));
+    EXPECT_FALSE(escaped.matches("bus[0]"));
+    
+    std::vector<std::string> names = {"tb.a.x", "tb.b.y", "tb.a.z", "other"};
+    EXPECT_EQ(CompiledPattern("tb.a.*").filter(names), (std::vector<std::string>{"tb.a.x", "tb.a.z"}));
+    
+    // Manager queries and SearchCriteria use the same matcher
+    for (const auto& name : names) {
+        data->getOrCreateScope(name).addBlockExclusion(BlockExclusion("1", "1"));
+    }
+    ExclusionDataManager manager;
+    manager.setData(data);
+    EXPECT_EQ(manager.findScopesMatching("tb.*").size(), 3u);
+    EXPECT_EQ(manager.findScopesMatching("tb.a*").size(), 2u);
+    EXPECT_EQ(manager.findScopesMatching("oth?r").size(), 1u);
+    SearchCriteria criteria;
+    criteria.scopePattern = "*.?.z";
+    auto results = manager.search(criteria);
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].first, "tb.a.z");
+}
+
+/**
+ * @brief Test that indexed queries return exactly what a full scan returns
+ */
+TEST_F(DataStructureTest, IndexedSearchMatchesScan) {
+    for (int i = 0; i < 20; ++i) {
+        std::string suffix = std::to_string(i);
+        auto& scope = data->getOrCreateScope("tb.top.u" + suffix, "1", false);
+        scope.addBlockExclusion(BlockExclusion("b" + suffix, "1", "x = 1;", i % 3 ? "Unused logic" : "DFT related"));
+        scope.addToggleExclusion(ToggleExclusion(ToggleDirection::ZERO_TO_ONE, "data_bus", i % 4,
+                                                 "net data_bus[3:0]", i % 2 ? "tied off" : ""));
+        scope.toggleTable.add(ToggleExclusion(ToggleDirection::ONE_TO_ZERO, "clk_en", std::nullopt, "net clk_en", "Unused clock"));
+        scope.toggleTable.add(ToggleExclusion(ToggleDirection::ZERO_TO_ONE, "clk_en", std::nullopt, "net clk_en", "Unused clock"));
+        scope.addFsmExclusion(FsmExclusion(i % 2 ? "ctrl_state" : "dma_state", "1", "Unreachable"));
+        scope.addConditionExclusion(ConditionExclusion("c" + suffix, "1", "a && b", "", "", "unused branch"));
+        data->getOrCreateScope("mod" + suffix, "2", true)
+            .addBlockExclusion(BlockExclusion("m", "1", "y = 0;", "Unused in module"));
+    }
+    
+    ExclusionDataManager scan;
+    scan.setData(data);
+    ExclusionDataManager indexed;
+    indexed.setData(data);
+    indexed.setIndexingEnabled(true);
+    
+    std::vector<SearchCriteria> queries(8);
+    queries[0].type = ExclusionType::TOGGLE;
+    queries[0].signalName = "bus";
+    queries[0].bitIndex = 2;
+    queries[1].annotation = "Unused";
+    queries[2].annotation = "d logic";
+    queries[3].type = ExclusionType::FSM;
+    queries[3].fsmName = "ctrl";
+    queries[4].isModule = true;
+    queries[5].signalName = "clk";
+    queries[5].annotation = "clock";
+    queries[6].scopePattern = "tb.top.u1?";
+    queries[6].type = ExclusionType::CONDITION;
+    for (const auto& criteria : queries) {
+        EXPECT_EQ(indexed.search(criteria), scan.search(criteria));
+    }
+    EXPECT_EQ(indexed.search(queries[0]).size(), 5u);
+    
+    EXPECT_EQ(indexed.findByAnnotation("unused"), scan.findByAnnotation("unused"));
+    EXPECT_EQ(indexed.findByAnnotation("Unused", true), scan.findByAnnotation("Unused", true));
+    EXPECT_EQ(indexed.getAllSignalNames(), scan.getAllSignalNames());
+    EXPECT_EQ(indexed.getAllFsmNames(), scan.getAllFsmNames());
+    
+    // Edits through the manager drop the indexes
+    ExclusionData extra;
+    extra.getOrCreateScope("tb.top.u0").addBlockExclusion(BlockExclusion("new", "1", "z = 0;", "Unused late"));
+    indexed.mergeData(extra);
+    EXPECT_EQ(indexed.search(queries[1]), scan.search(queries[1]));
+    
+    // Edits through getOrCreateScope() change the generation, so the next query sees them
+    size_t before = indexed.search(queries[0]).size();
+    auto& edited = indexed.getData()->getOrCreateScope("tb.top.u0");
+    edited.addToggleExclusion(ToggleExclusion(ToggleDirection::BOTH, "bus", 2, "net bus[3:0]"));
+    edited.addBlockExclusion(BlockExclusion("edit", "1", "v = 0;", "Unused edit"));
+    EXPECT_EQ(indexed.search(queries[0]).size(), before + 1);
+    EXPECT_EQ(indexed.search(queries[0]), scan.search(queries[0]));
+    EXPECT_EQ(indexed.search(queries[1]), scan.search(queries[1]));
+    EXPECT_EQ(indexed.findByAnnotation("edit"), scan.findByAnnotation("edit"));
+    
+    // Reading the data does not drop the indexes
+    std::shared_ptr<ExclusionData> shared = indexed.getData();
+    uint64_t generation = shared->getGeneration();
+    EXPECT_EQ(indexed.search(queries[0]).size(), before + 1);
+    EXPECT_EQ(shared->getGeneration(), generation);
+    
+    // Edits through the scopes map are announced with markModified()
+    data->scopes["tb.top.u1"].addBlockExclusion(BlockExclusion("direct", "1", "w = 0;", "Unused direct"));
+    data->markModified();
+    EXPECT_NE(data->getGeneration(), generation);
+    EXPECT_EQ(indexed.search(queries[1]), scan.search(queries[1]));
+    
+    // Assigning equal-generation data still changes the generation
+    ExclusionData copy = *data;
+    generation = data->getGeneration();
+    copy.scopes["tb.top.u0"].blockExclusions.clear();
+    *data = copy;
+    EXPECT_NE(data->getGeneration(), generation);
+    EXPECT_EQ(indexed.search(queries[1]), scan.search(queries[1]));
+}
+
+/**
+ * @brief Test ExclusionLookup point queries across all exclusion types
+ */
+TEST_F(DataStructureTest, ExclusionLookupPointQueries) {
+    auto& scope = data->getOrCreateScope("tb.top.u0", "1", false);
+    scope.addBlockExclusion(BlockExclusion("b1", "1", "x = 1;"));
+    scope.addToggleExclusion(ToggleExclusion(ToggleDirection::ZERO_TO_ONE, "bus", 3, "net bus[7:0]"));
+    scope.toggleTable.add(ToggleExclusion(ToggleDirection::ONE_TO_ZERO, "bus", 3, "net bus[7:0]"));
+    scope.toggleTable.add(ToggleExclusion(ToggleDirection::BOTH, "en", std::nullopt, "net en"));
+    scope.addFsmExclusion(FsmExclusion("ctrl_state", "9"));
+    scope.addFsmExclusion(FsmExclusion("transition", "IDLE", "BUSY", "1"));
+    scope.addConditionExclusion(ConditionExclusion("c7", "1", "a && b", "", "1 \"01\""));
+    data->getOrCreateScope("mod", "2", true).addBlockExclusion(BlockExclusion("m1", "1", "y = 0;"));
+    
+    ExclusionLookup lookup(*data);
+    ScopeKey u0 = ExclusionLookup::scopeKey("tb.top.u0");
+    ScopeKey mod = ExclusionLookup::scopeKey("mod");
+    
+    EXPECT_TRUE(lookup.contains(ExclusionLookup::blockKey(u0, "b1")));
+    EXPECT_TRUE(lookup.contains(ExclusionLookup::blockKey(mod, "m1")));
+    EXPECT_FALSE(lookup.contains(ExclusionLookup::blockKey(u0, "m1")));
+    EXPECT_FALSE(lookup.contains(ExclusionLookup::blockKey(ExclusionLookup::scopeKey("tb.top"), "b1")));
+    
+    // Directions from the map and the table combine; BOTH needs both
+    EXPECT_TRUE(lookup.contains(ExclusionLookup::toggleKey(u0, "bus", 3, ToggleDirection::ZERO_TO_ONE)));
+    EXPECT_TRUE(lookup.contains(ExclusionLookup::toggleKey(u0, "bus", 3, ToggleDirection::BOTH)));
+    EXPECT_FALSE(lookup.contains(ExclusionLookup::toggleKey(u0, "bus", 2, ToggleDirection::ZERO_TO_ONE)));
+    EXPECT_FALSE(lookup.contains(ExclusionLookup::toggleKey(u0, "bus", std::nullopt, ToggleDirection::ZERO_TO_ONE)));
+    EXPECT_TRUE(lookup.contains(ExclusionLookup::toggleKey(u0, "en", std::nullopt, ToggleDirection::ONE_TO_ZERO)));
+    EXPECT_TRUE(lookup.contains(ExclusionLookup::toggleKey(u0, "en", std::nullopt, ToggleDirection::BOTH)));
+    
+    EXPECT_TRUE(lookup.contains(ExclusionLookup::fsmStateKey(u0, "ctrl_state")));
+    EXPECT_TRUE(lookup.contains(ExclusionLookup::fsmTransitionKey(u0, "IDLE", "BUSY")));
+    EXPECT_FALSE(lookup.contains(ExclusionLookup::fsmTransitionKey(u0, "BUSY", "IDLE")));
+    EXPECT_FALSE(lookup.contains(ExclusionLookup::blockKey(u0, "ctrl_state")));
+    
+    EXPECT_TRUE(lookup.contains(ExclusionLookup::conditionKey(u0, "c7")));
+    EXPECT_TRUE(lookup.contains(ExclusionLookup::conditionKey(u0, "c7", "1 \"01\"")));
+    EXPECT_FALSE(lookup.contains(ExclusionLookup::conditionKey(u0, "c7", "1 \"10\"")));
+    
+    std::vector<LookupKey> keys = {
+        ExclusionLookup::blockKey(u0, "b1"),
+        ExclusionLookup::blockKey(u0, "b2"),
+        ExclusionLookup::fsmStateKey(u0, "ctrl_state")
+    };
+    bool results[3] = {};
+    EXPECT_EQ(lookup.containsBatch(keys, results), 2u);
+    EXPECT_TRUE(results[0]);
+    EXPECT_FALSE(results[1]);
+    EXPECT_TRUE(results[2]);
+    
+    ExclusionLookup empty;
+    EXPECT_EQ(empty.size(), 0u);
+    EXPECT_FALSE(empty.contains(ExclusionLookup::blockKey(u0, "b1")));
+}
+
+/**
+ * @brief Test the ExclusionLookup negative filter (no false negatives, misses rejected early)
+ */
+TEST_F(DataStructureTest, ExclusionLookupFilter) {
+    auto& scope = data->getOrCreateScope("tb.top.u0", "1", false);
+    for (int i = 0; i < 1000; ++i) {
+        scope.addBlockExclusion(BlockExclusion("b" + std::to_string(i), "1", "x = 1;"));
+    }
+    ExclusionLookup lookup(*data);
+    lookup.buildFilter(0.01);
+    ASSERT_TRUE(lookup.hasFilter());
+    
+    ScopeKey u0 = ExclusionLookup::scopeKey("tb.top.u0");
+    std::vector<LookupKey> keys;
+    for (int i = 0; i < 20000; ++i) {
+        keys.push_back(ExclusionLookup::blockKey(u0, "b" + std::to_string(i)));
+    }
+    
+    // No false negatives, and the filter answers most misses by itself
+    size_t hits = 0;
+    for (const auto& key : keys) {
+        hits += lookup.contains(key);
+    }
+    EXPECT_EQ(hits, 1000u);
+    EXPECT_EQ(lookup.getFilterStatistics().filterHits, 0u);
+    
+    // Counters are opt-in
+    lookup.setFilterCounting(true);
+    hits = 0;
+    for (const auto& key : keys) {
+        hits += lookup.contains(key);
+    }
+    EXPECT_EQ(hits, 1000u);
+    FilterStatistics stats = lookup.getFilterStatistics();
+    EXPECT_TRUE(stats.counting);
+    EXPECT_EQ(stats.filterMisses + stats.filterHits, keys.size());
+    EXPECT_EQ(stats.filterHits - stats.falsePositives, 1000u);
+    EXPECT_LT(stats.falsePositives, 19000u * 3 / 100);
+    EXPECT_GT(stats.memoryBytes, 0u);
+    
+    std::unique_ptr<bool[]> results(new bool[keys.size()]);
+    lookup.resetFilterStatistics();
+    EXPECT_EQ(lookup.containsBatch(keys, std::span<bool>(results.get(), keys.size())), 1000u);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(results[i], i < 1000);
+    }
+    EXPECT_EQ(lookup.getFilterStatistics().falsePositives, stats.falsePositives);
+    
+    lookup.dropFilter();
+    EXPECT_FALSE(lookup.hasFilter());
+    EXPECT_TRUE(lookup.contains(keys[999]));
+    EXPECT_EQ(lookup.getFilterStatistics().filterHits, 0u);
+}
+
+/**
+ * @brief Test freezing ExclusionData into a flat snapshot and replaying it
+ */
+TEST_F(DataStructureTest, FrozenSnapshot) {
+    auto& scope = data->getOrCreateScope("tb.top.u0", "77", false);
+    scope.addBlockExclusion(BlockExclusion("20", "1", "x = 1;", "Unused logic"));
+    scope.addBlockExclusion(BlockExclusion("10", "2", "y = 0;"));
+    scope.addToggleExclusion(ToggleExclusion(ToggleDirection::ZERO_TO_ONE, "bus", 3, "net bus[7:0]", "Unused logic"));
+    scope.toggleTable.add(ToggleExclusion(ToggleDirection::BOTH, "bus", 1, "net bus[7:0]"));
+    scope.toggleTable.add(ToggleExclusion(ToggleDirection::ONE_TO_ZERO, "en", std::nullopt, "net en"));
+    scope.addFsmExclusion(FsmExclusion("ctrl_state", "9"));
+    scope.addFsmExclusion(FsmExclusion("transition", "IDLE", "BUSY", "1"));
+    scope.addConditionExclusion(ConditionExclusion("c7", "1", "a && b", "1 -1", "1 \"01\"", "tied"));
+    data->getOrCreateScope("mod", "2", true).addBlockExclusion(BlockExclusion("m1", "1", "y = 0;"));
+    
+    FrozenExclusionData frozen = data->freeze();
+    EXPECT_EQ(frozen.fileName, "test.el");
+    EXPECT_EQ(frozen.getScopeCount(), 2u);
+    EXPECT_EQ(frozen.getTotalExclusionCount(), data->getTotalExclusionCount());
+    EXPECT_EQ(frozen.getExclusionCountsByType(), data->getExclusionCountsByType());
+    EXPECT_EQ(frozen.findScope("tb.top"), nullptr);
+    
+    // Scopes are sorted by name; exclusions by key within a scope
+    ASSERT_EQ(frozen.scopes().size(), 2u);
+    EXPECT_EQ(frozen.text(frozen.scopes()[0].name), "mod");
+    const auto* u0 = frozen.findScope("tb.top.u0");
+    ASSERT_NE(u0, nullptr);
+    EXPECT_FALSE(u0->isModule);
+    EXPECT_EQ(frozen.text(u0->checksum), "77");
+    ASSERT_EQ(frozen.blocks(*u0).size(), 2u);
+    EXPECT_EQ(frozen.text(frozen.blocks(*u0)[0].blockId), "10");
+    
+    const auto* block = frozen.findBlock(*u0, "20");
+    ASSERT_NE(block, nullptr);
+    EXPECT_EQ(frozen.text(block->sourceCode), "x = 1;");
+    EXPECT_EQ(frozen.text(block->annotation), "Unused logic");
+    EXPECT_EQ(frozen.findBlock(*u0, "m1"), nullptr);
+    
+    // Both toggle stores, one record per direction, sorted by bit
+    auto bus = frozen.findToggles(*u0, "bus");
+    ASSERT_EQ(bus.size(), 2u);
+    EXPECT_EQ(bus[0].bitIndex(), 1);
+    EXPECT_EQ(bus[0].direction, ToggleDirection::BOTH);
+    EXPECT_EQ(bus[1].bitIndex(), 3);
+    EXPECT_EQ(frozen.text(bus[1].annotation), "Unused logic");
+    auto en = frozen.findToggles(*u0, "en");
+    ASSERT_EQ(en.size(), 1u);
+    EXPECT_EQ(en[0].bitIndex(), std::nullopt);
+    EXPECT_TRUE(frozen.findToggles(*u0, "clk").empty());
+    
+    auto transitions = frozen.findFsms(*u0, "transition");
+    ASSERT_EQ(transitions.size(), 1u);
+    EXPECT_TRUE(transitions[0].isTransition);
+    EXPECT_EQ(frozen.text(transitions[0].toState), "BUSY");
+    EXPECT_EQ(frozen.findFsms(*u0, "ctrl_state").size(), 1u);
+    
+    const auto* condition = frozen.findCondition(*u0, "c7");
+    ASSERT_NE(condition, nullptr);
+    EXPECT_EQ(frozen.text(condition->coverage), "1 \"01\"");
+    EXPECT_EQ(frozen.text(condition->parameters), "1 -1");
+    
+    // Same statistics as the manager reports for the live data
+    ExclusionDataManager manager;
+    manager.setData(data);
+    ExclusionStatistics live = manager.getStatistics();
+    ExclusionStatistics stats = frozen.getStatistics();
+    EXPECT_EQ(stats.totalScopes, live.totalScopes);
+    EXPECT_EQ(stats.moduleScopes, live.moduleScopes);
+    EXPECT_EQ(stats.totalExclusions, live.totalExclusions);
+    EXPECT_EQ(stats.annotatedExclusions, live.annotatedExclusions);
+    EXPECT_EQ(stats.exclusionsByType, live.exclusionsByType);
+    EXPECT_EQ(stats.exclusionsByScope, live.exclusionsByScope);
+    
+    // Repeated text is stored once; copies stay valid on their own
+    EXPECT_EQ(frozen.text(bus[1].annotation).data(), frozen.text(block->annotation).data());
+    
+    // Replaying the snapshot into a builder rebuilds the same data
+    ExclusionData rebuilt("test.el");
+    ExclusionDataBuilder builder(rebuilt);
+    frozen.accept(builder);
+    EXPECT_EQ(rebuilt.getExclusionCountsByType(), data->getExclusionCountsByType());
+    auto describe = [](const FrozenExclusionData& snapshot) {
+        std::string text;
+        for (const auto& scope : snapshot.scopes()) {
+            text += std::string(snapshot.text(scope.name)) + ":" + std::string(snapshot.text(scope.checksum)) + "\n";
+            for (const auto& block : snapshot.blocks(scope)) {
+                text += std::string(snapshot.text(block.blockId)) + "|" + std::string(snapshot.text(block.annotation)) + "\n";
+            }
+            for (const auto& toggle : snapshot.toggles(scope)) {
+                text += std::string(snapshot.text(toggle.signalName)) + "|" + std::to_string(toggle.bit) + "|" +
+                        std::to_string(static_cast<int>(toggle.direction)) + "\n";
+            }
+            for (const auto& fsm : snapshot.fsms(scope)) {
+                text += std::string(snapshot.text(fsm.fsmName)) + "|" + std::string(snapshot.text(fsm.toState)) + "\n";
+            }
+            for (const auto& condition : snapshot.conditions(scope)) {
+                text += std::string(snapshot.text(condition.conditionId)) + "|" +
+                        std::string(snapshot.text(condition.coverage)) + "\n";
+            }
+        }
+        return text;
+    };
+    FrozenExclusionData refrozen = rebuilt.freeze();
+    EXPECT_EQ(describe(refrozen), describe(frozen));
+    
+    // A signal's toggles are replayed in stored order, not bit order
+    auto toggleOrder = [](const ExclusionScope& source) {
+        std::vector<std::optional<int>> bits;
+        source.forEachToggle([&bits](const ToggleExclusion& toggle) {
+            if (toggle.signalName == "bus") {
+                bits.push_back(toggle.bitIndex);
+            }
+        });
+        return bits;
+    };
+    EXPECT_EQ(toggleOrder(rebuilt.scopes.at("tb.top.u0")), toggleOrder(scope));
+    EXPECT_EQ(refrozen.generationDate, frozen.generationDate);
+    
+    FrozenExclusionData copy = frozen;
+    frozen = FrozenExclusionData();
+    EXPECT_EQ(frozen.findScope("mod"), nullptr);
+    ASSERT_NE(copy.findScope("mod"), nullptr);
+    EXPECT_NE(copy.findBlock(*copy.findScope("mod"), "m1"), nullptr);
+}
+
+/**
+ * @brief Test that the .elb index hash is fixed (images are portable across toolchains)
+ */
+TEST_F(DataStructureTest, FrozenIndexHashIsPinned) {
+    // These values are part of the .elb format; changing them needs a FORMAT_VERSION bump
+    EXPECT_EQ(FrozenExclusionData::hashKey("tb.top.u0"), 0xcc04fc59c5de8693ULL);
+    EXPECT_EQ(FrozenExclusionData::hashKey("161", 1), 0x818ce4a5dda7f060ULL);
+    EXPECT_EQ(FrozenExclusionData::hashKey(""), 0x50e50300b6982489ULL);
+}
@@ -12,6 +12,11 @@
 
 #include <gtest/gtest.h>
 #include "ExclusionParser.h"
+#include "ExclusionTokenizer.h"
+#include "ExclusionVisitor.h"
+#include "ExclusionWriter.h"
+#include <filesystem>
+#include <fstream>
 #include <sstream>
 
 using namespace ExclusionParser;
@@ -22,7 +27,7 @@ using namespace ExclusionParser;
 class ParserTest : public ::testing::Test {
 protected:
     void SetUp() override {
-        parser = std::make_unique<ExclusionParser>();
+        parser = std::make_unique<ExclusionParser::ExclusionParser>();
         
         // Sample exclusion file content for testing
         sampleContent = R"(//==================================================
@@ -52,7 +57,7 @@ Condition 2 "2940925445" "(signal_a && signal_b) 1 -1" (1 "01")
         parser.reset();
     }
     
-    std::unique_ptr<ExclusionParser> parser;
+    std::unique_ptr<ExclusionParser::ExclusionParser> parser;
     std::string sampleContent;
 };
 
@@ -183,6 +188,115 @@ Toggle signal_simple "net signal_simple"
     EXPECT_EQ(arrayToggles[0].bitIndex.value(), 16);
 }
 
+/**
+ * @brief Test toggle lines with attached bit indices and part-selects
+ */
+TEST_F(ParserTest, ParseToggleBitSelects) {
+    std::string toggleContent = R"(
+CHECKSUM: "123456"
+INSTANCE: test.instance
+Toggle 0to1 bus_data[7] "net bus_data[15:0]"
+Toggle hdr [37:34] "net hdr[63:0]"
+Toggle   spaced_signal   [3]   "net spaced_signal[3:0]"   
+)";
+    
+    auto result = parser->parseString(toggleContent, "toggle_bits");
+    
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.exclusionCounts[ExclusionType::TOGGLE], 3);
+    
+    auto& scope = parser->getData()->scopes["test.instance"];
+    
+    ASSERT_EQ(scope.toggleExclusions["bus_data"].size(), 1);
+    EXPECT_EQ(scope.toggleExclusions["bus_data"][0].bitIndex.value_or(-1), 7);
+    EXPECT_EQ(scope.toggleExclusions["bus_data"][0].direction, ToggleDirection::ZERO_TO_ONE);
+    
+    // Part-selects are kept with the signal name so they are written back unchanged
+    ASSERT_EQ(scope.toggleExclusions["hdr [37:34]"].size(), 1);
+    EXPECT_FALSE(scope.toggleExclusions["hdr [37:34]"][0].bitIndex.has_value());
+    
+    ASSERT_EQ(scope.toggleExclusions["spaced_signal"].size(), 1);
+    EXPECT_EQ(scope.toggleExclusions["spaced_signal"][0].bitIndex.value_or(-1), 3);
+    EXPECT_EQ(scope.toggleExclusions["spaced_signal"][0].netDescription, "net spaced_signal[3:0]");
+}
+
+/**
+ * @brief Test memory-mapped and buffered file input modes
+ */
+TEST_F(ParserTest, ParseFileInputModes) {
+    std::string tempFilename = "temp_input_mode.el";
+    std::ofstream tempFile(tempFilename);
+    tempFile << sampleContent;
+    tempFile.close();
+    
+    auto mapped = parser->parseFile(tempFilename);
+    EXPECT_TRUE(mapped.success);
+    EXPECT_EQ(mapped.inputMode, InputMode::MEMORY_MAPPED);
+    size_t mappedExclusions = mapped.exclusionsParsed;
+    
+    // maxFileSize limits only the heap-buffered path
+    ParserConfig config;
+    config.maxFileSize = 16;
+    parser->setConfig(config);
+    auto largeMapped = parser->parseFile(tempFilename);
+    EXPECT_TRUE(largeMapped.success);
+    EXPECT_EQ(largeMapped.exclusionsParsed, mappedExclusions);
+    
+    config.useMemoryMap = false;
+    parser->setConfig(config);
+    auto tooLarge = parser->parseFile(tempFilename);
+    EXPECT_FALSE(tooLarge.success);
+    EXPECT_NE(tooLarge.errorMessage.find("File too large"), std::string::npos);
+    
+    config.maxFileSize = 1024 * 1024;
+    parser->setConfig(config);
+    auto buffered = parser->parseFile(tempFilename);
+    EXPECT_TRUE(buffered.success);
+    EXPECT_EQ(buffered.inputMode, InputMode::BUFFERED);
+    EXPECT_EQ(buffered.exclusionsParsed, mappedExclusions);
+    
+    FileUtils::MappedFile file(tempFilename);
+    EXPECT_TRUE(file.isOpen());
+    EXPECT_EQ(file.view(), sampleContent);
+    FileUtils::MappedFile moved(std::move(file));
+    EXPECT_FALSE(file.isOpen());
+    EXPECT_EQ(moved.view(), sampleContent);
+    EXPECT_EQ(FileUtils::readFile(tempFilename), sampleContent);
+    
+    std::remove(tempFilename.c_str());
+}
+
+/**
+ * @brief Test single-step line classification
+ */
+TEST_F(ParserTest, ClassifyLine) {
+    using Tokenizer::LineKind;
+    using Tokenizer::classifyLine;
+    
+    EXPECT_EQ(classifyLine(""), LineKind::EMPTY);
+    EXPECT_EQ(classifyLine("// Date: Mon Jan 01 00:00:00 2025"), LineKind::COMMENT);
+    EXPECT_EQ(classifyLine("=================================================="), LineKind::COMMENT);
+    EXPECT_EQ(classifyLine("CHECKSUM: \"1\""), LineKind::CHECKSUM);
+    EXPECT_EQ(classifyLine("INSTANCE: tb.top"), LineKind::INSTANCE);
+    EXPECT_EQ(classifyLine("MODULE: top"), LineKind::MODULE);
+    EXPECT_EQ(classifyLine("ANNOTATION: \"x\""), LineKind::ANNOTATION);
+    EXPECT_EQ(classifyLine("ANNOTATION_BEGIN: \"x\""), LineKind::ANNOTATION_BEGIN);
+    EXPECT_EQ(classifyLine("ANNOTATION_END"), LineKind::ANNOTATION_END);
+    EXPECT_EQ(classifyLine("Block 1 \"2\" \"a;\""), LineKind::BLOCK);
+    EXPECT_EQ(classifyLine("Toggle sig \"net sig\""), LineKind::TOGGLE);
+    EXPECT_EQ(classifyLine("Transition A->B \"0->1\""), LineKind::TRANSITION);
+    EXPECT_EQ(classifyLine("Fsm state \"1\""), LineKind::FSM);
+    EXPECT_EQ(classifyLine("Condition 2 \"1\" \"a 1 -1\" (1 \"01\")"), LineKind::CONDITION);
+    EXPECT_EQ(classifyLine("Togglefoo"), LineKind::UNKNOWN);
+    EXPECT_EQ(classifyLine("/ not a comment"), LineKind::UNKNOWN);
+    
+    // Header keywords outside comments are no longer treated as header lines
+    std::string content = "CHECKSUM: \"1\"\nINSTANCE: tb.top\nToggle Date: \"net Date:\"\n";
+    auto result = parser->parseString(content, "classify");
+    EXPECT_EQ(result.exclusionCounts[ExclusionType::TOGGLE], 1);
+    EXPECT_TRUE(parser->getData()->generationDate.empty());
+}
+
 /**
  * @brief Test parsing FSM exclusions specifically
  */
@@ -318,6 +432,200 @@ TEST_F(ParserTest, ParseFromStream) {
     EXPECT_TRUE(parser->hasData());
 }
 
+/**
+ * @brief Test event-driven parsing through a visitor
+ */
+TEST_F(ParserTest, VisitorEvents) {
+    struct RecordingVisitor : ExclusionVisitor {
+        std::vector<std::string> events;
+
+        void onHeader(HeaderField, std::string_view value) override {
+            events.push_back("header " + std::string(value));
+        }
+        void onScope(const ScopeView& scope) override {
+            events.push_back((scope.isModule ? "module " : "instance ") + std::string(scope.name));
+        }
+        void onBlock(const BlockView& block) override {
+            events.push_back("block " + std::string(block.blockId) + " " + std::string(block.annotation));
+        }
+        void onToggle(const ToggleView& toggle) override {
+            events.push_back("toggle " + std::string(toggle.signalName) + " " +
+                             std::string(toggle.scope.checksum));
+        }
+        void onFsm(const FsmView& fsm) override {
+            events.push_back("fsm " + std::string(fsm.fsmName));
+        }
+        void onTransition(const TransitionView& transition) override {
+            events.push_back("transition " + std::string(transition.fromState) + "->" +
+                             std::string(transition.toState) + " " + std::string(transition.annotation));
+        }
+        void onCondition(const ConditionView& condition) override {
+            events.push_back("condition " + std::string(condition.scope.name));
+        }
+    };
+
+    std::vector<std::string> expected = {
+        "header test_user", "header 2", "header Mon Jan 01 00:00:00 2025", "header test",
+        "instance tb.test.module.instance",
+        "block 161 Test block exclusion",
+        "toggle test_signal 123456789",
+        "toggle test_vector 123456789",
+        "module test_module",
+        "fsm test_state",
+        "transition IDLE->ACTIVE Test transition",
+        "condition test_module"
+    };
+
+    RecordingVisitor fromString;
+    auto result = parser->parseString(sampleContent, fromString, "visitor_string");
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.exclusionsParsed, 6);
+    EXPECT_EQ(fromString.events, expected);
+
+    // No data is built by the visitor overloads
+    EXPECT_FALSE(parser->hasData());
+
+    // The line-by-line stream path reports the same events
+    RecordingVisitor fromStream;
+    std::istringstream stream(sampleContent);
+    result = parser->parseStream(stream, fromStream, "visitor_stream");
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.inputMode, InputMode::STREAM);
+    EXPECT_EQ(fromStream.events, expected);
+
+    // ExclusionDataBuilder is the visitor behind the data-building methods
+    ExclusionData built;
+    ExclusionDataBuilder builder(built);
+    parser->parseString(sampleContent, builder, "builder");
+    parser->parseString(sampleContent, "data");
+    EXPECT_EQ(built.getTotalExclusionCount(), 6);
+    EXPECT_EQ(built.scopes, parser->getData()->scopes);
+    EXPECT_EQ(built.generatedBy, "test_user");
+}
+
+/**
+ * @brief Test that cached scopes survive rehashing of the scope map
+ */
+TEST_F(ParserTest, ScopeCacheAcrossRehash) {
+    ExclusionData data;
+    ExclusionDataBuilder builder(data);
+    
+    auto recordsFor = [](int firstBit, int lastBit) {
+        std::string content = "CHECKSUM: \"1\"\nINSTANCE: tb.top.first\n";
+        for (int bit = firstBit; bit < lastBit; ++bit) {
+            content += "Toggle first_sig [" + std::to_string(bit) + "] \"net first_sig[199:0]\"\n";
+        }
+        return content;
+    };
+    
+    // The builder caches tb.top.first (and its first_sig list) after this parse
+    ASSERT_TRUE(parser->parseString(recordsFor(0, 100), builder).success);
+    
+    // New scopes added behind the builder's back force the map to rehash
+    size_t buckets = data.scopes.bucket_count();
+    for (int i = 0; i < 1000; ++i) {
+        data.getOrCreateScope("tb.top.scope" + std::to_string(i), "1", false);
+    }
+    ASSERT_NE(data.scopes.bucket_count(), buckets);
+    
+    // These records reach tb.top.first through the cached pointers
+    ASSERT_TRUE(parser->parseString(recordsFor(100, 200), builder).success);
+    
+    EXPECT_EQ(data.getScopeCount(), 1001);
+    const auto& toggles = data.scopes["tb.top.first"].toggleExclusions["first_sig"];
+    ASSERT_EQ(toggles.size(), 200);
+    for (int bit = 0; bit < 200; ++bit) {
+        EXPECT_EQ(toggles[bit].bitIndex.value_or(-1), bit);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(data.scopes["tb.top.scope" + std::to_string(i)].getTotalExclusionCount(), 0);
+    }
+}
+
+/**
+ * @brief Test that the data manager's search indexes follow later parses into the same data
+ */
+TEST_F(ParserTest, IndexedSearchFollowsParsing) {
+    parser->getDataManager().setIndexingEnabled(true);
+    
+    ASSERT_TRUE(parser->parseString("CHECKSUM: \"1\"\nINSTANCE: tb.a\nBlock 1 \"0\" \"x = 0;\"\n").success);
+    SearchCriteria blocks;
+    blocks.type = ExclusionType::BLOCK;
+    EXPECT_EQ(parser->getDataManager().search(blocks).size(), 1u);
+    
+    // New records in an existing scope leave the scope count unchanged
+    ASSERT_TRUE(parser->parseString("CHECKSUM: \"1\"\nINSTANCE: tb.a\nBlock 2 \"0\" \"y = 0;\"\n"
+                                    "Block 3 \"0\" \"z = 0;\"\n").success);
+    EXPECT_EQ(parser->getData()->scopes.size(), 1u);
+    EXPECT_EQ(parser->getDataManager().search(blocks).size(), 3u);
+}
+
+/**
+ * @brief Test columnar toggle storage: pair folding and round-trip output
+ */
+TEST_F(ParserTest, ColumnarToggles) {
+    std::string content = R"(CHECKSUM: "1"
+INSTANCE: tb.top
+Toggle 1to0 clk "net clk"
+Toggle 0to1 clk "net clk"
+Toggle 0to1 bus [0] "net bus[1:0]"
+Toggle 1to0 bus [0] "net bus[1:0]"
+Toggle 1to0 bus [1] "net bus[1:0]"
+ANNOTATION: "only rising"
+Toggle 0to1 bus [1] "net bus[1:0]"
+Toggle rst "net rst"
+Toggle 1to0 addr [3:0] "net addr"
+)";
+
+    auto result = parser->parseString(content, "rows");
+    ASSERT_TRUE(result.success);
+    ExclusionData expected = *parser->getData();
+
+    ExclusionParser::ExclusionParser columnarParser;
+    ParserConfig config;
+    config.columnarToggles = true;
+    columnarParser.setConfig(config);
+    auto columnar = columnarParser.parseString(content, "rows");
+    ASSERT_TRUE(columnar.success);
+    EXPECT_EQ(columnar.exclusionsParsed, result.exclusionsParsed);
+
+    auto data = columnarParser.getData();
+    const auto& scope = data->scopes.at("tb.top");
+    EXPECT_TRUE(scope.toggleExclusions.empty());
+    EXPECT_EQ(scope.getTotalExclusionCount(), 8u);
+    EXPECT_EQ(data->getExclusionCountsByType()[ExclusionType::TOGGLE], 8u);
+
+    // Pairs fold; differing annotations, BOTH and a lone half stay separate rows
+    const ToggleTable& table = scope.toggleTable;
+    ASSERT_EQ(table.getRowCount(), 6u);
+    EXPECT_EQ(table.directionMask(0), ToggleTable::ZERO_TO_ONE_BIT | ToggleTable::ONE_TO_ZERO_BIT);
+    EXPECT_EQ(table.directionMask(1),
+              ToggleTable::ZERO_TO_ONE_BIT | ToggleTable::ONE_TO_ZERO_BIT | ToggleTable::ZERO_TO_ONE_FIRST);
+    EXPECT_EQ(table.bitIndex(1).value_or(-1), 0);
+    EXPECT_EQ(table.annotation(3), "only rising");
+    EXPECT_EQ(table.directionMask(4), ToggleTable::BOTH_BIT);
+    EXPECT_EQ(table.directionMask(5), ToggleTable::ONE_TO_ZERO_BIT);
+    EXPECT_EQ(table.signalName(5), "addr [3:0]");
+
+    // The writer expands rows back into the original lines (sorted, since the
+    // unsorted order of toggleExclusions is hash order)
+    ExclusionWriter writer;
+    WriterConfig writerConfig;
+    writerConfig.sortExclusions = true;
+    writer.setConfig(writerConfig);
+    EXPECT_EQ(writer.writeToString(*data), writer.writeToString(expected));
+
+    // Converting between the two stores reproduces the other parse
+    ExclusionData expanded = *data;
+    expanded.scopes.at("tb.top").expandToggleTable();
+    EXPECT_TRUE(expanded.scopes.at("tb.top") == expected.scopes.at("tb.top"));
+
+    ExclusionData compacted = expected;
+    compacted.scopes.at("tb.top").compactToggleExclusions();
+    EXPECT_EQ(compacted.scopes.at("tb.top").toggleTable.getExclusionCount(), 8u);
+    EXPECT_EQ(writer.writeToString(compacted), writer.writeToString(expected));
+}
+
 /**
  * @brief Test multi-line annotations
  */
@@ -327,15 +635,17 @@ CHECKSUM: "123456"
 INSTANCE: test.instance
 ANNOTATION_BEGIN: "This is a multi-line annotation"
 Block 1 "123" "test_code = 1'b0;"
+Block 3 "789" "run_code = 1'b0;"
 ANNOTATION_END
 ANNOTATION: "Single line annotation"
 Block 2 "456" "another_code = 1'b1;"
+Block 4 "321" "plain_code = 1'b1;"
 )";
     
     auto result = parser->parseString(multilineContent, "multiline_test");
     
     EXPECT_TRUE(result.success);
-    EXPECT_EQ(result.exclusionCounts[ExclusionType::BLOCK], 2);
+    EXPECT_EQ(result.exclusionCounts[ExclusionType::BLOCK], 4);
     
     auto data = parser->getData();
     auto& scope = data->scopes["test.instance"];
@@ -343,8 +653,15 @@ Block 2 "456" "another_code = 1'b1;"
     auto& block1 = scope.blockExclusions["1"];
     EXPECT_EQ(block1.annotation, "This is a multi-line annotation");
     
+    // A run annotates every exclusion up to ANNOTATION_END
+    auto& block3 = scope.blockExclusions["3"];
+    EXPECT_EQ(block3.annotation, "This is a multi-line annotation");
+    
     auto& block2 = scope.blockExclusions["2"];
     EXPECT_EQ(block2.annotation, "Single line annotation");
+    
+    auto& block4 = scope.blockExclusions["4"];
+    EXPECT_EQ(block4.annotation, "");
 }
 
 /**
@@ -443,4 +760,243 @@ Block 999 "888777" "additional_code = 1'b0;"
     // Verify the new scope exists
     EXPECT_TRUE(parser->getData()->scopes.find("tb.test.additional.instance") != 
                 parser->getData()->scopes.end());
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Test that parallel parseFiles produces the same data as the serial path
+ */
+TEST_F(ParserTest, ParallelParseFilesDeterministic) {
+    std::vector<std::string> contents = {
+        sampleContent,
+        R"(CHECKSUM: "111"
+INSTANCE: tb.test.module.instance
+ANNOTATION: "Second file"
+Block 161 "222" "overridden = 1'b1;"
+Toggle 1to0 test_signal "net test_signal"
+CHECKSUM: "333"
+INSTANCE: tb.other
+Toggle other_bus [2] "net other_bus[3:0]"
+)",
+        R"(CHECKSUM: "444"
+MODULE: test_module
+Fsm test_state "85815111"
+Bogus line
+)"
+    };
+    
+    std::vector<std::string> filenames;
+    for (size_t i = 0; i < contents.size(); ++i) {
+        filenames.push_back("temp_parallel_" + std::to_string(i) + ".el");
+        std::ofstream file(filenames.back());
+        file << contents[i];
+    }
+    
+    ExclusionWriter writer;
+    WriterConfig sortedConfig;
+    sortedConfig.sortExclusions = true;
+    ExclusionWriter sortedWriter;
+    sortedWriter.setConfig(sortedConfig);
+    
+    // Reference: parse the files one after another into the same data
+    ParserConfig sequentialConfig;
+    sequentialConfig.mergeOnLoad = true;
+    parser->setConfig(sequentialConfig);
+    for (const auto& filename : filenames) {
+        ASSERT_TRUE(parser->parseFile(filename).success);
+    }
+    std::string sequential = sortedWriter.writeToString(*parser->getData());
+    std::string serial;
+    
+    for (size_t threads : {size_t(1), size_t(4)}) {
+        ExclusionParser::ExclusionParser batchParser;
+        ParserConfig config;
+        config.threadCount = threads;
+        batchParser.setConfig(config);
+        
+        auto result = batchParser.parseFiles(filenames);
+        EXPECT_TRUE(result.success);
+        EXPECT_EQ(sortedWriter.writeToString(*batchParser.getData()), sequential) << threads << " threads";
+        
+        // Unsorted output exposes container order: parallel must match serial byte for byte
+        std::string output = writer.writeToString(*batchParser.getData());
+        if (threads == 1) {
+            serial = output;
+        } else {
+            EXPECT_EQ(output, serial);
+        }
+        
+        ASSERT_EQ(result.fileWarnings.size(), filenames.size());
+        EXPECT_EQ(result.fileWarnings[0].first, filenames[0]);
+        EXPECT_TRUE(result.fileWarnings[0].second.empty());
+        EXPECT_EQ(result.fileWarnings[2].second.size(), 1);
+        EXPECT_EQ(result.warnings.size(), 1);
+        EXPECT_EQ(batchParser.getData()->scopes["tb.test.module.instance"].blockExclusions["161"].sourceCode,
+                  "overridden = 1'b1;");
+    }
+    
+    for (const auto& filename : filenames) {
+        std::remove(filename.c_str());
+    }
+}
+
+/**
+ * @brief Test that split-file parsing yields the same data as a single serial parse
+ */
+TEST_F(ParserTest, SplitLargeFilesMatchesSerial) {
+    std::ostringstream content;
+    content << "// Generated By User: split_test\n";
+    for (int i = 0; i < 40; ++i) {
+        if (i % 7 == 3) {
+            // Annotation pending across a record boundary: not a safe split point
+            content << "ANNOTATION: \"carried " << i << "\"\n";
+        }
+        content << "CHECKSUM: \"" << 1000 + i << "\"\n";
+        content << (i % 5 == 0 ? "MODULE: mod_" : "INSTANCE: tb.inst_") << (i % 9) << "\n";
+        content << "Toggle 0to1 sig_" << i << " [" << i % 4 << "] \"net sig_" << i << "[3:0]\"\n";
+        content << "ANNOTATION: \"block " << i << "\"\n";
+        content << "Block " << i % 3 << " \"" << i << "\" \"x = " << i << ";\"\n";
+        if (i % 6 == 0) {
+            content << "Fsm state_" << i << " \"77\"\n";
+            content << "ANNOTATION: \"transition " << i << "\"\n";
+            content << "Transition A->B \"0->1\"\n";
+        }
+        if (i % 11 == 0) {
+            content << "Unrecognized " << i << "\n";
+        }
+    }
+    
+    std::string tempFilename = "temp_split_test.el";
+    std::ofstream tempFile(tempFilename);
+    tempFile << content.str();
+    tempFile.close();
+    
+    auto serial = parser->parseFile(tempFilename);
+    ASSERT_TRUE(serial.success);
+    ExclusionData expected = *parser->getData();
+    
+    ExclusionWriter writer;
+    std::string firstOutput;
+    
+    for (size_t threads : {size_t(1), size_t(3)}) {
+        ExclusionParser::ExclusionParser splitParser;
+        ParserConfig config;
+        config.splitLargeFiles = true;
+        config.splitChunkSize = 200;
+        config.threadCount = threads;
+        splitParser.setConfig(config);
+        
+        auto result = splitParser.parseFile(tempFilename);
+        EXPECT_TRUE(result.success);
+        EXPECT_EQ(result.linesProcessed, serial.linesProcessed);
+        EXPECT_EQ(result.exclusionsParsed, serial.exclusionsParsed);
+        EXPECT_EQ(result.warnings, serial.warnings);
+        EXPECT_TRUE(*splitParser.getData() == expected) << threads << " threads";
+        
+        std::string output = writer.writeToString(*splitParser.getData());
+        if (firstOutput.empty()) {
+            firstOutput = output;
+        } else {
+            EXPECT_EQ(output, firstOutput);
+        }
+    }
+    
+    std::remove(tempFilename.c_str());
+}
+
+/**
+ * @brief Test that cached parses return the same data and results, keyed by content
+ */
+TEST_F(ParserTest, ParseCacheHitsAndMisses) {
+    namespace fs = std::filesystem;
+    std::string cacheDirectory = "temp_parse_cache";
+    fs::remove_all(cacheDirectory);
+    auto entryCount = [&cacheDirectory] {
+        size_t count = 0;
+        for (const auto& item : fs::directory_iterator(cacheDirectory)) {
+            count += item.path().extension() == ".elc";
+        }
+        return count;
+    };
+    auto writeFile = [](const std::string& filename, const std::string& content) {
+        std::ofstream file(filename);
+        file << content;
+    };
+    
+    std::string filename = "temp_cached.el";
+    std::string copyFilename = "temp_cached_copy.el";
+    writeFile(filename, sampleContent + "Bogus line\n");
+    writeFile(copyFilename, sampleContent + "Bogus line\n");
+    
+    ParserConfig config;
+    config.cacheDirectory = cacheDirectory;
+    
+    ExclusionParser::ExclusionParser reference;
+    auto expected = reference.parseFile(filename);
+    ASSERT_TRUE(expected.success);
+    ASSERT_EQ(expected.warnings.size(), 1u);
+    
+    // Miss: parsed and stored; then hits, also for a copy at another path
+    for (const auto& [path, hit] : {std::pair{filename, false}, {filename, true}, {copyFilename, true}}) {
+        ExclusionParser::ExclusionParser cachedParser;
+        cachedParser.setConfig(config);
+        auto result = cachedParser.parseFile(path);
+        ASSERT_TRUE(result.success) << result.errorMessage;
+        EXPECT_EQ(result.cacheHits, hit ? 1u : 0u);
+        EXPECT_EQ(result.cacheMisses, hit ? 0u : 1u);
+        EXPECT_EQ(result.linesProcessed, expected.linesProcessed);
+        EXPECT_EQ(result.exclusionsParsed, expected.exclusionsParsed);
+        EXPECT_EQ(result.exclusionCounts, expected.exclusionCounts);
+        EXPECT_EQ(result.warnings, expected.warnings);
+        EXPECT_EQ(cachedParser.getData()->fileName, path);
+        reference.getData()->fileName = path;
+        EXPECT_TRUE(*cachedParser.getData() == *reference.getData());
+        EXPECT_EQ(entryCount(), 1u);
+    }
+    
+    // Batches replay cached files on the workers
+    config.threadCount = 2;
+    ExclusionParser::ExclusionParser batchParser;
+    batchParser.setConfig(config);
+    auto batch = batchParser.parseFiles({filename, copyFilename});
+    EXPECT_TRUE(batch.success);
+    EXPECT_EQ(batch.cacheHits, 2u);
+    EXPECT_EQ(batch.warnings.size(), 2u);
+    
+    // Edited content and a damaged entry both miss (and are stored again)
+    writeFile(filename, sampleContent);
+    ExclusionParser::ExclusionParser cachedParser;
+    cachedParser.setConfig(config);
+    EXPECT_EQ(cachedParser.parseFile(filename).cacheMisses, 1u);
+    EXPECT_EQ(entryCount(), 2u);
+    
+    for (const auto& item : fs::directory_iterator(cacheDirectory)) {
+        std::fstream entry(item.path(), std::ios::in | std::ios::out | std::ios::binary);
+        entry.seekp(static_cast<std::streamoff>(fs::file_size(item.path()) / 2));
+        entry.put('\x7f');
+    }
+    EXPECT_EQ(cachedParser.parseFile(filename).cacheMisses, 1u);
+    EXPECT_EQ(cachedParser.parseFile(filename).cacheHits, 1u);
+    
+    // Different parse options are a different entry
+    config.strictMode = true;
+    cachedParser.setConfig(config);
+    EXPECT_EQ(cachedParser.parseFile(filename).cacheMisses, 1u);
+    
+    // Least recently used entries are evicted beyond cacheMaxBytes
+    size_t newest = 0;
+    for (const auto& item : fs::directory_iterator(cacheDirectory)) {
+        fs::last_write_time(item.path(), fs::file_time_type::clock::now() - std::chrono::hours(1));
+        newest = std::max(newest, static_cast<size_t>(item.file_size()));
+    }
+    config.strictMode = false;
+    config.cacheMaxBytes = 2 * newest;
+    cachedParser.setConfig(config);
+    writeFile(filename, sampleContent + "Block 7 \"1\" \"x = 1;\"\n");
+    EXPECT_EQ(cachedParser.parseFile(filename).cacheMisses, 1u);
+    EXPECT_LE(entryCount(), 2u);
+    EXPECT_EQ(cachedParser.parseFile(filename).cacheHits, 1u);
+    
+    fs::remove_all(cacheDirectory);
+    std::remove(filename.c_str());
+    std::remove(copyFilename.c_str());
+}
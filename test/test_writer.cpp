@@ -12,9 +12,12 @@
 
 #include <gtest/gtest.h>
 #include "ExclusionWriter.h"
+#include "ExclusionStreamWriter.h"
 #include "ExclusionParser.h"
+#include "ExclusionFrozenData.h"
 #include <sstream>
 #include <fstream>
+#include <filesystem>
 
 using namespace ExclusionParser;
 
@@ -25,7 +28,7 @@ class WriterTest : public ::testing::Test {
 protected:
     void SetUp() override {
         writer = std::make_unique<ExclusionWriter>();
-        parser = std::make_unique<ExclusionParser>();
+        parser = std::make_unique<ExclusionParser::ExclusionParser>();
         
         // Create sample test data
         testData = std::make_shared<ExclusionData>("test.el");
@@ -80,7 +83,7 @@ protected:
     }
     
     std::unique_ptr<ExclusionWriter> writer;
-    std::unique_ptr<ExclusionParser> parser;
+    std::unique_ptr<ExclusionParser::ExclusionParser> parser;
     std::shared_ptr<ExclusionData> testData;
 };
 
@@ -148,6 +151,78 @@ TEST_F(WriterTest, WriteToStream) {
     EXPECT_FALSE(output.empty());
 }
 
+/**
+ * @brief Test the output buffer's escaping and bulk flushing
+ */
+TEST_F(WriterTest, OutputBufferFlushAndEscape) {
+    std::ostringstream oss;
+    OutputBuffer buffer(&oss, 16);
+    buffer.append("Block ");
+    buffer.appendNumber(161);
+    buffer.append(" \"");
+    buffer.appendEscaped("a = \"x\";\"");
+    buffer.append('"');
+    EXPECT_TRUE(oss.str().empty());
+    buffer.flushIfFull();
+    EXPECT_EQ(oss.str(), "Block 161 \"a = \\\"x\\\";\\\"\"");
+    EXPECT_EQ(buffer.size(), 0u);
+    buffer.append("tail");
+    buffer.flushIfFull();
+    EXPECT_EQ(buffer.size(), 4u);
+    EXPECT_TRUE(buffer.flush());
+    EXPECT_EQ(oss.str().substr(oss.str().size() - 4), "tail");
+    
+    // Quotes in annotations, source code and net descriptions are escaped once
+    auto& scope = testData->getOrCreateScope("tb.test.module.instance", "123456", false);
+    scope.addBlockExclusion(BlockExclusion("7", "1", "s = \"on\";", "says \"why\""));
+    std::string output = writer->writeToString(*testData);
+    EXPECT_NE(output.find("ANNOTATION: \"says \\\"why\\\"\"\nBlock 7 \"1\" \"s = \\\"on\\\";\""), std::string::npos);
+    
+    // Streams get the same bytes as strings, also across many flushes
+    for (int i = 0; i < 40000; ++i) {
+        scope.addToggleExclusion(ToggleExclusion(ToggleDirection::BOTH, "bus", i, "net bus", "Wide bus"));
+    }
+    std::ostringstream stream;
+    auto result = writer->writeToStream(stream, *testData);
+    EXPECT_TRUE(result.success);
+    EXPECT_GT(stream.str().size(), OutputBuffer::DEFAULT_FLUSH_THRESHOLD);
+    EXPECT_EQ(stream.str(), writer->writeToString(*testData));
+}
+
+/**
+ * @brief Test that parallel scope formatting writes the same bytes as serial
+ */
+TEST_F(WriterTest, ParallelMatchesSerial) {
+    for (int i = 0; i < 200; ++i) {
+        auto& scope = testData->getOrCreateScope("tb.scope_" + std::to_string(i), std::to_string(i), i % 3 == 0);
+        for (int j = 0; j < i % 7; ++j) {
+            scope.addBlockExclusion(BlockExclusion(std::to_string(j * 13), "1", "x = \"" + std::to_string(j) + "\";",
+                                                   j % 2 ? "Unused" : ""));
+            scope.addToggleExclusion(ToggleExclusion(ToggleDirection::ONE_TO_ZERO, "sig_" + std::to_string(j), j,
+                                                     "net sig", ""));
+        }
+    }
+    
+    for (bool sort : {false, true}) {
+        WriterConfig config;
+        config.sortExclusions = sort;
+        writer->setConfig(config);
+        std::ostringstream serial;
+        auto serialResult = writer->writeToStream(serial, *testData);
+        
+        config.threadCount = 4;
+        writer->setConfig(config);
+        std::ostringstream parallel;
+        auto parallelResult = writer->writeToStream(parallel, *testData);
+        EXPECT_TRUE(parallelResult.success);
+        EXPECT_EQ(parallel.str(), serial.str());
+        EXPECT_EQ(writer->writeToString(*testData), serial.str());
+        EXPECT_EQ(parallelResult.linesWritten, serialResult.linesWritten);
+        EXPECT_EQ(parallelResult.scopesWritten, serialResult.scopesWritten);
+        EXPECT_EQ(parallelResult.exclusionCounts, serialResult.exclusionCounts);
+    }
+}
+
 /**
  * @brief Test writing to file
  */
@@ -173,6 +248,60 @@ TEST_F(WriterTest, WriteToFile) {
     std::remove(filename.c_str());
 }
 
+/**
+ * @brief Test atomic replacement of an existing file, with and without the async variant
+ */
+TEST_F(WriterTest, AtomicWriteFile) {
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "exclusion_atomic_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    std::string filename = (directory / "atomic.el").string();
+    auto readFile = [](const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    };
+    
+    WriterConfig config;
+    config.atomicWrite = true;
+    config.syncToDisk = true;
+    writer->setConfig(config);
+    std::string expected = writer->writeToString(*testData);
+    
+    std::ofstream(filename) << "previous contents";
+    auto result = writer->writeFile(filename, *testData);
+    ASSERT_TRUE(result.success) << result.errorMessage;
+    EXPECT_EQ(readFile(filename), expected);
+    
+    std::ofstream(filename) << "previous contents";
+    auto pending = writer->writeFileAsync(filename, testData);
+    auto asyncResult = pending.get();
+    ASSERT_TRUE(asyncResult.success) << asyncResult.errorMessage;
+    EXPECT_EQ(asyncResult.exclusionsWritten, result.exclusionsWritten);
+    EXPECT_EQ(readFile(filename), expected);
+    
+    // No temporary files are left behind
+    EXPECT_EQ(std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator()), 1);
+    
+    // A write that cannot complete leaves nothing at the target
+    std::string missing = (directory / "missing" / "atomic.el").string();
+    auto failed = writer->writeFile(missing, *testData);
+    EXPECT_FALSE(failed.success);
+    EXPECT_FALSE(failed.errorMessage.empty());
+    EXPECT_FALSE(std::filesystem::exists(missing));
+    
+    // Multiple files are written through the same path
+    std::vector<std::shared_ptr<ExclusionData>> dataList(5, testData);
+    auto multiResult = writer->writeMultipleFiles((directory / "multi.el").string(), dataList);
+    ASSERT_TRUE(multiResult.success) << multiResult.errorMessage;
+    EXPECT_EQ(multiResult.exclusionsWritten, 5 * result.exclusionsWritten);
+    for (size_t i = 0; i < dataList.size(); ++i) {
+        EXPECT_EQ(readFile((directory / ("multi_" + std::to_string(i) + ".el")).string()), expected);
+    }
+    EXPECT_EQ(std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator()), 6);
+    
+    std::filesystem::remove_all(directory);
+}
+
 /**
  * @brief Test round-trip parsing and writing
  */
@@ -217,6 +346,83 @@ TEST_F(WriterTest, RoundTripTest) {
     EXPECT_EQ(moduleScope.conditionExclusions.size(), 1);
 }
 
+/**
+ * @brief Test writing an .elb binary cache and loading it back
+ */
+TEST_F(WriterTest, BinaryCacheRoundTrip) {
+    std::string filename = "test_output.elb";
+    
+    auto result = writer->writeBinaryFile(filename, *testData);
+    ASSERT_TRUE(result.success) << "Write failed: " << result.errorMessage;
+    EXPECT_EQ(result.exclusionsWritten, testData->getTotalExclusionCount());
+    EXPECT_EQ(result.scopesWritten, 2u);
+    
+    FrozenExclusionData loaded;
+    auto loadResult = parser->loadBinaryFile(filename, loaded);
+    ASSERT_TRUE(loadResult.success) << "Load failed: " << loadResult.errorMessage;
+    EXPECT_EQ(loadResult.inputMode, InputMode::MEMORY_MAPPED);
+    EXPECT_EQ(loadResult.exclusionsParsed, testData->getTotalExclusionCount());
+    EXPECT_EQ(loadResult.exclusionCounts, testData->getExclusionCountsByType());
+    
+    EXPECT_EQ(loaded.generatedBy, "test_user");
+    EXPECT_EQ(loaded.generationDate, testData->generationDate);
+    EXPECT_EQ(loaded.getImage(), testData->freeze().getImage());
+    
+    const auto* instance = loaded.findScope("tb.test.module.instance");
+    ASSERT_NE(instance, nullptr);
+    const auto* block = loaded.findBlock(*instance, "161");
+    ASSERT_NE(block, nullptr);
+    EXPECT_EQ(loaded.text(block->sourceCode), "do_db_reg_update = 1'b0;");
+    EXPECT_EQ(loaded.findToggles(*instance, "signal_array").size(), 1u);
+    const auto* module = loaded.findScope("test_module");
+    ASSERT_NE(module, nullptr);
+    ASSERT_NE(loaded.findCondition(*module, "2"), nullptr);
+    EXPECT_EQ(loaded.text(loaded.findCondition(*module, "2")->annotation), "Impossible condition");
+    
+    std::remove(filename.c_str());
+}
+
+/**
+ * @brief Test that damaged or foreign binary caches are rejected
+ */
+TEST_F(WriterTest, BinaryCacheValidation) {
+    std::string image(testData->freeze().getImage());
+    std::string filename = "test_damaged.elb";
+    auto writeBytes = [&](const std::string& bytes) {
+        std::ofstream file(filename, std::ios::binary);
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    };
+    FrozenExclusionData loaded;
+    
+    // A flipped byte in the content fails the content checksum (unless skipped)
+    std::string damaged = image;
+    damaged[damaged.size() - 20] ^= 0x5a;
+    writeBytes(damaged);
+    auto result = parser->loadBinaryFile(filename, loaded);
+    EXPECT_FALSE(result.success);
+    EXPECT_NE(result.errorMessage.find("content checksum"), std::string::npos) << result.errorMessage;
+    EXPECT_TRUE(parser->loadBinaryFile(filename, loaded, false).success);
+    
+    // Any header change fails the header checksum; version is checked after it
+    damaged = image;
+    damaged[8] = static_cast<char>(FrozenExclusionData::FORMAT_VERSION + 1);
+    writeBytes(damaged);
+    result = parser->loadBinaryFile(filename, loaded);
+    EXPECT_FALSE(result.success);
+    EXPECT_NE(result.errorMessage.find("header checksum"), std::string::npos) << result.errorMessage;
+    
+    writeBytes(image.substr(0, image.size() - 8));
+    EXPECT_FALSE(parser->loadBinaryFile(filename, loaded).success);
+    
+    writeBytes(writer->writeToString(*testData));
+    result = parser->loadBinaryFile(filename, loaded);
+    EXPECT_FALSE(result.success);
+    EXPECT_NE(result.errorMessage.find("magic"), std::string::npos) << result.errorMessage;
+    
+    EXPECT_FALSE(parser->loadBinaryFile("does_not_exist.elb", loaded).success);
+    std::remove(filename.c_str());
+}
+
 /**
  * @brief Test writing with different configurations
  */
@@ -249,6 +455,47 @@ TEST_F(WriterTest, ConfigurationOptions) {
     EXPECT_FALSE(outputCompact.empty());
 }
 
+/**
+ * @brief Test that sorted output orders scope names and block IDs naturally (numbers by value,
+ *        leading zeros after the shorter form), with few and with thousands of numeric IDs
+ */
+TEST_F(WriterTest, SortedOutputUsesNaturalOrder) {
+    WriterConfig config;
+    config.sortExclusions = true;
+    config.includeComments = false;
+    writer->setConfig(config);
+    
+    for (size_t count : {5, 3000}) {
+        ExclusionData data("natural.el");
+        auto& scope = data.getOrCreateScope("tb.scope10", "1", false);
+        data.getOrCreateScope("tb.scope9", "2", false);
+        std::vector<std::string> expected;
+        for (size_t id = count; id > 0; --id) {
+            scope.addBlockExclusion(BlockExclusion(std::to_string(id), "0", "code", ""));
+        }
+        for (size_t id = 1; id <= count; ++id) {
+            expected.push_back(std::to_string(id));
+        }
+        for (const char* id : {"blk_10", "blk_9", "blk_09", "blk", "a.b", "a1"}) {
+            scope.addBlockExclusion(BlockExclusion(id, "0", "code", ""));
+        }
+        expected.insert(expected.end(), {"a.b", "a1", "blk", "blk_9", "blk_09", "blk_10"});
+        
+        std::string output = writer->writeToString(data);
+        EXPECT_LT(output.find("INSTANCE:tb.scope9"), output.find("INSTANCE:tb.scope10"));
+        
+        std::vector<std::string> written;
+        std::istringstream lines(output);
+        std::string line;
+        while (std::getline(lines, line)) {
+            if (line.starts_with("Block ")) {
+                written.push_back(line.substr(6, line.find(' ', 6) - 6));
+            }
+        }
+        EXPECT_EQ(written, expected) << "with " << count << " numeric ids";
+    }
+}
+
 /**
  * @brief Test writing specific scopes only
  */
@@ -302,6 +549,54 @@ TEST_F(WriterTest, WriteFilteredByType) {
     std::remove(filename.c_str());
 }
 
+/**
+ * @brief Test that filtered views write what a filtered copy of the data would
+ */
+TEST_F(WriterTest, FilteredViewMatchesCopy) {
+    testData->getOrCreateScope("tb.test.other", "", false).addBlockExclusion(BlockExclusion("5", "6", "y;", ""));
+    
+    ExclusionDataView view(*testData);
+    view.typeMask = ExclusionDataView::typeBit(ExclusionType::BLOCK) | ExclusionDataView::typeBit(ExclusionType::FSM);
+    view.scopeFilter = [](const std::string& scopeName, const ExclusionScope&) {
+        return scopeName != "tb.test.module.instance";
+    };
+    
+    ExclusionData copy("test.el");
+    copy.generatedBy = testData->generatedBy;
+    copy.formatVersion = testData->formatVersion;
+    copy.generationDate = testData->generationDate;
+    copy.exclusionMode = testData->exclusionMode;
+    for (const auto& [scopeName, scope] : testData->scopes) {
+        if (scopeName != "tb.test.module.instance") {
+            auto& copied = copy.scopes.emplace(scopeName, scope).first->second;
+            copied.toggleExclusions.clear();
+            copied.conditionExclusions.clear();
+        }
+    }
+    
+    WriterConfig config;
+    config.sortExclusions = true;
+    writer->setConfig(config);
+    std::ostringstream stream;
+    auto result = writer->writeToStream(stream, view);
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(stream.str(), writer->writeToString(copy));
+    EXPECT_EQ(writer->writeToString(view), stream.str());
+    EXPECT_EQ(result.scopesWritten, 2u);
+    EXPECT_EQ(result.exclusionsWritten, 3u);
+    EXPECT_EQ(result.exclusionCounts[ExclusionType::CONDITION], 0u);
+    EXPECT_LT(writer->estimateOutputSize(view), writer->estimateOutputSize(*testData));
+    
+    // Named scopes keep the requested order; unknown and repeated names are skipped
+    writer->setConfig(WriterConfig());
+    ExclusionDataView named(*testData);
+    named.scopeNames = std::vector<std::string>{"test_module", "missing", "tb.test.other", "test_module"};
+    std::string output = writer->writeToString(named);
+    EXPECT_LT(output.find("MODULE:test_module"), output.find("INSTANCE:tb.test.other"));
+    EXPECT_EQ(output.find("INSTANCE:tb.test.module.instance"), std::string::npos);
+    EXPECT_EQ(output.find("MODULE:test_module"), output.rfind("MODULE:test_module"));
+}
+
 /**
  * @brief Test appending to existing file
  */
@@ -468,4 +763,65 @@ TEST_F(WriterTest, WriteMultipleFiles) {
     // Clean up
     std::remove("test_multi_0.el");
     std::remove("test_multi_1.el");
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Test the incremental stream writer, including annotation runs
+ */
+TEST_F(WriterTest, StreamWriterCollapsesAnnotationRuns) {
+    std::ostringstream stream;
+    ExclusionStreamWriter streamWriter;
+    ASSERT_TRUE(streamWriter.open(stream));
+    
+    streamWriter.writeHeader("stream_user", "Mon Jan 01 00:00:00 2025", "test");
+    streamWriter.add(BlockExclusion("1", "100", "dropped", "Outside"));
+    streamWriter.beginScope("tb.stream.instance", "123456", false);
+    streamWriter.add(BlockExclusion("1", "100", "a = 1;", "Shared"));
+    streamWriter.add(BlockExclusion("2", "200", "b = 1;", "Shared"));
+    streamWriter.add(ToggleExclusion(ToggleDirection::ZERO_TO_ONE, "sig", 3, "net sig[7:0]", "Shared"));
+    streamWriter.add(BlockExclusion("3", "300", "c = 1;", ""));
+    streamWriter.add(BlockExclusion("4", "400", "d = 1;", "Single"));
+    streamWriter.beginScope("stream_module", "987654", true);
+    streamWriter.add(FsmExclusion("state", "85815111", "Scoped"));
+    streamWriter.add(ConditionExclusion("2", "2940925445", "a && b", "1 -1", "1 \"01\"", "Scoped"));
+    auto result = streamWriter.close();
+    
+    ASSERT_TRUE(result.success) << result.errorMessage;
+    EXPECT_FALSE(streamWriter.isOpen());
+    EXPECT_EQ(result.scopesWritten, 2);
+    EXPECT_EQ(result.exclusionsWritten, 7);
+    EXPECT_EQ(result.exclusionCounts[ExclusionType::BLOCK], 4);
+    EXPECT_EQ(result.warnings.size(), 1);
+    
+    // One run per scope, the lone annotation keeps the single-line form
+    std::string written = stream.str();
+    EXPECT_EQ(std::count(written.begin(), written.end(), '\n'), static_cast<long>(result.linesWritten));
+    EXPECT_NE(written.find("ANNOTATION_BEGIN: \"Shared\"\nBlock 1"), std::string::npos);
+    EXPECT_NE(written.find("ANNOTATION: \"Single\"\nBlock 4"), std::string::npos);
+    EXPECT_EQ(written.find("ANNOTATION: \"Shared\""), std::string::npos);
+    EXPECT_EQ(written.find("dropped"), std::string::npos);
+    size_t runs = 0;
+    for (size_t pos = written.find("ANNOTATION_END"); pos != std::string::npos;
+         pos = written.find("ANNOTATION_END", pos + 1)) {
+        runs++;
+    }
+    EXPECT_EQ(runs, 2);
+    
+    // The parser applies each run to all of its records
+    auto parseResult = parser->parseString(written, "stream_test");
+    ASSERT_TRUE(parseResult.success) << parseResult.errorMessage;
+    auto parsedData = parser->getData();
+    EXPECT_EQ(parsedData->generatedBy, "stream_user");
+    EXPECT_EQ(parsedData->getTotalExclusionCount(), 7);
+    
+    const auto& instanceScope = parsedData->scopes["tb.stream.instance"];
+    EXPECT_EQ(instanceScope.checksum, "123456");
+    EXPECT_EQ(std::string_view(instanceScope.blockExclusions.at("1").annotation), "Shared");
+    EXPECT_EQ(std::string_view(instanceScope.blockExclusions.at("2").annotation), "Shared");
+    EXPECT_EQ(std::string_view(instanceScope.blockExclusions.at("3").annotation), "");
+    EXPECT_EQ(std::string_view(instanceScope.blockExclusions.at("4").annotation), "Single");
+    
+    const auto& moduleScope = parsedData->scopes["stream_module"];
+    EXPECT_TRUE(moduleScope.isModule);
+    EXPECT_EQ(std::string_view(moduleScope.conditionExclusions.at("2").annotation), "Scoped");
+}